@@ -0,0 +1,114 @@
+//! Throughput of streaming encoded messages into a pipe read by a local process, like
+//! `to_stdout()` piped into `rerun -`.
+//!
+//! Compares the line buffered writes of `Stdout` with [`re_log_encoding::PipeWriter`].
+
+#[cfg(not(feature = "encoder"))]
+compile_error!("pipe_benchmark requires the 'encoder' feature.");
+
+#[global_allocator]
+static GLOBAL: mimalloc::MiMalloc = mimalloc::MiMalloc;
+
+use re_log_types::{
+    entity_path, DataRow, DataTable, LogMsg, RowId, StoreId, StoreKind, TableId, TimeInt, TimeType,
+    Timeline,
+};
+use re_types::datagen::build_some_positions2d;
+
+use criterion::{criterion_group, criterion_main, Criterion};
+
+#[cfg(not(debug_assertions))]
+const NUM_MESSAGES: usize = 1_000;
+
+#[cfg(not(debug_assertions))]
+const NUM_POINTS: usize = 10_000;
+
+// `cargo test` also runs the benchmark setup code, so make sure they run quickly:
+#[cfg(debug_assertions)]
+const NUM_MESSAGES: usize = 1;
+
+#[cfg(debug_assertions)]
+const NUM_POINTS: usize = 1;
+
+criterion_group!(benches, pipe_to_reader);
+criterion_main!(benches);
+
+fn build_frame_nr(frame_nr: TimeInt) -> (Timeline, TimeInt) {
+    (Timeline::new("frame_nr", TimeType::Sequence), frame_nr)
+}
+
+fn generate_messages() -> Vec<LogMsg> {
+    let store_id = StoreId::random(StoreKind::Recording);
+    (0..NUM_MESSAGES)
+        .map(|i| {
+            let table = DataTable::from_rows(
+                TableId::ZERO,
+                [DataRow::from_cells1(
+                    RowId::ZERO,
+                    entity_path!("points"),
+                    [build_frame_nr((i as i64).into())],
+                    NUM_POINTS as _,
+                    build_some_positions2d(NUM_POINTS),
+                )
+                .unwrap()],
+            );
+            LogMsg::ArrowMsg(store_id.clone(), table.to_arrow_msg().unwrap())
+        })
+        .collect()
+}
+
+/// Spawns the reader process, which discards everything it reads.
+fn spawn_reader() -> std::process::Child {
+    std::process::Command::new("cat")
+        .stdin(std::process::Stdio::piped())
+        .stdout(std::process::Stdio::null())
+        .spawn()
+        .unwrap()
+}
+
+fn bench_writer<W: std::io::Write>(
+    group: &mut criterion::BenchmarkGroup<'_, criterion::measurement::WallTime>,
+    name: &str,
+    messages: &[LogMsg],
+    write: W,
+) {
+    let encoding_options = re_log_encoding::EncodingOptions::UNCOMPRESSED;
+    let mut encoder = re_log_encoding::encoder::Encoder::new(encoding_options, write).unwrap();
+    group.bench_function(name, |b| {
+        b.iter(|| {
+            for msg in messages {
+                encoder.append(msg).unwrap();
+            }
+            encoder.flush_blocking().unwrap();
+        });
+    });
+}
+
+fn pipe_to_reader(c: &mut Criterion) {
+    let messages = generate_messages();
+    let encoded_len = re_log_encoding::encoder::encode_to_bytes(
+        re_log_encoding::EncodingOptions::UNCOMPRESSED,
+        messages.iter(),
+    )
+    .unwrap()
+    .len();
+
+    let mut group = c.benchmark_group("pipe_to_reader");
+    group.throughput(criterion::Throughput::Bytes(encoded_len as _));
+
+    {
+        // What `Stdout` does.
+        let mut reader = spawn_reader();
+        let write = std::io::LineWriter::new(reader.stdin.take().unwrap());
+        bench_writer(&mut group, "line_writer", &messages, write);
+        reader.wait().unwrap();
+    }
+
+    #[cfg(unix)]
+    {
+        let mut reader = spawn_reader();
+        let write = re_log_encoding::PipeWriter::new(reader.stdin.take().unwrap());
+        bench_writer(&mut group, "pipe_writer", &messages, write);
+        reader.wait().unwrap();
+    }
+}
@@ -220,14 +220,13 @@ impl<R: std::io::Read> Iterator for Decoder<R> {
 // ----------------------------------------------------------------------------
 
 #[cfg(all(feature = "decoder", feature = "encoder"))]
-#[test]
-fn test_encode_decode() {
+#[cfg(test)]
+fn fake_log_message() -> LogMsg {
     use re_log_types::{
-        ApplicationId, LogMsg, RowId, SetStoreInfo, StoreId, StoreInfo, StoreKind, StoreSource,
-        Time,
+        ApplicationId, RowId, SetStoreInfo, StoreId, StoreInfo, StoreKind, StoreSource, Time,
     };
 
-    let messages = vec![LogMsg::SetStoreInfo(SetStoreInfo {
+    LogMsg::SetStoreInfo(SetStoreInfo {
         row_id: RowId::new(),
         info: StoreInfo {
             application_id: ApplicationId("test".to_owned()),
@@ -240,7 +239,13 @@ fn test_encode_decode() {
             },
             store_kind: re_log_types::StoreKind::Recording,
         },
-    })];
+    })
+}
+
+#[cfg(all(feature = "decoder", feature = "encoder"))]
+#[test]
+fn test_encode_decode() {
+    let messages = vec![fake_log_message()];
 
     let options = [
         EncodingOptions {
@@ -265,3 +270,28 @@ fn test_encode_decode() {
         assert_eq!(messages, decoded_messages);
     }
 }
+
+#[cfg(all(feature = "decoder", feature = "encoder"))]
+#[test]
+fn test_decode_drained_chunks() {
+    let messages = vec![fake_log_message(), fake_log_message()];
+
+    // Takes the bytes out of the encoder after each message, like a sink passing on chunks.
+    let mut encoder = crate::encoder::Encoder::new(EncodingOptions::UNCOMPRESSED, vec![]).unwrap();
+    let mut chunks = vec![];
+    for message in &messages {
+        encoder.append(message).unwrap();
+        chunks.push(std::mem::take(encoder.get_mut()));
+    }
+
+    // Only the first chunk starts with the file header.
+    assert!(Decoder::new(VersionPolicy::Error, &mut chunks[1].as_slice()).is_err());
+
+    let stream = chunks.concat();
+    let decoded_messages = Decoder::new(VersionPolicy::Error, &mut stream.as_slice())
+        .unwrap()
+        .collect::<Result<Vec<LogMsg>, DecodeError>>()
+        .unwrap();
+
+    assert_eq!(messages, decoded_messages);
+}
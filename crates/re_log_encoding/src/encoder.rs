@@ -112,6 +112,18 @@ impl<W: std::io::Write> Encoder<W> {
     pub fn flush_blocking(&mut self) -> std::io::Result<()> {
         self.write.flush()
     }
+
+    /// The underlying writer.
+    pub fn get_ref(&self) -> &W {
+        &self.write
+    }
+
+    /// The underlying writer, e.g. to take the bytes encoded so far out of a `Vec<u8>`.
+    ///
+    /// Messages appended afterwards continue the same stream, without another file header.
+    pub fn get_mut(&mut self) -> &mut W {
+        &mut self.write
+    }
 }
 
 pub fn encode<'a>(
@@ -93,7 +93,18 @@ impl FileSink {
 
         re_log::debug!("Writing to stdout…");
 
-        let encoder = crate::encoder::Encoder::new(encoding_options, std::io::stdout())?;
+        // `Stdout` is line buffered, i.e. flushes at any newline byte in the encoded data.
+        // Write in large batches instead, straight to the file descriptor.
+        #[cfg(unix)]
+        let stdout = {
+            use std::io::Write as _;
+            std::io::stdout().flush().ok();
+            crate::PipeWriter::new(std::io::stdout())
+        };
+        #[cfg(not(unix))]
+        let stdout = std::io::BufWriter::with_capacity(4 * 1024 * 1024, std::io::stdout());
+
+        let encoder = crate::encoder::Encoder::new(encoding_options, stdout)?;
         let join_handle = spawn_and_stream(None, encoder, rx)?;
 
         Ok(Self {
@@ -127,11 +138,15 @@ fn spawn_and_stream<W: std::io::Write + Send + 'static>(
     } else {
         ("stdout_writer", "stdout".to_owned())
     };
+    // Whoever reads stdout, e.g. a viewer behind a pipe, waits for the data, while a file is
+    // only read once it is complete.
+    let flush_when_idle = filepath.is_none();
     std::thread::Builder::new()
         .name(name.into())
         .spawn({
             move || {
-                while let Ok(Some(cmd)) = rx.recv() {
+                let mut next_cmd = rx.recv().ok().flatten();
+                while let Some(cmd) = next_cmd.take() {
                     match cmd {
                         Command::Send(log_msg) => {
                             if let Err(err) = encoder.append(&log_msg) {
@@ -148,6 +163,22 @@ fn spawn_and_stream<W: std::io::Write + Send + 'static>(
                             drop(oneshot); // signals the oneshot
                         }
                     }
+
+                    next_cmd = match rx.try_recv() {
+                        Ok(cmd) => cmd,
+                        Err(std::sync::mpsc::TryRecvError::Empty) => {
+                            // Messages that arrive while writing are coalesced, and flushed
+                            // to stdout once there is nothing left to do.
+                            if flush_when_idle {
+                                if let Err(err) = encoder.flush_blocking() {
+                                    re_log::error!("Failed to flush log stream to {target}: {err}");
+                                    return;
+                                }
+                            }
+                            rx.recv().ok().flatten()
+                        }
+                        Err(std::sync::mpsc::TryRecvError::Disconnected) => None,
+                    };
                 }
                 re_log::debug!("Log stream written to {target}");
             }
@@ -10,6 +10,11 @@ pub mod encoder;
 #[cfg(not(target_arch = "wasm32"))]
 mod file_sink;
 
+#[cfg(feature = "encoder")]
+#[cfg(unix)]
+#[allow(unsafe_code)]
+mod pipe_writer;
+
 #[cfg(feature = "stream_from_http")]
 pub mod stream_rrd_from_http;
 
@@ -19,6 +24,10 @@ pub mod stream_rrd_from_http;
 #[cfg(not(target_arch = "wasm32"))]
 pub use file_sink::{FileSink, FileSinkError};
 
+#[cfg(feature = "encoder")]
+#[cfg(unix)]
+pub use pipe_writer::PipeWriter;
+
 // ----------------------------------------------------------------------------
 
 #[cfg(any(feature = "encoder", feature = "decoder"))]
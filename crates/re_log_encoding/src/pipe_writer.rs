@@ -0,0 +1,206 @@
+//! Writing to stdout, or any other pipe or file, in large batches.
+
+use std::os::unix::io::AsRawFd;
+
+/// The buffered data is written once it reaches this size, or on flush.
+const BATCH_SIZE: usize = 1024 * 1024;
+
+/// Writes at least this large are not copied into the buffer, but written together with it.
+const PASS_THROUGH_SIZE: usize = 64 * 1024;
+
+/// The pipe size we ask for when writing to a pipe, the default limit of unprivileged processes.
+#[cfg(target_os = "linux")]
+const PIPE_SIZE: usize = 1024 * 1024;
+
+/// Buffers small writes and writes them to a pipe or file in large batches.
+///
+/// Writing each encoded message on its own costs at least two system calls per message, plus
+/// more when the writer is line buffered like stdout, which adds up for streams of many small
+/// messages. This instead writes all buffered data with a single `writev` once [`BATCH_SIZE`]
+/// bytes are buffered, or on [`std::io::Write::flush`]. Large writes, e.g. of images, are
+/// written right away together with the buffered data, without copying them first.
+///
+/// On Linux, if the file is a pipe, this also raises the pipe size to [`PIPE_SIZE`], such that
+/// each batch takes fewer round trips to the reader.
+///
+/// Buffered data is written on drop, ignoring errors.
+pub struct PipeWriter<F: AsRawFd> {
+    file: F,
+    buffer: Vec<u8>,
+}
+
+impl<F: AsRawFd> PipeWriter<F> {
+    /// Writes to `file`, e.g. [`std::io::stdout`] or the stdin of a child process.
+    ///
+    /// Bypasses any buffering of `file` itself, so flush that first.
+    pub fn new(file: F) -> Self {
+        #[cfg(target_os = "linux")]
+        raise_pipe_size(file.as_raw_fd());
+
+        Self {
+            file,
+            buffer: Vec::with_capacity(BATCH_SIZE),
+        }
+    }
+
+    /// Writes all buffered data, followed by `bytes`.
+    fn write_batch(&mut self, bytes: &[u8]) -> std::io::Result<()> {
+        re_tracing::profile_function!();
+
+        let mut iovecs = [self.buffer.as_slice(), bytes]
+            .into_iter()
+            .filter(|slice| !slice.is_empty())
+            .map(|slice| libc::iovec {
+                iov_base: slice.as_ptr().cast_mut().cast(),
+                iov_len: slice.len(),
+            })
+            .collect::<Vec<_>>();
+
+        let fd = self.file.as_raw_fd();
+        while !iovecs.is_empty() {
+            // SAFETY: the iovecs point into `self.buffer` and `bytes`.
+            let written = unsafe { libc::writev(fd, iovecs.as_ptr(), iovecs.len() as libc::c_int) };
+
+            if written < 0 {
+                let err = std::io::Error::last_os_error();
+                match err.kind() {
+                    std::io::ErrorKind::Interrupted => {}
+                    std::io::ErrorKind::WouldBlock => wait_until_writable(fd),
+                    _ => return Err(err),
+                }
+                continue;
+            }
+            if written == 0 {
+                return Err(std::io::ErrorKind::WriteZero.into());
+            }
+            advance(&mut iovecs, written as usize);
+        }
+
+        self.buffer.clear();
+        Ok(())
+    }
+}
+
+impl<F: AsRawFd> std::io::Write for PipeWriter<F> {
+    #[inline]
+    fn write(&mut self, bytes: &[u8]) -> std::io::Result<usize> {
+        self.write_all(bytes)?;
+        Ok(bytes.len())
+    }
+
+    #[inline]
+    fn write_all(&mut self, bytes: &[u8]) -> std::io::Result<()> {
+        if PASS_THROUGH_SIZE <= bytes.len() {
+            return self.write_batch(bytes);
+        }
+
+        self.buffer.extend_from_slice(bytes);
+        if BATCH_SIZE <= self.buffer.len() {
+            self.write_batch(&[])?;
+        }
+        Ok(())
+    }
+
+    #[inline]
+    fn flush(&mut self) -> std::io::Result<()> {
+        if self.buffer.is_empty() {
+            return Ok(());
+        }
+        self.write_batch(&[])
+    }
+}
+
+impl<F: AsRawFd> Drop for PipeWriter<F> {
+    fn drop(&mut self) {
+        use std::io::Write as _;
+        self.flush().ok();
+    }
+}
+
+/// Drops the first `n` written bytes from the front of `iovecs`.
+fn advance(iovecs: &mut Vec<libc::iovec>, mut n: usize) {
+    let mut num_written = 0;
+    for iovec in iovecs.iter_mut() {
+        if n < iovec.iov_len {
+            // SAFETY: stays within the slice of the iovec.
+            iovec.iov_base = unsafe { iovec.iov_base.cast::<u8>().add(n) }.cast();
+            iovec.iov_len -= n;
+            break;
+        }
+        n -= iovec.iov_len;
+        num_written += 1;
+    }
+    iovecs.drain(..num_written);
+}
+
+/// Blocks until a non-blocking `fd` can be written to.
+fn wait_until_writable(fd: libc::c_int) {
+    let mut pollfd = libc::pollfd {
+        fd,
+        events: libc::POLLOUT,
+        revents: 0,
+    };
+    // SAFETY: polls a single valid pollfd.
+    unsafe {
+        libc::poll(&mut pollfd, 1, -1);
+    }
+}
+
+/// Raises the size of the pipe to [`PIPE_SIZE`], if `fd` is a pipe.
+#[cfg(target_os = "linux")]
+fn raise_pipe_size(fd: libc::c_int) {
+    // SAFETY: `stat` is plain data, and filled by `fstat` on success.
+    let is_pipe = unsafe {
+        let mut stat = std::mem::zeroed::<libc::stat>();
+        libc::fstat(fd, &mut stat) == 0 && (stat.st_mode & libc::S_IFMT) == libc::S_IFIFO
+    };
+    if !is_pipe {
+        return;
+    }
+
+    // SAFETY: `F_SETPIPE_SZ` only takes an integer.
+    if unsafe { libc::fcntl(fd, libc::F_SETPIPE_SZ, PIPE_SIZE as libc::c_int) } < 0 {
+        let err = std::io::Error::last_os_error();
+        re_log::debug!("Failed to raise the pipe size: {err}");
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use std::io::{Read as _, Write as _};
+
+    use super::*;
+
+    #[test]
+    fn writes_in_order_through_pipe() {
+        let mut child = std::process::Command::new("cat")
+            .stdin(std::process::Stdio::piped())
+            .stdout(std::process::Stdio::piped())
+            .spawn()
+            .unwrap();
+        let mut stdout = child.stdout.take().unwrap();
+        let reader = std::thread::spawn(move || {
+            let mut received = Vec::new();
+            stdout.read_to_end(&mut received).unwrap();
+            received
+        });
+
+        // Small writes, batched writes, and writes passing through.
+        let mut expected = Vec::new();
+        {
+            let mut writer = PipeWriter::new(child.stdin.take().unwrap());
+            for i in 0..200 {
+                let bytes = vec![i as u8; (i * 7919) % (4 * PASS_THROUGH_SIZE)];
+                writer.write_all(&bytes).unwrap();
+                expected.extend_from_slice(&bytes);
+                if i % 50 == 0 {
+                    writer.flush().unwrap();
+                }
+            }
+        }
+
+        let received = reader.join().unwrap();
+        child.wait().unwrap();
+        assert!(received == expected, "received bytes differ");
+    }
+}
@@ -18,6 +18,9 @@
 mod global;
 mod log_sink;
 mod recording_stream;
+#[cfg(unix)]
+#[allow(unsafe_code)]
+mod shm_ring;
 mod spawn;
 
 // -------------
@@ -63,6 +66,12 @@ pub mod sink {
 
     #[cfg(not(target_arch = "wasm32"))]
     pub use re_log_encoding::{FileSink, FileSinkError};
+
+    #[cfg(unix)]
+    pub use crate::log_sink::ShmSink;
+
+    #[cfg(unix)]
+    pub use crate::shm_ring::{ShmRingError, ShmRingReader, ShmRingWriter};
 }
 
 /// Things directly related to logging.
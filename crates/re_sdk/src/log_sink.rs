@@ -246,3 +246,95 @@ impl LogSink for TcpSink {
         self.client.drop_if_disconnected();
     }
 }
+
+// ----------------------------------------------------------------------------
+
+/// Stream log messages to a reader on the same host through a shared memory ring buffer.
+///
+/// Any number of sinks, also in different processes, can write to the same ring buffer, e.g.
+/// to aggregate the logs of several processes in a single viewer or relay. Each message is
+/// encoded on its own, into the same self-contained `.rrd` packets that the [`TcpSink`] sends.
+///
+/// See [`crate::sink::ShmRingReader`] for the reading side.
+///
+/// Experimental: the viewer can't read shared memory ring buffers yet.
+#[cfg(unix)]
+#[derive(Debug)]
+pub struct ShmSink {
+    ring: crate::shm_ring::ShmRingWriter,
+    flush_timeout: Option<std::time::Duration>,
+
+    /// The consumed position of the ring buffer when a write last timed out, [`u64::MAX`] if
+    /// none did.
+    ///
+    /// Writes don't wait again until the reader consumed more, such that logging without a
+    /// reader doesn't block every log call.
+    full_at: std::sync::atomic::AtomicU64,
+}
+
+/// How long a [`ShmSink`] waits for the reader to make space for a message before dropping it.
+#[cfg(unix)]
+const SHM_WRITE_TIMEOUT: std::time::Duration = std::time::Duration::from_millis(10);
+
+#[cfg(unix)]
+impl ShmSink {
+    /// Open the ring buffer at `path`, usually in `/dev/shm`, creating it with a data area of
+    /// `capacity` bytes if it doesn't exist yet.
+    ///
+    /// `flush_timeout` is the minimum time the [`ShmSink`] will wait for the reader during a
+    /// flush. Note: Passing `None` here can cause a call to `flush` to block indefinitely if
+    /// there is no reader.
+    ///
+    /// Messages that don't fit into the ring buffer are dropped if the reader doesn't make space
+    /// within a few milliseconds, and right away while it doesn't make any progress.
+    #[inline]
+    pub fn new(
+        path: impl AsRef<std::path::Path>,
+        capacity: u64,
+        flush_timeout: Option<std::time::Duration>,
+    ) -> Result<Self, crate::shm_ring::ShmRingError> {
+        Ok(Self {
+            ring: crate::shm_ring::ShmRingWriter::open_or_create(path, capacity)?,
+            flush_timeout,
+            full_at: std::sync::atomic::AtomicU64::new(u64::MAX),
+        })
+    }
+}
+
+#[cfg(unix)]
+impl LogSink for ShmSink {
+    fn send(&self, msg: LogMsg) {
+        let packet = match re_log_encoding::encoder::encode_to_bytes(
+            re_log_encoding::EncodingOptions::UNCOMPRESSED,
+            std::iter::once(&msg),
+        ) {
+            Ok(packet) => packet,
+            Err(err) => {
+                re_log::error_once!("Failed to encode log message: {err}");
+                return;
+            }
+        };
+
+        let consumed = self.ring.consumed();
+        let timeout = if self.full_at.load(std::sync::atomic::Ordering::Relaxed) == consumed {
+            std::time::Duration::ZERO
+        } else {
+            SHM_WRITE_TIMEOUT
+        };
+
+        if let Err(err) = self.ring.write(&packet, Some(timeout)) {
+            if matches!(err, crate::shm_ring::ShmRingError::Full) {
+                self.full_at
+                    .store(consumed, std::sync::atomic::Ordering::Relaxed);
+            }
+            re_log::warn_once!("Dropped log message: {err}");
+        }
+    }
+
+    #[inline]
+    fn flush_blocking(&self) {
+        if !self.ring.wait_until_consumed(self.flush_timeout) {
+            re_log::warn_once!("Timed out waiting for the shared memory reader during flush");
+        }
+    }
+}
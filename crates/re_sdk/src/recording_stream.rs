@@ -1410,6 +1410,54 @@ impl RecordingStream {
         }
     }
 
+    /// Records a single [`DataRow`] of a batch of rows that each have their own time.
+    ///
+    /// Like [`Self::record_row`] with `inject_time` set to `true`, the row gets the current
+    /// time of the calling thread on all timelines and the recording tick, except that the
+    /// row's own times take precedence.
+    ///
+    /// Use [`Self::record_temporal_rows`] to record all rows of a batch at once.
+    #[inline]
+    pub fn record_temporal_row(&self, row: DataRow) {
+        self.record_temporal_rows(std::iter::once(row));
+    }
+
+    /// Records a batch of [`DataRow`]s that each have their own time.
+    ///
+    /// Each row is recorded like with [`Self::record_temporal_row`], and gets its own recording
+    /// tick. The current time of the calling thread is only looked up once for all rows.
+    pub fn record_temporal_rows<I>(&self, rows: I)
+    where
+        I: IntoIterator<Item = DataRow>,
+        I::IntoIter: ExactSizeIterator,
+    {
+        let rows = rows.into_iter();
+        let f = move |inner: &RecordingStreamInner| {
+            let first_tick = inner
+                .tick
+                .fetch_add(rows.len() as i64, std::sync::atomic::Ordering::Relaxed);
+
+            let now = self.now();
+
+            for (tick, mut row) in (first_tick..).zip(rows) {
+                for (timeline, time) in now.iter() {
+                    if row.timepoint.get(timeline).is_none() {
+                        row.timepoint.insert(*timeline, *time);
+                    }
+                }
+                if row.timepoint.get(&Timeline::log_tick()).is_none() {
+                    row.timepoint.insert(Timeline::log_tick(), tick.into());
+                }
+
+                inner.batcher.push_row(row);
+            }
+        };
+
+        if self.with(f).is_none() {
+            re_log::warn_once!("Recording disabled - call to record_temporal_rows() ignored");
+        }
+    }
+
     /// Swaps the underlying sink for a new one.
     ///
     /// This guarantees that:
@@ -1548,6 +1596,42 @@ impl RecordingStream {
         self.set_sink(Box::new(crate::log_sink::TcpSink::new(addr, flush_timeout)));
     }
 
+    /// Swaps the underlying sink for a [`crate::sink::ShmSink`] writing to the shared memory
+    /// ring buffer at `path`, usually in `/dev/shm`.
+    ///
+    /// Creates the ring buffer with a data area of `capacity` bytes if it doesn't exist yet.
+    /// Several processes can write to the same ring buffer, a reader on the same host consumes
+    /// the messages of all of them, see [`crate::sink::ShmRingReader`].
+    ///
+    /// Experimental: the viewer can't read shared memory ring buffers yet, only custom readers
+    /// built on [`crate::sink::ShmRingReader`] can.
+    ///
+    /// `flush_timeout` is the minimum time the [`ShmSink`][`crate::sink::ShmSink`] will wait for
+    /// the reader during a flush. Note: Passing `None` here can cause a call to `flush` to block
+    /// indefinitely if there is no reader. Messages that don't fit into a full ring buffer are
+    /// dropped after a few milliseconds, see [`crate::sink::ShmSink::new`].
+    ///
+    /// This is a convenience wrapper for [`Self::set_sink`] that upholds the same guarantees in
+    /// terms of data durability and ordering.
+    /// See [`Self::set_sink`] for more information.
+    #[cfg(unix)]
+    pub fn connect_shm(
+        &self,
+        path: impl AsRef<std::path::Path>,
+        capacity: u64,
+        flush_timeout: Option<std::time::Duration>,
+    ) -> Result<(), crate::sink::ShmRingError> {
+        if forced_sink_path().is_some() {
+            re_log::debug!("Ignored setting new ShmSink since _RERUN_FORCE_SINK is set");
+            return Ok(());
+        }
+
+        let sink = crate::sink::ShmSink::new(path, capacity, flush_timeout)?;
+        self.set_sink(Box::new(sink));
+
+        Ok(())
+    }
+
     /// Spawns a new Rerun Viewer process from an executable available in PATH, then swaps the
     /// underlying sink for a [`crate::log_sink::TcpSink`] sink pre-configured to send data to that
     /// new process.
@@ -2207,6 +2291,49 @@ mod tests {
         }
     }
 
+    #[cfg(unix)]
+    #[test]
+    fn shm_sink() {
+        let (rec, storage) = RecordingStreamBuilder::new("rerun_example_shm_sink")
+            .enabled(true)
+            .batcher_config(DataTableBatcherConfig::NEVER)
+            .memory()
+            .unwrap();
+
+        let mut table = DataTable::example(false);
+        table.compute_all_size_bytes();
+        for row in table.to_rows() {
+            rec.record_row(row.unwrap(), false);
+        }
+        let msgs = storage.take();
+
+        let path =
+            std::env::temp_dir().join(format!("rerun_example_shm_sink_{}", std::process::id()));
+        std::fs::remove_file(&path).ok();
+
+        // Stands in for a viewer or relay reading from the ring buffer.
+        let mut reader = crate::sink::ShmRingReader::open_or_create(&path, 1024 * 1024).unwrap();
+        let sink =
+            crate::sink::ShmSink::new(&path, 0, Some(std::time::Duration::from_secs(1))).unwrap();
+        for msg in &msgs {
+            sink.send(msg.clone());
+        }
+
+        let mut received = Vec::new();
+        while let Some(packet) = reader.try_read() {
+            received.extend(
+                re_log_encoding::decoder::decode_bytes(
+                    re_log_encoding::decoder::VersionPolicy::Error,
+                    &packet,
+                )
+                .unwrap(),
+            );
+        }
+        std::fs::remove_file(&path).ok();
+
+        similar_asserts::assert_eq!(msgs, received);
+    }
+
     #[test]
     fn disabled() {
         let (rec, storage) = RecordingStreamBuilder::new("rerun_example_disabled")
@@ -0,0 +1,909 @@
+//! A ring buffer of packets in shared memory, for sending log data to a reader on the same host.
+//!
+//! Any number of writers, in any number of processes, append packets to the ring by mapping the
+//! same file, usually in `/dev/shm`. A single reader, e.g. a viewer or a relay, consumes them in
+//! the order in which the writers reserved their space.
+//!
+//! Layout of the file:
+//! * A [`Header`] of [`HEADER_SIZE`] bytes with the read and write positions.
+//! * The data area of `capacity` bytes, a sequence of records.
+//!
+//! Each record starts with a [`RecordHeader`] and is padded to [`RECORD_ALIGN`] bytes. A record
+//! never wraps around the end of the data area: a writer that would cross it first fills the
+//! rest of the data area with a padding record.
+//!
+//! Positions only ever grow, the offset in the data area is the position modulo the capacity.
+//! Writers reserve space in two steps: they set [`RESERVING`] on the reserved position with a
+//! compare-exchange, which keeps other writers from reserving, mark their records as reserved
+//! together with their length, and only then publish the new reserved position. They then
+//! write their packet and commit the record by storing its tag last. The reader consumes
+//! committed records in order, zeroes them so that stale bytes are never mistaken for a
+//! committed record, and advances the consumed position.
+//! On Linux the reader sleeps on a futex that writers wake, elsewhere it polls.
+//!
+//! A writer that dies between reserving and committing its record would block the reader
+//! forever. The reader therefore skips records that stay uncommitted for [`COMMIT_TIMEOUT`],
+//! using the length stored when the record was marked, which every published record has. If
+//! the writer died before publishing its reservation, the reader takes the reservation back.
+
+use std::os::unix::fs::OpenOptionsExt as _;
+use std::os::unix::io::AsRawFd as _;
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicU32, AtomicU64, Ordering};
+use std::time::{Duration, Instant};
+
+/// Identifies an initialized ring buffer file, and the version of its layout.
+const MAGIC: u64 = u64::from_le_bytes(*b"RRSHM002");
+
+/// Size of the [`Header`] at the start of the file, in bytes.
+const HEADER_SIZE: usize = 256;
+
+/// Records start at multiples of this, in bytes.
+const RECORD_ALIGN: u64 = 16;
+
+/// Size of the [`RecordHeader`] in front of each packet, in bytes.
+const RECORD_HEADER_SIZE: u64 = 16;
+
+/// Smallest supported capacity of the data area, in bytes.
+const MIN_CAPACITY: u64 = 4096;
+
+/// Set on the reserved position while a writer marks the records it is reserving.
+///
+/// Positions are multiples of [`RECORD_ALIGN`], so this bit is otherwise always clear.
+const RESERVING: u64 = 1;
+
+const KIND_PACKET: u32 = 1;
+const KIND_PADDING: u32 = 2;
+
+/// How long to wait for another process to finish creating the ring buffer file.
+const INIT_TIMEOUT: Duration = Duration::from_secs(1);
+
+/// Longest sleep while polling for space, or for packets on platforms without futexes.
+const MAX_POLL_INTERVAL: Duration = Duration::from_millis(1);
+
+/// How often a writer spins while another one is reserving, before it starts sleeping.
+///
+/// Reserving only takes a few stores.
+const MAX_RESERVING_SPINS: u32 = 1000;
+
+/// How long the reader waits for a reserved record to be committed, before it considers its
+/// writer dead and skips the record.
+///
+/// Far longer than a live writer takes to copy a packet.
+const COMMIT_TIMEOUT: Duration = Duration::from_secs(1);
+
+/// Longest sleep of the reader while waiting for a record to be committed.
+const STALLED_POLL_INTERVAL: Duration = Duration::from_millis(10);
+
+/// The shared state at the start of the file.
+///
+/// The positions written by different processes are on separate cache lines.
+#[repr(C)]
+struct Header {
+    /// [`MAGIC`], stored last by the process that created the file.
+    magic: AtomicU64,
+
+    /// Size of the data area in bytes.
+    capacity: AtomicU64,
+
+    _pad0: [u64; 6],
+
+    /// End of the space reserved by writers, advanced by writers.
+    ///
+    /// Has [`RESERVING`] set while a writer marks the records it is reserving.
+    reserved: AtomicU64,
+
+    _pad1: [u64; 7],
+
+    /// End of the records consumed by the reader, advanced by the reader.
+    consumed: AtomicU64,
+
+    /// Incremented by writers after each commit, the reader sleeps on it.
+    wake_seq: AtomicU32,
+
+    /// Non-zero while the reader may be sleeping on `wake_seq`.
+    reader_waiting: AtomicU32,
+
+    _pad2: [u64; 6],
+}
+
+const _: () = assert!(std::mem::size_of::<Header>() <= HEADER_SIZE);
+
+/// The header in front of each record in the data area.
+#[repr(C)]
+struct RecordHeader {
+    /// Zero before the record is reserved, the bitwise complement of its position once its
+    /// writer marked it as reserved, and its position plus one once committed.
+    tag: AtomicU64,
+
+    /// Size of the packet in bytes, excluding this header and the padding.
+    len: AtomicU32,
+
+    /// [`KIND_PACKET`] or [`KIND_PADDING`].
+    kind: AtomicU32,
+}
+
+const _: () = assert!(std::mem::size_of::<RecordHeader>() as u64 == RECORD_HEADER_SIZE);
+
+/// Size of the record holding a packet of `len` bytes, including the header and padding.
+#[inline]
+fn record_size(len: u64) -> u64 {
+    (RECORD_HEADER_SIZE + len).next_multiple_of(RECORD_ALIGN)
+}
+
+/// Errors that can occur when opening or writing to a [`ShmRingWriter`] or [`ShmRingReader`].
+#[derive(thiserror::Error, Debug)]
+pub enum ShmRingError {
+    /// Error opening or creating the file.
+    #[error("Failed to open shared memory {path:?}: {err}")]
+    Open { path: PathBuf, err: std::io::Error },
+
+    /// Error mapping the file into memory.
+    #[error("Failed to map shared memory {path:?}: {err}")]
+    Map { path: PathBuf, err: std::io::Error },
+
+    /// The file exists but isn't a ring buffer, or its creator didn't finish initializing it.
+    #[error("{path:?} is not a Rerun shared memory ring buffer")]
+    InvalidRing { path: PathBuf },
+
+    /// The packet is larger than the whole data area.
+    #[error("Packet of {size} bytes doesn't fit into a ring buffer of {capacity} bytes")]
+    PacketTooLarge { size: u64, capacity: u64 },
+
+    /// The reader didn't make enough space in time.
+    #[error("Timed out waiting for the reader to make space in the ring buffer")]
+    Full,
+}
+
+/// A shared mapping of a ring buffer file.
+#[derive(Debug)]
+struct Mapping {
+    ptr: *mut u8,
+    len: usize,
+    capacity: u64,
+}
+
+// SAFETY: all accesses to the shared header go through atomics, and the data area is only
+// accessed according to the reservation protocol described in the module docs.
+unsafe impl Send for Mapping {}
+
+// SAFETY: see above.
+unsafe impl Sync for Mapping {}
+
+impl Mapping {
+    /// Maps the ring buffer file at `path`, creating it with a data area of at least
+    /// `capacity` bytes if it doesn't exist yet.
+    ///
+    /// The capacity of an existing file is kept.
+    fn open_or_create(path: &Path, capacity: u64) -> Result<Self, ShmRingError> {
+        let open_err = |err| ShmRingError::Open {
+            path: path.to_owned(),
+            err,
+        };
+
+        let capacity = capacity.max(MIN_CAPACITY).next_multiple_of(RECORD_ALIGN);
+        let file_len = HEADER_SIZE as u64 + capacity;
+
+        let (file, created) = match std::fs::OpenOptions::new()
+            .read(true)
+            .write(true)
+            .create_new(true)
+            .mode(0o600)
+            .open(path)
+        {
+            Ok(file) => {
+                // The file is zeroed, i.e. all records are uncommitted.
+                file.set_len(file_len).map_err(open_err)?;
+                (file, true)
+            }
+            Err(err) if err.kind() == std::io::ErrorKind::AlreadyExists => {
+                let file = std::fs::OpenOptions::new()
+                    .read(true)
+                    .write(true)
+                    .open(path)
+                    .map_err(open_err)?;
+                (file, false)
+            }
+            Err(err) => return Err(open_err(err)),
+        };
+
+        // Another process may still be between creating the file and setting its length.
+        let deadline = Instant::now() + INIT_TIMEOUT;
+        let len = loop {
+            let len = file.metadata().map_err(open_err)?.len();
+            if len > HEADER_SIZE as u64 {
+                break len;
+            }
+            if Instant::now() >= deadline {
+                return Err(ShmRingError::InvalidRing {
+                    path: path.to_owned(),
+                });
+            }
+            std::thread::sleep(MAX_POLL_INTERVAL);
+        };
+        let len = usize::try_from(len).map_err(|_err| ShmRingError::InvalidRing {
+            path: path.to_owned(),
+        })?;
+
+        // SAFETY: a fresh shared mapping of the whole file, checked for failure below.
+        let ptr = unsafe {
+            libc::mmap(
+                std::ptr::null_mut(),
+                len,
+                libc::PROT_READ | libc::PROT_WRITE,
+                libc::MAP_SHARED,
+                file.as_raw_fd(),
+                0,
+            )
+        };
+        if ptr == libc::MAP_FAILED {
+            return Err(ShmRingError::Map {
+                path: path.to_owned(),
+                err: std::io::Error::last_os_error(),
+            });
+        }
+
+        // The mapping stays valid after the file is closed.
+        drop(file);
+
+        let mut mapping = Self {
+            ptr: ptr.cast(),
+            len,
+            capacity: 0,
+        };
+
+        let header = mapping.header();
+        if created {
+            header.capacity.store(capacity, Ordering::Relaxed);
+            header.magic.store(MAGIC, Ordering::Release);
+        } else {
+            while header.magic.load(Ordering::Acquire) != MAGIC {
+                if Instant::now() >= deadline {
+                    return Err(ShmRingError::InvalidRing {
+                        path: path.to_owned(),
+                    });
+                }
+                std::thread::sleep(MAX_POLL_INTERVAL);
+            }
+        }
+
+        let capacity = header.capacity.load(Ordering::Relaxed);
+        if capacity < MIN_CAPACITY
+            || capacity % RECORD_ALIGN != 0
+            || capacity > (len - HEADER_SIZE) as u64
+        {
+            return Err(ShmRingError::InvalidRing {
+                path: path.to_owned(),
+            });
+        }
+        mapping.capacity = capacity;
+
+        Ok(mapping)
+    }
+
+    #[inline]
+    fn header(&self) -> &Header {
+        // SAFETY: the mapping is page aligned and at least `HEADER_SIZE` bytes long.
+        unsafe { &*self.ptr.cast::<Header>() }
+    }
+
+    /// Pointer to the given offset in the data area.
+    #[inline]
+    fn data(&self, offset: u64) -> *mut u8 {
+        debug_assert!(offset < self.capacity);
+        // SAFETY: `offset` is within the data area, which follows the header.
+        unsafe { self.ptr.add(HEADER_SIZE + offset as usize) }
+    }
+
+    /// The header of the record at the given position.
+    #[inline]
+    fn record(&self, pos: u64) -> &RecordHeader {
+        // SAFETY: records start at multiples of `RECORD_ALIGN`, and never cross the end of the
+        // data area, whose size is a multiple of `RECORD_ALIGN`.
+        unsafe { &*self.data(pos % self.capacity).cast::<RecordHeader>() }
+    }
+}
+
+impl Drop for Mapping {
+    fn drop(&mut self) {
+        // SAFETY: unmaps exactly the mapping created in `open_or_create`.
+        unsafe {
+            libc::munmap(self.ptr.cast(), self.len);
+        }
+    }
+}
+
+// ---
+
+/// Appends packets to a shared memory ring buffer.
+///
+/// Any number of writers, in any number of processes, can append to the same ring buffer.
+#[derive(Debug)]
+pub struct ShmRingWriter {
+    mapping: Mapping,
+}
+
+impl ShmRingWriter {
+    /// Opens the ring buffer at `path`, usually in `/dev/shm`.
+    ///
+    /// Creates the file with a data area of at least `capacity` bytes if it doesn't exist yet,
+    /// otherwise uses the capacity of the existing file. The file is not removed when the
+    /// writer is dropped.
+    pub fn open_or_create(path: impl AsRef<Path>, capacity: u64) -> Result<Self, ShmRingError> {
+        Ok(Self {
+            mapping: Mapping::open_or_create(path.as_ref(), capacity)?,
+        })
+    }
+
+    /// Size of the data area in bytes.
+    #[inline]
+    pub fn capacity(&self) -> u64 {
+        self.mapping.capacity
+    }
+
+    /// End of the records consumed by the reader so far, as a position.
+    ///
+    /// Only ever grows, e.g. to tell whether the reader made progress.
+    #[inline]
+    pub fn consumed(&self) -> u64 {
+        self.mapping.header().consumed.load(Ordering::Acquire)
+    }
+
+    /// Appends a packet, waiting at most `timeout` for the reader to make space.
+    ///
+    /// `None` waits indefinitely.
+    pub fn write(&self, packet: &[u8], timeout: Option<Duration>) -> Result<(), ShmRingError> {
+        let mapping = &self.mapping;
+        let header = mapping.header();
+        let capacity = mapping.capacity;
+
+        let len = packet.len() as u64;
+        let size = record_size(len);
+        if len > u32::MAX as u64 || size > capacity {
+            return Err(ShmRingError::PacketTooLarge {
+                size: len,
+                capacity,
+            });
+        }
+
+        let deadline = timeout.map(|timeout| Instant::now() + timeout);
+        let pos = self.reserve(len, deadline)?;
+
+        // SAFETY: the record was reserved above, and doesn't cross the end of the data area.
+        unsafe {
+            std::ptr::copy_nonoverlapping(
+                packet.as_ptr(),
+                mapping
+                    .data(pos % capacity)
+                    .add(RECORD_HEADER_SIZE as usize),
+                packet.len(),
+            );
+        }
+        Self::commit(mapping, pos, len, KIND_PACKET);
+
+        // Sequentially consistent, so that either the reader sees the new sequence number or
+        // this sees that the reader is waiting.
+        header.wake_seq.fetch_add(1, Ordering::SeqCst);
+        if header.reader_waiting.load(Ordering::SeqCst) != 0 {
+            futex_wake(&header.wake_seq);
+        }
+
+        Ok(())
+    }
+
+    /// Waits until the reader consumed everything that was written so far.
+    ///
+    /// Returns `false` on timeout. `None` waits indefinitely.
+    pub fn wait_until_consumed(&self, timeout: Option<Duration>) -> bool {
+        let header = self.mapping.header();
+        let reserved = header.reserved.load(Ordering::Acquire) & !RESERVING;
+
+        let deadline = timeout.map(|timeout| Instant::now() + timeout);
+        let mut poll_interval = Duration::from_micros(1);
+        while header.consumed.load(Ordering::Acquire) < reserved {
+            if deadline.map_or(false, |deadline| Instant::now() >= deadline) {
+                return false;
+            }
+            std::thread::sleep(poll_interval);
+            poll_interval = (poll_interval * 2).min(MAX_POLL_INTERVAL);
+        }
+        true
+    }
+
+    /// Reserves a record for a packet of `len` bytes, waiting until `deadline` for the reader
+    /// to make space, and returns its position.
+    ///
+    /// Pads the rest of the data area first if the record wouldn't fit before its end.
+    fn reserve(&self, len: u64, deadline: Option<Instant>) -> Result<u64, ShmRingError> {
+        let mapping = &self.mapping;
+        let header = mapping.header();
+        let capacity = mapping.capacity;
+        let size = record_size(len);
+
+        let mut poll_interval = Duration::from_micros(1);
+        let mut num_spins = 0;
+
+        loop {
+            // Load the consumed position first: the reader only consumes reserved space, so
+            // the reserved position loaded after it is never behind it.
+            let consumed = header.consumed.load(Ordering::Acquire);
+            let reserved = header.reserved.load(Ordering::Acquire);
+
+            if reserved & RESERVING != 0 {
+                if num_spins < MAX_RESERVING_SPINS {
+                    num_spins += 1;
+                    std::hint::spin_loop();
+                    continue;
+                }
+            } else {
+                let pos = reserved;
+                let offset = pos % capacity;
+                let padding = if offset + size > capacity {
+                    capacity - offset
+                } else {
+                    0
+                };
+                let end = pos + padding + size;
+
+                if end - consumed <= capacity {
+                    if header
+                        .reserved
+                        .compare_exchange_weak(
+                            pos,
+                            pos | RESERVING,
+                            Ordering::Acquire,
+                            Ordering::Relaxed,
+                        )
+                        .is_err()
+                    {
+                        continue;
+                    }
+
+                    if padding > 0 {
+                        Self::mark_reserved(mapping, pos, padding - RECORD_HEADER_SIZE);
+                    }
+                    Self::mark_reserved(mapping, pos + padding, len);
+
+                    // Fails if the reader took the reservation back, because this writer took
+                    // longer than `COMMIT_TIMEOUT` to get here.
+                    if header
+                        .reserved
+                        .compare_exchange(
+                            pos | RESERVING,
+                            end,
+                            Ordering::Release,
+                            Ordering::Relaxed,
+                        )
+                        .is_err()
+                    {
+                        continue;
+                    }
+
+                    if padding > 0 {
+                        Self::commit(mapping, pos, padding - RECORD_HEADER_SIZE, KIND_PADDING);
+                    }
+                    return Ok(pos + padding);
+                }
+            }
+
+            // Out of space, or another writer is taking long to reserve.
+            if deadline.map_or(false, |deadline| Instant::now() >= deadline) {
+                return Err(ShmRingError::Full);
+            }
+            std::thread::sleep(poll_interval);
+            poll_interval = (poll_interval * 2).min(MAX_POLL_INTERVAL);
+        }
+    }
+
+    /// Lets the reader skip the record if this writer dies before committing it.
+    fn mark_reserved(mapping: &Mapping, pos: u64, len: u64) {
+        let record = mapping.record(pos);
+        record.len.store(len as u32, Ordering::Relaxed);
+        record.tag.store(!pos, Ordering::Release);
+    }
+
+    fn commit(mapping: &Mapping, pos: u64, len: u64, kind: u32) {
+        let record = mapping.record(pos);
+        record.len.store(len as u32, Ordering::Relaxed);
+        record.kind.store(kind, Ordering::Relaxed);
+        record.tag.store(pos + 1, Ordering::Release);
+    }
+}
+
+// ---
+
+/// Consumes the packets of a shared memory ring buffer.
+///
+/// There must be at most one reader per ring buffer at a time.
+#[derive(Debug)]
+pub struct ShmRingReader {
+    mapping: Mapping,
+
+    /// The position of the uncommitted record the reader is waiting for, and since when.
+    stalled: Option<(u64, Instant)>,
+}
+
+impl ShmRingReader {
+    /// Opens the ring buffer at `path`, usually in `/dev/shm`.
+    ///
+    /// Creates the file with a data area of at least `capacity` bytes if it doesn't exist yet,
+    /// otherwise uses the capacity of the existing file. Continues after the packets consumed
+    /// by previous readers. The file is not removed when the reader is dropped.
+    pub fn open_or_create(path: impl AsRef<Path>, capacity: u64) -> Result<Self, ShmRingError> {
+        Ok(Self {
+            mapping: Mapping::open_or_create(path.as_ref(), capacity)?,
+            stalled: None,
+        })
+    }
+
+    /// Size of the data area in bytes.
+    #[inline]
+    pub fn capacity(&self) -> u64 {
+        self.mapping.capacity
+    }
+
+    /// Returns the next packet if one was committed, without waiting.
+    ///
+    /// Skips records that stay uncommitted for [`COMMIT_TIMEOUT`].
+    pub fn try_read(&mut self) -> Option<Vec<u8>> {
+        loop {
+            let pos = self.mapping.header().consumed.load(Ordering::Relaxed);
+            let tag = self.mapping.record(pos).tag.load(Ordering::Acquire);
+            if tag != pos + 1 {
+                if self.skip_abandoned(pos) {
+                    continue;
+                }
+                return None;
+            }
+            self.stalled = None;
+
+            let mapping = &self.mapping;
+            let record = mapping.record(pos);
+            let capacity = mapping.capacity;
+
+            let offset = pos % capacity;
+            let len = record.len.load(Ordering::Relaxed) as u64;
+            let size = record_size(len);
+            if size > capacity - offset {
+                re_log::error_once!("Corrupt record in shared memory ring buffer");
+                return None;
+            }
+
+            let packet = (record.kind.load(Ordering::Relaxed) == KIND_PACKET).then(|| {
+                // SAFETY: the committed record lies within the data area, checked above.
+                unsafe {
+                    std::slice::from_raw_parts(
+                        mapping.data(offset).add(RECORD_HEADER_SIZE as usize),
+                        len as usize,
+                    )
+                }
+                .to_vec()
+            });
+
+            self.release(pos, pos + size);
+
+            if packet.is_some() {
+                return packet;
+            }
+        }
+    }
+
+    /// Skips the uncommitted record at `pos` if it was reserved for longer than
+    /// [`COMMIT_TIMEOUT`], and returns whether it did.
+    fn skip_abandoned(&mut self, pos: u64) -> bool {
+        let header = self.mapping.header();
+        let reserved = header.reserved.load(Ordering::Acquire);
+        if reserved <= pos {
+            // Nothing was reserved, the ring is empty.
+            self.stalled = None;
+            return false;
+        }
+
+        let now = Instant::now();
+        match self.stalled {
+            Some((stalled_pos, since)) if stalled_pos == pos => {
+                if now.duration_since(since) < COMMIT_TIMEOUT {
+                    return false;
+                }
+            }
+            _ => {
+                self.stalled = Some((pos, now));
+                return false;
+            }
+        }
+        self.stalled = None;
+
+        let reserved = header.reserved.load(Ordering::Acquire);
+        if reserved == pos | RESERVING {
+            // The writer died before publishing its reservation, nothing else was reserved
+            // since. The records it may have marked are overwritten by the next writers.
+            if header
+                .reserved
+                .compare_exchange(reserved, pos, Ordering::AcqRel, Ordering::Relaxed)
+                .is_ok()
+            {
+                re_log::warn!(
+                    "Taking back a reservation of the shared memory ring buffer that a writer \
+                    didn't publish within {COMMIT_TIMEOUT:?}"
+                );
+            }
+            return false;
+        }
+
+        // Loaded after the reserved position, since records are marked before their
+        // reservation is published.
+        let record = self.mapping.record(pos);
+        let tag = record.tag.load(Ordering::Acquire);
+        if tag == pos + 1 {
+            // Committed in the meantime.
+            return true;
+        }
+        let capacity = self.mapping.capacity;
+        let size = record_size(record.len.load(Ordering::Relaxed) as u64);
+        if tag != !pos || size > capacity - pos % capacity {
+            re_log::error_once!("Corrupt record in shared memory ring buffer");
+            return false;
+        }
+        re_log::warn!(
+            "Skipping {size} bytes of the shared memory ring buffer that a writer reserved, but \
+            didn't commit within {COMMIT_TIMEOUT:?}"
+        );
+        self.release(pos, pos + size);
+        true
+    }
+
+    /// Zeroes the data area between the positions `start` and `end` and releases it to the
+    /// writers.
+    fn release(&self, start: u64, end: u64) {
+        let capacity = self.mapping.capacity;
+        let mut pos = start;
+        while pos < end {
+            let offset = pos % capacity;
+            let len = (end - pos).min(capacity - offset);
+            // SAFETY: the range lies within the data area, and was consumed by this reader but
+            // not yet released to the writers.
+            unsafe {
+                std::ptr::write_bytes(self.mapping.data(offset), 0, len as usize);
+            }
+            pos += len;
+        }
+        self.mapping.header().consumed.store(end, Ordering::Release);
+    }
+
+    /// Returns the next packet, waiting at most `timeout` for one to be committed.
+    pub fn read(&mut self, timeout: Duration) -> Option<Vec<u8>> {
+        let deadline = Instant::now() + timeout;
+        loop {
+            if let Some(packet) = self.try_read() {
+                return Some(packet);
+            }
+
+            let now = Instant::now();
+            if now >= deadline {
+                return None;
+            }
+
+            // Checks on abandoned records even if no other writer commits in the meantime.
+            let timeout = if self.stalled.is_some() {
+                (deadline - now).min(STALLED_POLL_INTERVAL)
+            } else {
+                deadline - now
+            };
+
+            let header = self.mapping.header();
+            let seq = header.wake_seq.load(Ordering::SeqCst);
+            header.reader_waiting.store(1, Ordering::SeqCst);
+            if !self.has_packet() {
+                futex_wait(&header.wake_seq, seq, timeout);
+            }
+            header.reader_waiting.store(0, Ordering::SeqCst);
+        }
+    }
+
+    /// Whether the next record is committed.
+    fn has_packet(&self) -> bool {
+        let header = self.mapping.header();
+        let pos = header.consumed.load(Ordering::Relaxed);
+        self.mapping.record(pos).tag.load(Ordering::Acquire) == pos + 1
+    }
+}
+
+// ---
+
+/// Sleeps until `word` is woken, unless it no longer holds `expected`.
+///
+/// May return early.
+#[cfg(target_os = "linux")]
+fn futex_wait(word: &AtomicU32, expected: u32, timeout: Duration) {
+    let timeout = libc::timespec {
+        tv_sec: timeout.as_secs().min(libc::time_t::MAX as u64) as libc::time_t,
+        tv_nsec: timeout.subsec_nanos() as libc::c_long,
+    };
+    // SAFETY: `word` is a valid futex word. Not `FUTEX_PRIVATE_FLAG`, since it is shared
+    // between processes.
+    unsafe {
+        libc::syscall(
+            libc::SYS_futex,
+            word.as_ptr(),
+            libc::FUTEX_WAIT,
+            expected,
+            std::ptr::addr_of!(timeout),
+        );
+    }
+}
+
+/// Wakes all waiters on `word`.
+#[cfg(target_os = "linux")]
+fn futex_wake(word: &AtomicU32) {
+    // SAFETY: `word` is a valid futex word.
+    unsafe {
+        libc::syscall(libc::SYS_futex, word.as_ptr(), libc::FUTEX_WAKE, i32::MAX);
+    }
+}
+
+#[cfg(not(target_os = "linux"))]
+fn futex_wait(word: &AtomicU32, expected: u32, timeout: Duration) {
+    if word.load(Ordering::Acquire) == expected {
+        std::thread::sleep(timeout.min(MAX_POLL_INTERVAL));
+    }
+}
+
+#[cfg(not(target_os = "linux"))]
+fn futex_wake(_word: &AtomicU32) {}
+
+// ---
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// A ring buffer file that is removed at the end of the test.
+    struct TempRing(PathBuf);
+
+    impl TempRing {
+        fn new(name: &str) -> Self {
+            let path = std::env::temp_dir()
+                .join(format!("rerun_shm_ring_test_{}_{name}", std::process::id()));
+            std::fs::remove_file(&path).ok();
+            Self(path)
+        }
+    }
+
+    impl Drop for TempRing {
+        fn drop(&mut self) {
+            std::fs::remove_file(&self.0).ok();
+        }
+    }
+
+    fn packet(writer: usize, index: usize) -> Vec<u8> {
+        let len = (writer * 31 + index * 7) % 200;
+        let mut packet = vec![index as u8; len];
+        packet.extend_from_slice(&(writer as u32).to_le_bytes());
+        packet.extend_from_slice(&(index as u32).to_le_bytes());
+        packet
+    }
+
+    #[test]
+    fn wraps_around() {
+        let ring = TempRing::new("wraps_around");
+        let writer = ShmRingWriter::open_or_create(&ring.0, MIN_CAPACITY).unwrap();
+        let mut reader = ShmRingReader::open_or_create(&ring.0, 0).unwrap();
+        assert_eq!(reader.capacity(), writer.capacity());
+
+        // Many times the capacity, with records of varying size ending at varying offsets.
+        for index in 0..1000 {
+            let packet = packet(0, index);
+            writer.write(&packet, None).unwrap();
+            assert_eq!(reader.try_read(), Some(packet));
+        }
+        assert_eq!(reader.try_read(), None);
+        assert!(writer.wait_until_consumed(Some(Duration::ZERO)));
+    }
+
+    #[test]
+    fn full_ring_times_out() {
+        let ring = TempRing::new("full_ring_times_out");
+        let writer = ShmRingWriter::open_or_create(&ring.0, MIN_CAPACITY).unwrap();
+
+        let packet = vec![0; 1000];
+        let timeout = Some(Duration::from_millis(10));
+        for _ in 0..(MIN_CAPACITY / record_size(1000)) {
+            writer.write(&packet, timeout).unwrap();
+        }
+        assert!(matches!(
+            writer.write(&packet, timeout),
+            Err(ShmRingError::Full)
+        ));
+        assert!(matches!(
+            writer.write(&vec![0; MIN_CAPACITY as usize], timeout),
+            Err(ShmRingError::PacketTooLarge { .. })
+        ));
+        assert!(!writer.wait_until_consumed(timeout));
+    }
+
+    /// Lets the record the reader waits for time out.
+    fn time_out_commit(reader: &mut ShmRingReader) {
+        let (pos, _) = reader.stalled.unwrap();
+        reader.stalled = Some((pos, Instant::now().checked_sub(COMMIT_TIMEOUT).unwrap()));
+    }
+
+    #[test]
+    fn skips_abandoned_records() {
+        let ring = TempRing::new("skips_abandoned_records");
+        let writer = ShmRingWriter::open_or_create(&ring.0, MIN_CAPACITY).unwrap();
+        let mut reader = ShmRingReader::open_or_create(&ring.0, 0).unwrap();
+
+        // A writer died after reserving its record, while another one is still writing.
+        writer.reserve(100, None).unwrap();
+        let live_pos = writer.reserve(200, None).unwrap();
+        writer.write(&packet(0, 0), None).unwrap();
+        assert_eq!(reader.try_read(), None);
+        time_out_commit(&mut reader);
+        assert_eq!(reader.try_read(), None);
+
+        // Only the abandoned record was skipped.
+        assert_eq!(reader.stalled.unwrap().0, live_pos);
+        ShmRingWriter::commit(&writer.mapping, live_pos, 200, KIND_PACKET);
+        assert_eq!(reader.try_read(), Some(vec![0; 200]));
+        assert_eq!(reader.try_read(), Some(packet(0, 0)));
+
+        // A writer died while reserving, before publishing its reservation.
+        let header = writer.mapping.header();
+        let pos = header.reserved.fetch_or(RESERVING, Ordering::AcqRel);
+        ShmRingWriter::mark_reserved(&writer.mapping, pos, 100);
+        assert!(matches!(
+            writer.write(&packet(0, 1), Some(Duration::from_millis(10))),
+            Err(ShmRingError::Full)
+        ));
+        assert_eq!(reader.try_read(), None);
+        time_out_commit(&mut reader);
+        assert_eq!(reader.try_read(), None);
+        assert_eq!(header.reserved.load(Ordering::Acquire), pos);
+        assert!(writer.wait_until_consumed(Some(Duration::ZERO)));
+
+        // The ring keeps working after wrapping around.
+        for index in 0..100 {
+            let packet = packet(0, index);
+            writer.write(&packet, None).unwrap();
+            assert_eq!(reader.try_read(), Some(packet));
+        }
+    }
+
+    #[test]
+    fn multiple_writers() {
+        const NUM_WRITERS: usize = 4;
+        const NUM_PACKETS: usize = 2000;
+
+        let ring = TempRing::new("multiple_writers");
+        let mut reader = ShmRingReader::open_or_create(&ring.0, MIN_CAPACITY).unwrap();
+
+        let writers = (0..NUM_WRITERS)
+            .map(|writer| {
+                // Each writer maps the file on its own, like separate processes would.
+                let path = ring.0.clone();
+                std::thread::spawn(move || {
+                    let ring = ShmRingWriter::open_or_create(path, 0).unwrap();
+                    for index in 0..NUM_PACKETS {
+                        ring.write(&packet(writer, index), None).unwrap();
+                    }
+                })
+            })
+            .collect::<Vec<_>>();
+
+        // The packets of each writer arrive complete and in order.
+        let mut next_index = [0; NUM_WRITERS];
+        for _ in 0..(NUM_WRITERS * NUM_PACKETS) {
+            let received = reader.read(Duration::from_secs(10)).unwrap();
+            let (_, ids) = received.split_at(received.len() - 8);
+            let writer = u32::from_le_bytes(ids[..4].try_into().unwrap()) as usize;
+            assert_eq!(received, packet(writer, next_index[writer]));
+            next_index[writer] += 1;
+        }
+        assert_eq!(next_index, [NUM_PACKETS; NUM_WRITERS]);
+
+        for writer in writers {
+            writer.join().unwrap();
+        }
+        assert_eq!(reader.try_read(), None);
+    }
+}
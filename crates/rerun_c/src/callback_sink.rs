@@ -0,0 +1,300 @@
+//! A [`LogSink`] that passes the data to a C callback, for custom transports.
+
+use std::ffi::c_void;
+use std::sync::Arc;
+use std::time::{Duration, Instant};
+
+use parking_lot::{Condvar, Mutex};
+use re_log_encoding::encoder::Encoder;
+use re_sdk::{log::LogMsg, sink::LogSink};
+
+// ----------------------------------------------------------------------------
+// Types:
+
+/// This is called `rr_sink_format` in the C API.
+#[repr(u32)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum CSinkFormat {
+    Rrd = 1,
+    Arrow = 2,
+}
+
+/// This is called `rr_sink_options` in the C API.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct CSinkOptions {
+    pub format: CSinkFormat,
+    pub min_chunk_bytes: u64,
+    pub max_chunk_delay_sec: f32,
+}
+
+/// This is called `rr_sink_chunk` in the C API.
+#[repr(C)]
+pub struct CSinkChunk {
+    pub bytes: *const u8,
+    pub num_bytes: u64,
+    pub release: Option<extern "C" fn(release_data: *mut c_void)>,
+    pub release_data: *mut c_void,
+    pub schema: arrow2::ffi::ArrowSchema,
+    pub array: arrow2::ffi::ArrowArray,
+}
+
+impl CSinkChunk {
+    /// Hands over `bytes`, to be freed with the chunk's `release`.
+    pub fn from_bytes(bytes: Vec<u8>) -> Self {
+        let bytes = Box::new(bytes);
+        Self {
+            bytes: bytes.as_ptr(),
+            num_bytes: bytes.len() as u64,
+            release: Some(release_bytes),
+            release_data: Box::into_raw(bytes).cast(),
+            schema: arrow2::ffi::ArrowSchema::empty(),
+            array: arrow2::ffi::ArrowArray::empty(),
+        }
+    }
+}
+
+impl Drop for CSinkChunk {
+    fn drop(&mut self) {
+        // Arrow2 implements drop for ArrowArray and ArrowSchema.
+        if let Some(release) = self.release.take() {
+            release(self.release_data);
+        }
+    }
+}
+
+/// This is called `rr_sink_callback` in the C API.
+pub type CSinkCallback = extern "C" fn(user_data: *mut c_void, chunk: *mut CSinkChunk);
+
+/// This is the `free_user_data` argument of `rr_recording_stream_set_callback_sink`.
+pub type CFreeUserData = extern "C" fn(user_data: *mut c_void);
+
+// ----------------------------------------------------------------------------
+
+/// The user data of a [`CallbackSink`], freed on drop.
+pub struct UserData {
+    pub user_data: *mut c_void,
+    pub free_user_data: Option<CFreeUserData>,
+}
+
+// SAFETY: the C API requires the callback and its user data to be usable from any thread.
+#[allow(unsafe_code)]
+unsafe impl Send for UserData {}
+
+// SAFETY: see above.
+#[allow(unsafe_code)]
+unsafe impl Sync for UserData {}
+
+impl Drop for UserData {
+    fn drop(&mut self) {
+        if let Some(free_user_data) = self.free_user_data {
+            free_user_data(self.user_data);
+        }
+    }
+}
+
+/// The `.rrd` stream, whose encoded bytes are passed on in chunks.
+#[derive(Default)]
+struct RrdStream {
+    /// Created with the first message and kept, such that only the first chunk starts with the
+    /// file header and all chunks together form a single stream.
+    encoder: Option<Encoder<Vec<u8>>>,
+
+    /// When the oldest message that wasn't passed on yet was encoded.
+    oldest: Option<Instant>,
+
+    /// Tells the timer thread to stop.
+    shutdown: bool,
+}
+
+/// The part of a [`CallbackSink`] that is shared with its timer thread.
+struct Shared {
+    callback: CSinkCallback,
+    user_data: UserData,
+    format: CSinkFormat,
+    min_chunk_bytes: usize,
+    max_chunk_delay: Duration,
+
+    /// Also serializes the calls to the callback.
+    rrd: Mutex<RrdStream>,
+
+    /// Wakes the timer thread when messages become pending, or when the sink is dropped.
+    timer_wakeup: Condvar,
+}
+
+impl Shared {
+    fn call(&self, mut chunk: CSinkChunk) {
+        (self.callback)(self.user_data.user_data, &mut chunk);
+        // Releases whatever the callback didn't take ownership of.
+        drop(chunk);
+    }
+
+    fn send_rrd(&self, msg: &LogMsg) {
+        let mut guard = self.rrd.lock();
+        let rrd = &mut *guard;
+
+        if rrd.encoder.is_none() {
+            match Encoder::new(re_log_encoding::EncodingOptions::UNCOMPRESSED, Vec::new()) {
+                Ok(encoder) => rrd.encoder = Some(encoder),
+                Err(err) => {
+                    re_log::error_once!("Failed to encode log message: {err}");
+                    return;
+                }
+            }
+        }
+
+        let Some(encoder) = rrd.encoder.as_mut() else {
+            return;
+        };
+        if let Err(err) = encoder.append(msg) {
+            re_log::error_once!("Failed to encode log message: {err}");
+            return;
+        }
+        let num_bytes = encoder.get_ref().len();
+
+        let oldest = if let Some(oldest) = rrd.oldest {
+            oldest
+        } else {
+            let now = Instant::now();
+            rrd.oldest = Some(now);
+            self.timer_wakeup.notify_one();
+            now
+        };
+
+        if self.min_chunk_bytes <= num_bytes || self.max_chunk_delay <= oldest.elapsed() {
+            self.send_pending(rrd);
+        }
+    }
+
+    fn send_pending(&self, rrd: &mut RrdStream) {
+        if rrd.oldest.take().is_none() {
+            return;
+        }
+        let Some(encoder) = rrd.encoder.as_mut() else {
+            return;
+        };
+
+        // The encoder keeps going, so the next chunk continues the stream.
+        self.call(CSinkChunk::from_bytes(std::mem::take(encoder.get_mut())));
+    }
+
+    fn send_arrow(&self, msg: &LogMsg) {
+        // Only tables have an Arrow representation.
+        let LogMsg::ArrowMsg(_, arrow_msg) = msg else {
+            return;
+        };
+
+        let data_type = arrow2::datatypes::DataType::Struct(arrow_msg.schema.fields.clone());
+        let field = arrow2::datatypes::Field::new("", data_type.clone(), false)
+            .with_metadata(arrow_msg.schema.metadata.clone());
+        let array =
+            arrow2::array::StructArray::new(data_type, arrow_msg.chunk.arrays().to_vec(), None);
+
+        // Serializes the calls to the callback.
+        let _rrd = self.rrd.lock();
+        self.call(CSinkChunk {
+            bytes: std::ptr::null(),
+            num_bytes: 0,
+            release: None,
+            release_data: std::ptr::null_mut(),
+            schema: arrow2::ffi::export_field_to_c(&field),
+            array: arrow2::ffi::export_array_to_c(array.boxed()),
+        });
+    }
+}
+
+/// Passes on pending `.rrd` chunks once they are `max_chunk_delay` old, also while no new
+/// messages arrive.
+fn timer_thread(shared: &Shared) {
+    let mut rrd = shared.rrd.lock();
+    while !rrd.shutdown {
+        let due = rrd
+            .oldest
+            .and_then(|oldest| oldest.checked_add(shared.max_chunk_delay));
+        match due {
+            None => shared.timer_wakeup.wait(&mut rrd),
+            Some(due) if due <= Instant::now() => shared.send_pending(&mut rrd),
+            Some(due) => {
+                shared.timer_wakeup.wait_until(&mut rrd, due);
+            }
+        }
+    }
+}
+
+/// Passes the log messages to a C callback, either encoded as `.rrd` chunks or as Arrow tables.
+pub struct CallbackSink {
+    shared: Arc<Shared>,
+
+    /// Only used for `.rrd` chunks with a `max_chunk_delay`.
+    timer: Option<std::thread::JoinHandle<()>>,
+}
+
+impl CallbackSink {
+    pub fn new(callback: CSinkCallback, user_data: UserData, options: &CSinkOptions) -> Self {
+        // Infinity never passes on chunks because of their age.
+        let max_chunk_delay = Duration::try_from_secs_f32(options.max_chunk_delay_sec.max(0.0))
+            .unwrap_or(Duration::MAX);
+        let shared = Arc::new(Shared {
+            callback,
+            user_data,
+            format: options.format,
+            min_chunk_bytes: options.min_chunk_bytes as usize,
+            max_chunk_delay,
+            rrd: Mutex::new(RrdStream::default()),
+            timer_wakeup: Condvar::new(),
+        });
+
+        // Without a delay, every message is passed on right away.
+        let timer = if options.format == CSinkFormat::Rrd && !max_chunk_delay.is_zero() {
+            std::thread::Builder::new()
+                .name("CallbackSink::timer".into())
+                .spawn({
+                    let shared = shared.clone();
+                    move || timer_thread(&shared)
+                })
+                .map_err(|err| {
+                    re_log::error!(
+                        "Failed to spawn the callback sink timer, chunks are only passed on when \
+                         new messages arrive: {err}"
+                    );
+                })
+                .ok()
+        } else {
+            None
+        };
+
+        Self { shared, timer }
+    }
+}
+
+#[allow(unsafe_code)]
+extern "C" fn release_bytes(release_data: *mut c_void) {
+    // SAFETY: `release_data` is the boxed vector created in `CSinkChunk::from_bytes`, released only once.
+    drop(unsafe { Box::from_raw(release_data.cast::<Vec<u8>>()) });
+}
+
+impl LogSink for CallbackSink {
+    fn send(&self, msg: LogMsg) {
+        match self.shared.format {
+            CSinkFormat::Rrd => self.shared.send_rrd(&msg),
+            CSinkFormat::Arrow => self.shared.send_arrow(&msg),
+        }
+    }
+
+    fn flush_blocking(&self) {
+        self.shared.send_pending(&mut self.shared.rrd.lock());
+    }
+}
+
+impl Drop for CallbackSink {
+    fn drop(&mut self) {
+        if let Some(timer) = self.timer.take() {
+            self.shared.rrd.lock().shutdown = true;
+            self.shared.timer_wakeup.notify_one();
+            if timer.join().is_err() {
+                re_log::error!("The callback sink timer panicked");
+            }
+        }
+        self.flush_blocking();
+    }
+}
@@ -5,6 +5,7 @@
 #![crate_type = "staticlib"]
 #![allow(clippy::missing_safety_doc, clippy::undocumented_unsafe_blocks)] // Too much unsafe
 
+mod callback_sink;
 mod component_type_registry;
 mod error;
 mod ptr;
@@ -12,13 +13,16 @@ mod recording_streams;
 
 use std::ffi::{c_char, c_uchar, CString};
 
+use callback_sink::{CFreeUserData, CSinkCallback, CSinkChunk, CSinkOptions, CallbackSink};
 use component_type_registry::COMPONENT_TYPES;
 use once_cell::sync::Lazy;
 
 use re_sdk::{
     external::re_log_types::{self},
     log::{DataCell, DataRow},
+    time::{TimeInt, TimeType},
     ComponentName, EntityPath, RecordingStream, RecordingStreamBuilder, StoreKind, TimePoint,
+    Timeline,
 };
 use recording_streams::{recording_stream, RECORDING_STREAMS};
 
@@ -155,6 +159,33 @@ pub struct CComponentType {
     pub schema: arrow2::ffi::ArrowSchema,
 }
 
+#[repr(u32)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum CTimeType {
+    /// Sequence numbers, e.g. frame numbers.
+    Sequence = 1,
+
+    /// Nanoseconds since the Unix epoch.
+    Time = 2,
+}
+
+impl From<CTimeType> for TimeType {
+    fn from(time_type: CTimeType) -> Self {
+        match time_type {
+            CTimeType::Sequence => TimeType::Sequence,
+            CTimeType::Time => TimeType::Time,
+        }
+    }
+}
+
+#[repr(C)]
+pub struct CTimeColumn {
+    pub timeline_name: CStringView,
+    pub time_type: CTimeType,
+    pub times: *const i64,
+    pub num_times: u32,
+}
+
 #[repr(C)]
 pub struct CDataCell {
     pub component_type: CComponentTypeHandle,
@@ -187,6 +218,8 @@ pub enum CErrorCode {
     RecordingStreamSaveFailure,
     RecordingStreamStdoutFailure,
     RecordingStreamSpawnFailure,
+    RecordingStreamShmFailure,
+    RecordingStreamMemoryFailure,
 
     _CategoryArrow = 0x0000_1000,
     ArrowFfiSchemaImportError,
@@ -421,8 +454,62 @@ pub extern "C" fn rr_recording_stream_connect(
     flush_timeout_sec: f32,
     error: *mut CError,
 ) {
-    if let Err(err) = rr_recording_stream_connect_impl(id, tcp_addr, flush_timeout_sec) {
-        err.write_error(error);
+    match rr_recording_stream_connect_impl(id, tcp_addr, flush_timeout_sec) {
+        Ok(()) => RECORDING_STREAMS.lock().clear_memory_sink(id),
+        Err(err) => err.write_error(error),
+    }
+}
+
+#[allow(clippy::result_large_err)]
+fn rr_recording_stream_connect_shm_impl(
+    stream: CRecordingStream,
+    path: CStringView,
+    capacity: u64,
+    flush_timeout_sec: f32,
+) -> Result<(), CError> {
+    let stream = recording_stream(stream)?;
+    let path = path.as_str("path")?;
+
+    let flush_timeout = if flush_timeout_sec >= 0.0 {
+        Some(std::time::Duration::from_secs_f32(flush_timeout_sec))
+    } else {
+        None
+    };
+
+    #[cfg(unix)]
+    {
+        stream
+            .connect_shm(path, capacity, flush_timeout)
+            .map_err(|err| {
+                CError::new(
+                    CErrorCode::RecordingStreamShmFailure,
+                    &format!("Failed to connect recording stream to shared memory {path:?}: {err}"),
+                )
+            })
+    }
+
+    #[cfg(not(unix))]
+    {
+        _ = (stream, capacity, flush_timeout);
+        Err(CError::new(
+            CErrorCode::RecordingStreamShmFailure,
+            &format!("Can't connect to shared memory {path:?}, only supported on Unix"),
+        ))
+    }
+}
+
+#[allow(unsafe_code)]
+#[no_mangle]
+pub extern "C" fn rr_recording_stream_connect_shm(
+    id: CRecordingStream,
+    path: CStringView,
+    capacity: u64,
+    flush_timeout_sec: f32,
+    error: *mut CError,
+) {
+    match rr_recording_stream_connect_shm_impl(id, path, capacity, flush_timeout_sec) {
+        Ok(()) => RECORDING_STREAMS.lock().clear_memory_sink(id),
+        Err(err) => err.write_error(error),
     }
 }
 
@@ -461,8 +548,9 @@ pub extern "C" fn rr_recording_stream_spawn(
     flush_timeout_sec: f32,
     error: *mut CError,
 ) {
-    if let Err(err) = rr_recording_stream_spawn_impl(id, spawn_opts, flush_timeout_sec) {
-        err.write_error(error);
+    match rr_recording_stream_spawn_impl(id, spawn_opts, flush_timeout_sec) {
+        Ok(()) => RECORDING_STREAMS.lock().clear_memory_sink(id),
+        Err(err) => err.write_error(error),
     }
 }
 
@@ -487,8 +575,9 @@ pub extern "C" fn rr_recording_stream_save(
     path: CStringView,
     error: *mut CError,
 ) {
-    if let Err(err) = rr_recording_stream_save_impl(id, path) {
-        err.write_error(error);
+    match rr_recording_stream_save_impl(id, path) {
+        Ok(()) => RECORDING_STREAMS.lock().clear_memory_sink(id),
+        Err(err) => err.write_error(error),
     }
 }
 
@@ -505,11 +594,111 @@ fn rr_recording_stream_stdout_impl(stream: CRecordingStream) -> Result<(), CErro
 #[allow(unsafe_code)]
 #[no_mangle]
 pub extern "C" fn rr_recording_stream_stdout(id: CRecordingStream, error: *mut CError) {
-    if let Err(err) = rr_recording_stream_stdout_impl(id) {
+    match rr_recording_stream_stdout_impl(id) {
+        Ok(()) => RECORDING_STREAMS.lock().clear_memory_sink(id),
+        Err(err) => err.write_error(error),
+    }
+}
+
+#[allow(clippy::result_large_err)]
+fn rr_recording_stream_memory_impl(stream: CRecordingStream) -> Result<(), CError> {
+    let storage = recording_stream(stream)?.memory();
+    RECORDING_STREAMS.lock().set_memory_sink(stream, storage);
+    Ok(())
+}
+
+#[allow(unsafe_code)]
+#[no_mangle]
+pub extern "C" fn rr_recording_stream_memory(id: CRecordingStream, error: *mut CError) {
+    if let Err(err) = rr_recording_stream_memory_impl(id) {
         err.write_error(error);
     }
 }
 
+#[allow(clippy::result_large_err)]
+fn rr_recording_stream_drain_memory_impl(stream: CRecordingStream) -> Result<Vec<u8>, CError> {
+    let rec = recording_stream(stream)?;
+
+    // No I/O involved, this only makes the batcher pass on the pending tables.
+    // `take` doesn't flush storages created by `RecordingStream::memory`, so this has to.
+    // Done before locking, such that other recording streams aren't blocked by the flush.
+    rec.flush_blocking();
+    let Some(messages) = RECORDING_STREAMS.lock().take_memory_sink(stream) else {
+        return Err(CError::new(
+            CErrorCode::RecordingStreamMemoryFailure,
+            "The recording stream isn't set to a memory sink",
+        ));
+    };
+
+    re_log_encoding::encoder::encode_to_bytes(
+        re_log_encoding::EncodingOptions::COMPRESSED,
+        messages.iter(),
+    )
+    .map_err(|err| {
+        CError::new(
+            CErrorCode::RecordingStreamMemoryFailure,
+            &format!("Failed to encode the memory sink: {err}"),
+        )
+    })
+}
+
+#[allow(unsafe_code)]
+#[no_mangle]
+pub extern "C" fn rr_recording_stream_drain_memory(
+    id: CRecordingStream,
+    out_chunk: *mut CSinkChunk,
+    error: *mut CError,
+) {
+    if out_chunk.is_null() {
+        CError::unexpected_null("out_chunk").write_error(error);
+        return;
+    }
+
+    match rr_recording_stream_drain_memory_impl(id) {
+        // SAFETY: checked for null above, the previous content is plain data owned by the caller.
+        Ok(bytes) => unsafe { out_chunk.write(CSinkChunk::from_bytes(bytes)) },
+        Err(err) => err.write_error(error),
+    }
+}
+
+#[allow(clippy::result_large_err)]
+fn rr_recording_stream_set_callback_sink_impl(
+    stream: CRecordingStream,
+    options: *const CSinkOptions,
+    callback: Option<CSinkCallback>,
+    user_data: callback_sink::UserData,
+) -> Result<(), CError> {
+    let stream = recording_stream(stream)?;
+    let options = ptr::try_ptr_as_ref(options, "options")?;
+    let Some(callback) = callback else {
+        return Err(CError::unexpected_null("callback"));
+    };
+
+    stream.set_sink(Box::new(CallbackSink::new(callback, user_data, options)));
+    Ok(())
+}
+
+#[allow(unsafe_code)]
+#[no_mangle]
+pub extern "C" fn rr_recording_stream_set_callback_sink(
+    id: CRecordingStream,
+    options: *const CSinkOptions,
+    callback: Option<CSinkCallback>,
+    user_data: *mut std::ffi::c_void,
+    free_user_data: Option<CFreeUserData>,
+    error: *mut CError,
+) {
+    // Frees the user data also on failure.
+    let user_data = callback_sink::UserData {
+        user_data,
+        free_user_data,
+    };
+    match rr_recording_stream_set_callback_sink_impl(id, options, callback, user_data) {
+        Ok(()) => RECORDING_STREAMS.lock().clear_memory_sink(id),
+        Err(err) => err.write_error(error),
+    }
+}
+
 #[allow(clippy::result_large_err)]
 fn rr_recording_stream_set_time_sequence_impl(
     stream: CRecordingStream,
@@ -613,6 +802,66 @@ pub extern "C" fn rr_recording_stream_reset_time(stream: CRecordingStream) {
     }
 }
 
+/// Imports the data cells passed to one of the logging functions, taking ownership of them.
+#[allow(unsafe_code)]
+#[allow(clippy::result_large_err)]
+fn import_data_cells(
+    data_cells: *mut CDataCell,
+    num_data_cells: usize,
+) -> Result<re_log_types::DataCellVec, CError> {
+    let mut cells = re_log_types::DataCellVec::default();
+    cells.reserve(num_data_cells);
+
+    let data_cells = unsafe { std::slice::from_raw_parts_mut(data_cells, num_data_cells) };
+
+    let component_type_registry = COMPONENT_TYPES.read();
+
+    for data_cell in data_cells {
+        // Arrow2 implements drop for ArrowArray and ArrowSchema.
+        //
+        // Therefore, for things to work correctly we have to take ownership of the data cell!
+        // The C interface is documented to take ownership of the data cell - the user should NOT call `release`.
+        // This makes sense because from here on out we want to manage the lifetime of the underlying schema and array data:
+        // the schema won't survive a loop iteration since it's reference passed for import, whereas the ArrowArray lives
+        // on a longer within the resulting arrow::Array.
+        let CDataCell {
+            component_type,
+            array,
+        } = unsafe { std::ptr::read(data_cell) };
+
+        // It would be nice to now mark the data_cell as "consumed" by setting the original release method to nullptr.
+        // This would signifies to the calling code that the data_cell is no longer owned.
+        // However, Arrow2 doesn't allow us to access the fields of the ArrowArray and ArrowSchema structs.
+
+        let component_type = component_type_registry.get(component_type).ok_or_else(|| {
+            CError::new(
+                CErrorCode::InvalidComponentTypeHandle,
+                &format!("Invalid component type handle: {component_type}"),
+            )
+        })?;
+
+        let values =
+            unsafe { arrow2::ffi::import_array_from_c(array, component_type.datatype.clone()) }
+                .map_err(|err| {
+                    CError::new(
+                        CErrorCode::ArrowFfiArrayImportError,
+                        &format!("Failed to import ffi array: {err}"),
+                    )
+                })?;
+
+        cells.push(
+            DataCell::try_from_arrow(component_type.name, values).map_err(|err| {
+                CError::new(
+                    CErrorCode::ArrowDataCellError,
+                    &format!("Failed to create arrow datacell: {err}"),
+                )
+            })?,
+        );
+    }
+
+    Ok(cells)
+}
+
 #[allow(unsafe_code)]
 #[allow(clippy::result_large_err)]
 #[allow(clippy::needless_pass_by_value)] // Conceptually we're consuming the data_row, as we take ownership of data it points to.
@@ -642,57 +891,7 @@ fn rr_log_impl(
         "rerun_log {entity_path:?}, num_instances: {num_instances}, num_data_cells: {num_data_cells}",
     );
 
-    let mut cells = re_log_types::DataCellVec::default();
-    cells.reserve(num_data_cells);
-
-    let data_cells = unsafe { std::slice::from_raw_parts_mut(data_cells, num_data_cells) };
-
-    {
-        let component_type_registry = COMPONENT_TYPES.read();
-
-        for data_cell in data_cells {
-            // Arrow2 implements drop for ArrowArray and ArrowSchema.
-            //
-            // Therefore, for things to work correctly we have to take ownership of the data cell!
-            // The C interface is documented to take ownership of the data cell - the user should NOT call `release`.
-            // This makes sense because from here on out we want to manage the lifetime of the underlying schema and array data:
-            // the schema won't survive a loop iteration since it's reference passed for import, whereas the ArrowArray lives
-            // on a longer within the resulting arrow::Array.
-            let CDataCell {
-                component_type,
-                array,
-            } = unsafe { std::ptr::read(data_cell) };
-
-            // It would be nice to now mark the data_cell as "consumed" by setting the original release method to nullptr.
-            // This would signifies to the calling code that the data_cell is no longer owned.
-            // However, Arrow2 doesn't allow us to access the fields of the ArrowArray and ArrowSchema structs.
-
-            let component_type = component_type_registry.get(component_type).ok_or_else(|| {
-                CError::new(
-                    CErrorCode::InvalidComponentTypeHandle,
-                    &format!("Invalid component type handle: {component_type}"),
-                )
-            })?;
-
-            let values =
-                unsafe { arrow2::ffi::import_array_from_c(array, component_type.datatype.clone()) }
-                    .map_err(|err| {
-                        CError::new(
-                            CErrorCode::ArrowFfiArrayImportError,
-                            &format!("Failed to import ffi array: {err}"),
-                        )
-                    })?;
-
-            cells.push(
-                DataCell::try_from_arrow(component_type.name, values).map_err(|err| {
-                    CError::new(
-                        CErrorCode::ArrowDataCellError,
-                        &format!("Failed to create arrow datacell: {err}"),
-                    )
-                })?,
-            );
-        }
-    }
+    let cells = import_data_cells(data_cells, num_data_cells)?;
 
     let data_row = DataRow::from_cells(
         row_id,
@@ -726,6 +925,107 @@ pub unsafe extern "C" fn rr_recording_stream_log(
     }
 }
 
+#[allow(unsafe_code)]
+#[allow(clippy::result_large_err)]
+fn rr_log_temporal_batch_impl(
+    stream: CRecordingStream,
+    entity_path: CStringView,
+    time_column: CTimeColumn,
+    num_data_cells: u32,
+    data_cells: *mut CDataCell,
+) -> Result<(), CError> {
+    let mut row_id = re_sdk::log::RowId::new();
+
+    let stream = recording_stream(stream)?;
+
+    // Take ownership of the data cells before anything else can fail.
+    let cells = import_data_cells(data_cells, num_data_cells as usize)?;
+
+    let entity_path = entity_path.as_str("entity_path")?;
+    let entity_path = EntityPath::parse_forgiving(entity_path);
+
+    let CTimeColumn {
+        timeline_name,
+        time_type,
+        times,
+        num_times,
+    } = time_column;
+    let timeline = Timeline::new(timeline_name.as_str("timeline_name")?, time_type.into());
+    let times = ptr::try_ptr_as_slice(times, num_times, "times")?;
+
+    for cell in &cells {
+        let num_instances = cell.num_instances();
+        if num_instances != num_times && num_instances != 1 {
+            return Err(CError::new(
+                CErrorCode::ArrowDataCellError,
+                &format!(
+                    "Data cell of {} holds {num_instances} instances, expected one per time point \
+                    ({num_times}) or a single one",
+                    cell.component_name()
+                ),
+            ));
+        }
+    }
+
+    re_log::debug!(
+        "rerun_log_temporal_batch {entity_path:?}, num_times: {num_times}, num_data_cells: {num_data_cells}",
+    );
+
+    let mut data_rows = Vec::with_capacity(times.len());
+    for (index, time) in times.iter().enumerate() {
+        let row_cells = cells
+            .iter()
+            .map(|cell| {
+                if cell.num_instances() == 1 {
+                    cell.clone()
+                } else {
+                    // Zero-copy: the slice shares the buffers of the whole batch.
+                    DataCell::from_arrow(
+                        cell.component_name(),
+                        cell.as_arrow_ref().sliced(index, 1),
+                    )
+                }
+            })
+            .collect::<re_log_types::DataCellVec>();
+
+        let timepoint = TimePoint::from([(timeline, TimeInt::from(*time))]);
+
+        let data_row = DataRow::from_cells(row_id, timepoint, entity_path.clone(), 1, row_cells)
+            .map_err(|err| {
+                CError::new(
+                    CErrorCode::ArrowDataCellError,
+                    &format!("Failed to create DataRow from temporal batch: {err}"),
+                )
+            })?;
+        data_rows.push(data_row);
+
+        row_id = row_id.next();
+    }
+
+    // Also gets the thread's current time on all other timelines and a log tick per row, like
+    // the rows of `rr_recording_stream_log`.
+    stream.record_temporal_rows(data_rows);
+
+    Ok(())
+}
+
+#[allow(unsafe_code)]
+#[no_mangle]
+pub unsafe extern "C" fn rr_recording_stream_log_temporal_batch(
+    stream: CRecordingStream,
+    entity_path: CStringView,
+    time_column: CTimeColumn,
+    num_data_cells: u32,
+    data_cells: *mut CDataCell,
+    error: *mut CError,
+) {
+    if let Err(err) =
+        rr_log_temporal_batch_impl(stream, entity_path, time_column, num_data_cells, data_cells)
+    {
+        err.write_error(error);
+    }
+}
+
 #[allow(unsafe_code)]
 #[allow(clippy::result_large_err)]
 fn rr_log_file_from_path_impl(
@@ -1,6 +1,6 @@
 use once_cell::sync::Lazy;
 use parking_lot::Mutex;
-use re_sdk::{RecordingStream, StoreKind};
+use re_sdk::{log::LogMsg, sink::MemorySinkStorage, RecordingStream, StoreKind};
 
 use crate::{
     CError, CRecordingStream, RR_REC_STREAM_CURRENT_BLUEPRINT, RR_REC_STREAM_CURRENT_RECORDING,
@@ -10,6 +10,9 @@ use crate::{
 pub struct RecStreams {
     next_id: CRecordingStream,
     streams: ahash::HashMap<CRecordingStream, RecordingStream>,
+
+    /// The storage of the memory sinks set with `rr_recording_stream_memory`.
+    memory_sinks: ahash::HashMap<CRecordingStream, MemorySinkStorage>,
 }
 
 impl RecStreams {
@@ -33,9 +36,29 @@ impl RecStreams {
     pub fn remove(&mut self, id: CRecordingStream) -> Option<RecordingStream> {
         match id {
             RR_REC_STREAM_CURRENT_BLUEPRINT | RR_REC_STREAM_CURRENT_RECORDING => None,
-            _ => self.streams.remove(&id),
+            _ => {
+                self.memory_sinks.remove(&id);
+                self.streams.remove(&id)
+            }
         }
     }
+
+    pub fn set_memory_sink(&mut self, id: CRecordingStream, storage: MemorySinkStorage) {
+        self.memory_sinks.insert(id, storage);
+    }
+
+    /// Forgets the memory sink of a stream whose sink was replaced by another one.
+    pub fn clear_memory_sink(&mut self, id: CRecordingStream) {
+        self.memory_sinks.remove(&id);
+    }
+
+    /// Takes the messages of the memory sink, `None` if the stream has no memory sink.
+    ///
+    /// Takes them from the stored storage, since a clone that is dropped while another thread
+    /// logs would warn about dropping its data.
+    pub fn take_memory_sink(&self, id: CRecordingStream) -> Option<Vec<LogMsg>> {
+        self.memory_sinks.get(&id).map(MemorySinkStorage::take)
+    }
 }
 
 /// All recording streams created from C.
@@ -213,6 +213,94 @@ typedef struct {
     rr_data_cell* data_cells;
 } rr_data_row;
 
+/// Type of a timeline.
+typedef uint32_t rr_time_type;
+
+enum {
+    /// Time points are sequence numbers, e.g. frame numbers.
+    RR_TIME_TYPE_SEQUENCE = 1,
+
+    /// Time points are nanoseconds since the Unix epoch.
+    RR_TIME_TYPE_TIME = 2,
+};
+
+/// Time points of many rows on a single timeline.
+typedef struct rr_time_column {
+    /// The name of the timeline, e.g. `sim_time`.
+    rr_string timeline_name;
+
+    /// `RR_TIME_TYPE_SEQUENCE` or `RR_TIME_TYPE_TIME`.
+    rr_time_type time_type;
+
+    /// One time point per row, either sequence numbers or nanoseconds.
+    const int64_t* times;
+
+    /// Number of time points, i.e. number of rows.
+    uint32_t num_times;
+} rr_time_column;
+
+/// Format of the chunks passed to a `rr_sink_callback`.
+typedef uint32_t rr_sink_format;
+
+enum {
+    /// Chunks of the `.rrd` byte stream, as written to a file or stdout.
+    ///
+    /// Only the first chunk starts with the `.rrd` file header, the chunks have to be
+    /// concatenated in order to form a valid stream.
+    RR_SINK_FORMAT_RRD = 1,
+
+    /// One Arrow table per chunk, as a struct array with one field per column.
+    ///
+    /// Recording metadata is not passed on in this format.
+    RR_SINK_FORMAT_ARROW = 2,
+};
+
+/// Options of `rr_recording_stream_set_callback_sink`.
+typedef struct rr_sink_options {
+    /// `RR_SINK_FORMAT_RRD` or `RR_SINK_FORMAT_ARROW`.
+    rr_sink_format format;
+
+    /// `RR_SINK_FORMAT_RRD` only: log messages are collected until a chunk has at least this
+    /// many bytes. Zero passes on every log message as soon as it's encoded.
+    uint64_t min_chunk_bytes;
+
+    /// `RR_SINK_FORMAT_RRD` only: a chunk is passed on as soon as its oldest log message is
+    /// older than this, even if it's smaller than `min_chunk_bytes`.
+    ///
+    /// This is also checked while no new log messages arrive, flushing the recording stream
+    /// passes on all collected log messages right away.
+    float max_chunk_delay_sec;
+} rr_sink_options;
+
+/// A chunk of log data passed to a `rr_sink_callback`, borrowed for the duration of the call.
+///
+/// To keep the data beyond the call without copying it, take ownership of it: set `release`
+/// to null and call it later with `release_data`, or move `schema` and `array` out of the
+/// chunk, e.g. with Arrow C++'s `ImportRecordBatch`. Whatever is left is released after the
+/// callback returns.
+typedef struct rr_sink_chunk {
+    /// `RR_SINK_FORMAT_RRD` only: the encoded bytes.
+    const uint8_t* bytes;
+
+    /// `RR_SINK_FORMAT_RRD` only: number of encoded bytes.
+    uint64_t num_bytes;
+
+    /// `RR_SINK_FORMAT_RRD` only: frees `bytes` when called with `release_data`.
+    void (*release)(void* release_data);
+
+    /// Argument of `release`.
+    void* release_data;
+
+    /// `RR_SINK_FORMAT_ARROW` only: schema of `array`, with the table metadata.
+    struct ArrowSchema schema;
+
+    /// `RR_SINK_FORMAT_ARROW` only: the table as a struct array.
+    struct ArrowArray array;
+} rr_sink_chunk;
+
+/// Receives the log data of a recording stream, see `rr_recording_stream_set_callback_sink`.
+typedef void (*rr_sink_callback)(void* user_data, rr_sink_chunk* chunk);
+
 /// Error codes returned by the Rerun C SDK as part of `rr_error`.
 ///
 /// Category codes are used to group errors together, but are never returned directly.
@@ -231,10 +319,13 @@ enum {
 
     // Recording stream errors
     _RR_ERROR_CODE_CATEGORY_RECORDING_STREAM = 0x000000100,
+    RR_ERROR_CODE_RECORDING_STREAM_RUNTIME_FAILURE,
     RR_ERROR_CODE_RECORDING_STREAM_CREATION_FAILURE,
     RR_ERROR_CODE_RECORDING_STREAM_SAVE_FAILURE,
     RR_ERROR_CODE_RECORDING_STREAM_STDOUT_FAILURE,
     RR_ERROR_CODE_RECORDING_STREAM_SPAWN_FAILURE,
+    RR_ERROR_CODE_RECORDING_STREAM_SHM_FAILURE,
+    RR_ERROR_CODE_RECORDING_STREAM_MEMORY_FAILURE,
 
     // Arrow data processing errors.
     _RR_ERROR_CODE_CATEGORY_ARROW = 0x000001000,
@@ -342,6 +433,27 @@ extern void rr_recording_stream_connect(
     rr_recording_stream stream, rr_string tcp_addr, float flush_timeout_sec, rr_error* error
 );
 
+/// Stream all log-data to a shared memory ring buffer at the given path, usually in `/dev/shm`.
+///
+/// Creates the ring buffer with a data area of `capacity` bytes if it doesn't exist yet.
+/// Several processes can write to the same ring buffer, a reader on the same host consumes the
+/// log-data of all of them. Only supported on Unix.
+///
+/// Experimental: the viewer can't read shared memory ring buffers yet, only custom readers built
+/// on `re_sdk::sink::ShmRingReader` can.
+///
+/// flush_timeout_sec:
+/// The minimum time the SDK will wait for the reader during a flush before potentially
+/// dropping data. Passing a negative value indicates no timeout,
+/// and can cause a call to `flush` to block indefinitely.
+/// Log-data that doesn't fit into a full ring buffer is dropped after a few milliseconds.
+///
+/// This function returns immediately.
+extern void rr_recording_stream_connect_shm(
+    rr_recording_stream stream, rr_string path, uint64_t capacity, float flush_timeout_sec,
+    rr_error* error
+);
+
 /// Spawns a new Rerun Viewer process from an executable available in PATH, then connects to it
 /// over TCP.
 ///
@@ -379,6 +491,44 @@ extern void rr_recording_stream_save(rr_recording_stream stream, rr_string path,
 /// This function returns immediately.
 extern void rr_recording_stream_stdout(rr_recording_stream stream, rr_error* error);
 
+/// Stream all log-data to memory, to be taken with `rr_recording_stream_drain_memory`.
+///
+/// The log-data stays in memory until drained or the recording stream is destroyed.
+///
+/// This function returns immediately.
+extern void rr_recording_stream_memory(rr_recording_stream stream, rr_error* error);
+
+/// Takes the log-data collected since `rr_recording_stream_memory` or the last drain, encoded
+/// as a complete `.rrd` file.
+///
+/// Flushes the recording stream first. On success, the caller owns `out_chunk` and has to call
+/// its `release` with its `release_data` once done with the bytes.
+/// Fails if the stream isn't set to a memory sink, also once another sink replaced it.
+extern void rr_recording_stream_drain_memory(
+    rr_recording_stream stream, rr_sink_chunk* out_chunk, rr_error* error
+);
+
+/// Passes all log-data to a callback, e.g. to forward it over a custom transport.
+///
+/// The callback is called with the chunks in order, from a background thread or from the thread
+/// flushing the recording stream, but never concurrently. It must not log to or flush the
+/// recording stream itself.
+///
+/// Calls are serialized by a lock that flushes also take, so flushing from another thread blocks
+/// for as long as a slow callback runs.
+///
+/// Refer to `rr_sink_options` for how log data is collected into chunks and
+/// to `rr_sink_chunk` for how to keep a chunk beyond the call.
+///
+/// `free_user_data` is called with `user_data` once the sink is replaced or the recording stream
+/// is destroyed, and also if this function fails. May be null.
+///
+/// This function returns immediately.
+extern void rr_recording_stream_set_callback_sink(
+    rr_recording_stream stream, const rr_sink_options* options, rr_sink_callback callback,
+    void* user_data, void (*free_user_data)(void* user_data), rr_error* error
+);
+
 /// Initiates a flush the batching pipeline and waits for it to propagate.
 ///
 /// See `rr_recording_stream` docs for ordering semantics and multithreading guarantees.
@@ -447,6 +597,24 @@ extern void rr_recording_stream_log(
     rr_recording_stream stream, rr_data_row data_row, bool inject_time, rr_error* error
 );
 
+/// Log many rows of a single entity at once, one for each time point of `time_column`.
+///
+/// Each data cell either holds one instance per time point, where instance `i` belongs to
+/// row `i`, or a single instance shared by all rows.
+/// All rows also get the time of the calling thread on all other timelines, as set by
+/// `rr_recording_stream_set_time_*`, as well as `log_time` and `log_tick`.
+///
+/// This is much cheaper than logging each row with `rr_recording_stream_log`, e.g. for the
+/// samples of a time series.
+///
+/// Takes ownership of the passed data cells and will release underlying
+/// arrow data once it is no longer needed.
+/// Any pointers passed via `rr_string` and `time_column` can be safely freed after this call.
+extern void rr_recording_stream_log_temporal_batch(
+    rr_recording_stream stream, rr_string entity_path, rr_time_column time_column,
+    uint32_t num_data_cells, rr_data_cell* data_cells, rr_error* error
+);
+
 /// Logs the file at the given `path` using all `DataLoader`s available.
 ///
 /// A single `path` might be handled by more than one loader.
@@ -6,16 +6,32 @@
 #include "rerun/datatypes.hpp"
 
 // Rerun API.
+#include "rerun/appendable_entity.hpp"
+#include "rerun/callback_sink.hpp"
 #include "rerun/collection.hpp"
 #include "rerun/collection_adapter.hpp"
 #include "rerun/collection_adapter_builtins.hpp"
+#include "rerun/colormap.hpp"
 #include "rerun/config.hpp"
 #include "rerun/entity_path.hpp"
+#include "rerun/entity_path_filter.hpp"
 #include "rerun/error.hpp"
+#include "rerun/image_conversion.hpp"
+#include "rerun/image_downscale.hpp"
+#include "rerun/jpeg_encoder.hpp"
+#include "rerun/pointcloud.hpp"
+#include "rerun/polyline_simplification.hpp"
+#include "rerun/rate_limit.hpp"
 #include "rerun/recording_stream.hpp"
 #include "rerun/result.hpp"
 #include "rerun/sdk_info.hpp"
+#include "rerun/serialized_component_batch.hpp"
+#include "rerun/series_channel.hpp"
+#include "rerun/series_downsampling.hpp"
 #include "rerun/spawn.hpp"
+#include "rerun/tensor_conversion.hpp"
+#include "rerun/tiled_image_logger.hpp"
+#include "rerun/time_column.hpp"
 
 /// All Rerun C++ types and functions are in the `rerun` namespace or one of its nested namespaces.
 namespace rerun {
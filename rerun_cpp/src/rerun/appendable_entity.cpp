@@ -0,0 +1,110 @@
+#include "appendable_entity.hpp"
+
+#include <algorithm>
+
+#include "archetypes/line_strips3d.hpp"
+#include "archetypes/points3d.hpp"
+#include "recording_stream.hpp"
+
+namespace rerun {
+    void AppendableEntity::append(const datatypes::Vec3D* positions, size_t num_positions) {
+        _positions.insert(_positions.end(), positions, positions + num_positions);
+    }
+
+    Error AppendableEntity::try_replace(
+        size_t first, const datatypes::Vec3D* positions, size_t num_positions
+    ) {
+        if (first > _positions.size() || num_positions > _positions.size() - first) {
+            return Error(
+                ErrorCode::InvalidAppendableEntity,
+                "Can't replace positions " + std::to_string(first) + " to " +
+                    std::to_string(first + num_positions) + ", only " +
+                    std::to_string(_positions.size()) + " positions were appended."
+            );
+        }
+        if (num_positions == 0 || _chunk_size == 0) {
+            return Error::ok();
+        }
+
+        std::copy(positions, positions + num_positions, _positions.begin() + first);
+
+        const size_t last = first + num_positions - 1;
+        size_t last_chunk = last / _chunk_size;
+        // The last position of a chunk is also the first one of the next line strip chunk.
+        if (_geometry == Geometry::LineStrip && (last + 1) % _chunk_size == 0) {
+            ++last_chunk;
+        }
+        for (size_t chunk = first / _chunk_size; chunk <= last_chunk; ++chunk) {
+            _edited_chunks.push_back(chunk);
+        }
+        return Error::ok();
+    }
+
+    Error AppendableEntity::try_log(const RecordingStream& rec) {
+        if (_chunk_size == 0) {
+            return Error(ErrorCode::InvalidAppendableEntity, "Chunk size must be positive.");
+        }
+
+        const size_t num_chunks = (_positions.size() + _chunk_size - 1) / _chunk_size;
+        // The chunk of the first new position, and all chunks after it.
+        const size_t first_new_chunk =
+            _num_logged == _positions.size() ? num_chunks : _num_logged / _chunk_size;
+
+        std::sort(_edited_chunks.begin(), _edited_chunks.end());
+        _edited_chunks.erase(
+            std::unique(_edited_chunks.begin(), _edited_chunks.end()),
+            _edited_chunks.end()
+        );
+        for (const size_t chunk : _edited_chunks) {
+            if (chunk >= first_new_chunk) {
+                break;
+            }
+            RR_RETURN_NOT_OK(try_log_chunk(rec, chunk));
+        }
+        for (size_t chunk = first_new_chunk; chunk < num_chunks; ++chunk) {
+            RR_RETURN_NOT_OK(try_log_chunk(rec, chunk));
+        }
+
+        _edited_chunks.clear();
+        _num_logged = _positions.size();
+        return Error::ok();
+    }
+
+    std::pair<size_t, size_t> AppendableEntity::chunk_range(size_t chunk) const {
+        size_t begin = chunk * _chunk_size;
+        const size_t end = std::min(begin + _chunk_size, _positions.size());
+        if (_geometry == Geometry::LineStrip && begin > 0) {
+            --begin;
+        }
+        return {begin, end};
+    }
+
+    Error AppendableEntity::try_log_chunk(const RecordingStream& rec, size_t chunk) const {
+        const auto [begin, end] = chunk_range(chunk);
+        const auto first = _positions.begin() + static_cast<std::ptrdiff_t>(begin);
+        const auto last = _positions.begin() + static_cast<std::ptrdiff_t>(end);
+        const auto chunk_path = _entity_path + "/chunk_" + std::to_string(chunk);
+
+        switch (_geometry) {
+            case Geometry::Points:
+                return rec.try_log(
+                    chunk_path,
+                    archetypes::Points3D(Collection<components::Position3D>::build(
+                        end - begin,
+                        [&](auto& positions) { positions.insert(positions.end(), first, last); }
+                    ))
+                );
+            case Geometry::LineStrip:
+                return rec.try_log(
+                    chunk_path,
+                    archetypes::LineStrips3D(components::LineStrip3D(
+                        Collection<datatypes::Vec3D>::build(
+                            end - begin,
+                            [&](auto& points) { points.insert(points.end(), first, last); }
+                        )
+                    ))
+                );
+        }
+        return Error::ok();
+    }
+} // namespace rerun
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "datatypes/vec3d.hpp"
+#include "error.hpp"
+
+namespace rerun {
+    class RecordingStream;
+
+    /// Logs geometry that only ever grows, e.g. the point cloud of a SLAM map or a trajectory,
+    /// such that each update only sends what changed.
+    ///
+    /// The positions are split into chunks of `chunk_size` points, each logged to a child entity
+    /// `<entity_path>/chunk_<i>`. Logging sends the chunks that got new points, i.e. the last
+    /// one or few, and the chunks that were edited since they were last logged, e.g. after a
+    /// loop closure. Re-logging everything each update would instead cost time and bandwidth
+    /// proportional to the size of the whole map.
+    /// ```
+    /// using Geometry = rerun::AppendableEntity::Geometry;
+    /// rerun::AppendableEntity trajectory("trajectory", Geometry::LineStrip);
+    /// while (tracking) {
+    ///     trajectory.append(pose.translation);
+    ///     if (loop_closed) {
+    ///         trajectory.replace(0, corrected.data(), corrected.size());
+    ///     }
+    ///     trajectory.log(rec);
+    /// }
+    /// ```
+    ///
+    /// Not thread-safe.
+    class AppendableEntity {
+      public:
+        /// How the positions are logged.
+        enum class Geometry {
+            /// As `Points3D`.
+            Points,
+
+            /// As a single `LineStrips3D` strip through all positions.
+            ///
+            /// Each chunk also starts at the last position of the previous chunk so that the
+            /// chunks connect.
+            LineStrip,
+        };
+
+        /// \param entity_path Parent entity of the chunks.
+        /// \param geometry How the positions are logged.
+        /// \param chunk_size Maximum number of positions per chunk. Larger chunks mean fewer
+        /// entities but more data re-sent when a chunk grows or is edited.
+        AppendableEntity(std::string entity_path, Geometry geometry, size_t chunk_size = 4096)
+            : _entity_path(std::move(entity_path)), _geometry(geometry), _chunk_size(chunk_size) {}
+
+        /// Appends positions, which are logged on the next call to `log`.
+        void append(const datatypes::Vec3D* positions, size_t num_positions);
+
+        /// Appends a single position, which is logged on the next call to `log`.
+        void append(datatypes::Vec3D position) {
+            append(&position, 1);
+        }
+
+        /// Replaces positions that were already appended.
+        ///
+        /// Failures are handled with `Error::handle`.
+        /// \see try_replace
+        void replace(size_t first, const datatypes::Vec3D* positions, size_t num_positions) {
+            try_replace(first, positions, num_positions).handle();
+        }
+
+        /// Replaces positions that were already appended, e.g. after a loop closure.
+        ///
+        /// Only the chunks containing replaced positions are logged again.
+        /// \returns An error if any of the positions weren't appended yet.
+        Error try_replace(size_t first, const datatypes::Vec3D* positions, size_t num_positions);
+
+        /// All positions appended so far.
+        const std::vector<datatypes::Vec3D>& positions() const {
+            return _positions;
+        }
+
+        /// Logs all chunks that changed since the previous call.
+        ///
+        /// Failures are handled with `Error::handle`.
+        void log(const RecordingStream& rec) {
+            try_log(rec).handle();
+        }
+
+        /// Logs all chunks that changed since the previous call.
+        ///
+        /// \returns An error if the chunk size is zero or logging fails. All changed chunks are
+        /// logged again on the next call in that case.
+        Error try_log(const RecordingStream& rec);
+
+        /// Makes the next call log all chunks, e.g. after switching to another recording stream.
+        void reset() {
+            _num_logged = 0;
+            _edited_chunks.clear();
+        }
+
+      private:
+        /// Index of the first and one past the last position of the chunk.
+        std::pair<size_t, size_t> chunk_range(size_t chunk) const;
+
+        Error try_log_chunk(const RecordingStream& rec, size_t chunk) const;
+
+        std::string _entity_path;
+        Geometry _geometry;
+        size_t _chunk_size;
+
+        std::vector<datatypes::Vec3D> _positions;
+
+        /// Number of positions that were logged as part of their chunk.
+        size_t _num_logged = 0;
+
+        /// Chunks with replaced positions since the previous call to `try_log`, may repeat.
+        std::vector<size_t> _edited_chunks;
+    };
+} // namespace rerun
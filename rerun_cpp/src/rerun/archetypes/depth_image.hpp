@@ -9,6 +9,7 @@
 #include "../components/draw_order.hpp"
 #include "../components/tensor_data.hpp"
 #include "../data_cell.hpp"
+#include "../image_downscale.hpp"
 #include "../indicator_component.hpp"
 #include "../result.hpp"
 
@@ -121,6 +122,34 @@ namespace rerun::archetypes {
         explicit DepthImage(Collection<datatypes::TensorDimension> shape, const TElement* data_)
             : DepthImage(datatypes::TensorData(std::move(shape), data_)) {}
 
+        /// New 16-bit depth image from depths in meters.
+        ///
+        /// Halves the size compared to logging 32-bit floats. `meter` is chosen as the finest
+        /// resolution that covers the farthest depth, see `tensor::u16_depth_meter`.
+        /// \param shape
+        /// Shape of the image. Calls `Error::handle()` if the shape is not rank 2.
+        /// \param meters
+        /// Depth in meters, negative or NaN values mean "no depth".
+        static DepthImage from_meters(
+            Collection<datatypes::TensorDimension> shape, const float* meters
+        );
+
+        /// New 16-bit depth image from depths in meters, with `meter` units per meter.
+        ///
+        /// \see tensor::meters_to_u16
+        static DepthImage from_meters(
+            Collection<datatypes::TensorDimension> shape, const float* meters, float meter
+        );
+
+        /// Returns a copy of the depth image downscaled by an integer factor, e.g. for previews.
+        ///
+        /// Supports u16 and f32 depth. `meter` and `draw_order` are kept.
+        /// Calls `Error::handle()` and returns an empty depth image if it can't be downscaled.
+        /// \see image::downscale_depth_image_data
+        DepthImage downscaled(
+            size_t factor, image::DepthDownscaleMode mode = image::DepthDownscaleMode::Nearest
+        ) const;
+
       public:
         DepthImage() = default;
         DepthImage(DepthImage&& other) = default;
@@ -2,6 +2,13 @@
 #include "depth_image.hpp"
 
 #include "../collection_adapter_builtins.hpp"
+#include "../tensor_conversion.hpp"
+
+// <CODEGEN_COPY_TO_HEADER>
+
+#include "../image_downscale.hpp"
+
+// </CODEGEN_COPY_TO_HEADER>
 
 namespace rerun::archetypes {
 
@@ -39,6 +46,34 @@ namespace rerun::archetypes {
     explicit DepthImage(Collection<datatypes::TensorDimension> shape, const TElement* data_)
         : DepthImage(datatypes::TensorData(std::move(shape), data_)) {}
 
+    /// New 16-bit depth image from depths in meters.
+    ///
+    /// Halves the size compared to logging 32-bit floats. `meter` is chosen as the finest
+    /// resolution that covers the farthest depth, see `tensor::u16_depth_meter`.
+    /// \param shape
+    /// Shape of the image. Calls `Error::handle()` if the shape is not rank 2.
+    /// \param meters
+    /// Depth in meters, negative or NaN values mean "no depth".
+    static DepthImage from_meters(
+        Collection<datatypes::TensorDimension> shape, const float* meters
+    );
+
+    /// New 16-bit depth image from depths in meters, with `meter` units per meter.
+    ///
+    /// \see tensor::meters_to_u16
+    static DepthImage from_meters(
+        Collection<datatypes::TensorDimension> shape, const float* meters, float meter
+    );
+
+    /// Returns a copy of the depth image downscaled by an integer factor, e.g. for previews.
+    ///
+    /// Supports u16 and f32 depth. `meter` and `draw_order` are kept.
+    /// Calls `Error::handle()` and returns an empty depth image if it can't be downscaled.
+    /// \see image::downscale_depth_image_data
+    DepthImage downscaled(
+        size_t factor, image::DepthDownscaleMode mode = image::DepthDownscaleMode::Nearest
+    ) const;
+
     // </CODEGEN_COPY_TO_HEADER>
 #endif
 
@@ -55,17 +90,46 @@ namespace rerun::archetypes {
         bool overwrite_width = !shape[1].name.has_value();
 
         if (overwrite_height || overwrite_width) {
-            auto new_shape = shape.to_vector();
-
-            if (overwrite_height) {
-                new_shape[0].name = "height";
-            }
-            if (overwrite_width) {
-                new_shape[1].name = "width";
-            }
+            shape = Collection<datatypes::TensorDimension>::build(
+                shape.size(),
+                [&](auto& new_shape) {
+                    new_shape.insert(new_shape.end(), shape.begin(), shape.end());
 
-            shape = std::move(new_shape);
+                    if (overwrite_height) {
+                        new_shape[0].name = "height";
+                    }
+                    if (overwrite_width) {
+                        new_shape[1].name = "width";
+                    }
+                }
+            );
         }
     }
 
+    DepthImage DepthImage::from_meters(
+        Collection<datatypes::TensorDimension> shape, const float* meters
+    ) {
+        const float meter = tensor::u16_depth_meter(meters, tensor::element_count(shape));
+        return from_meters(std::move(shape), meters, meter);
+    }
+
+    DepthImage DepthImage::from_meters(
+        Collection<datatypes::TensorDimension> shape, const float* meters, float meter
+    ) {
+        auto buffer = tensor::u16_depth_buffer(meters, tensor::element_count(shape), meter);
+        return DepthImage(std::move(shape), std::move(buffer)).with_meter(meter);
+    }
+
+    DepthImage DepthImage::downscaled(size_t factor, image::DepthDownscaleMode mode) const {
+        auto downscaled_data = image::downscale_depth_image_data(data.data, factor, mode);
+        if (downscaled_data.is_err()) {
+            downscaled_data.error.handle();
+            return DepthImage();
+        }
+
+        DepthImage downscaled_image(std::move(downscaled_data.value));
+        downscaled_image.meter = meter;
+        downscaled_image.draw_order = draw_order;
+        return downscaled_image;
+    }
 } // namespace rerun::archetypes
@@ -112,6 +112,22 @@ namespace rerun::archetypes {
         explicit Image(Collection<datatypes::TensorDimension> shape, const TElement* data_)
             : Image(datatypes::TensorData(std::move(shape), data_)) {}
 
+        /// Replaces 8-bit pixel data by its JPEG encoding, which is typically an order of magnitude
+        /// smaller.
+        ///
+        /// Calls `Error::handle()` and leaves the image unchanged if it doesn't hold 8-bit pixels
+        /// with 1, 3 or 4 channels.
+        /// \param quality JPEG quality between 1 and 100.
+        /// \see image::encode_jpeg
+        Image encode_jpeg(int quality = 75) &&;
+
+        /// Returns a copy of the image downscaled by an integer factor, e.g. for previews.
+        ///
+        /// Averages each `factor x factor` block of pixels. Supports u8, u16 and f32 pixels.
+        /// Calls `Error::handle()` and returns an empty image if the image can't be downscaled.
+        /// \see image::downscale_image_data
+        Image downscaled(size_t factor) const;
+
       public:
         Image() = default;
         Image(Image&& other) = default;
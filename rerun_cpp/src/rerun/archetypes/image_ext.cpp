@@ -2,6 +2,8 @@
 #include "image.hpp"
 
 #include "../collection_adapter_builtins.hpp"
+#include "../image_downscale.hpp"
+#include "../jpeg_encoder.hpp"
 
 // Uncomment for better auto-complete while editing the extension.
 // #define EDIT_EXTENSION
@@ -42,6 +44,22 @@ namespace rerun::archetypes {
     explicit Image(Collection<datatypes::TensorDimension> shape, const TElement* data_)
         : Image(datatypes::TensorData(std::move(shape), data_)) {}
 
+    /// Replaces 8-bit pixel data by its JPEG encoding, which is typically an order of magnitude
+    /// smaller.
+    ///
+    /// Calls `Error::handle()` and leaves the image unchanged if it doesn't hold 8-bit pixels
+    /// with 1, 3 or 4 channels.
+    /// \param quality JPEG quality between 1 and 100.
+    /// \see image::encode_jpeg
+    Image encode_jpeg(int quality = 75) &&;
+
+    /// Returns a copy of the image downscaled by an integer factor, e.g. for previews.
+    ///
+    /// Averages each `factor x factor` block of pixels. Supports u8, u16 and f32 pixels.
+    /// Calls `Error::handle()` and returns an empty image if the image can't be downscaled.
+    /// \see image::downscale_image_data
+    Image downscaled(size_t factor) const;
+
     // </CODEGEN_COPY_TO_HEADER>
 #endif
 
@@ -71,19 +89,79 @@ namespace rerun::archetypes {
         bool overwrite_depth = shape.size() > 2 && !shape[2].name.has_value();
 
         if (overwrite_height || overwrite_width || overwrite_depth) {
-            auto new_shape = shape.to_vector();
-
-            if (overwrite_height) {
-                new_shape[0].name = "height";
-            }
-            if (overwrite_width) {
-                new_shape[1].name = "width";
-            }
-            if (overwrite_depth) {
-                new_shape[2].name = "depth";
-            }
-
-            shape = std::move(new_shape);
+            shape = Collection<datatypes::TensorDimension>::build(
+                shape.size(),
+                [&](auto& new_shape) {
+                    new_shape.insert(new_shape.end(), shape.begin(), shape.end());
+
+                    if (overwrite_height) {
+                        new_shape[0].name = "height";
+                    }
+                    if (overwrite_width) {
+                        new_shape[1].name = "width";
+                    }
+                    if (overwrite_depth) {
+                        new_shape[2].name = "depth";
+                    }
+                }
+            );
+        }
+    }
+
+    Image Image::encode_jpeg(int quality) && {
+        const auto& tensor = data.data;
+        const auto* pixels = tensor.buffer.get_u8();
+        if (pixels == nullptr || (tensor.shape.size() != 2 && tensor.shape.size() != 3)) {
+            Error(
+                ErrorCode::InvalidTensorDimension,
+                "Only 8-bit images of rank 2 or 3 can be JPEG encoded."
+            )
+                .handle();
+            return std::move(*this);
+        }
+
+        const size_t height = tensor.shape[0].size;
+        const size_t width = tensor.shape[1].size;
+        const size_t num_channels = tensor.shape.size() > 2 ? tensor.shape[2].size : 1;
+        if (pixels->size() != height * width * num_channels) {
+            Error(
+                ErrorCode::InvalidTensorDimension,
+                "Image shape doesn't match the number of pixels, can't JPEG encode it."
+            )
+                .handle();
+            return std::move(*this);
+        }
+
+        auto jpeg = image::encode_jpeg(pixels->data(), width, height, num_channels, quality);
+        if (jpeg.is_err()) {
+            jpeg.error.handle();
+            return std::move(*this);
         }
+
+        // Color JPEG images are decoded to RGB, dropping alpha.
+        const size_t num_decoded_channels = num_channels == 1 ? 1 : 3;
+        data = datatypes::TensorData(
+            {
+                datatypes::TensorDimension(height, "height"),
+                datatypes::TensorDimension(width, "width"),
+                datatypes::TensorDimension(num_decoded_channels, "depth"),
+            },
+            datatypes::TensorBuffer::jpeg(
+                Collection<uint8_t>::take_ownership(std::move(jpeg.value))
+            )
+        );
+        return std::move(*this);
+    }
+
+    Image Image::downscaled(size_t factor) const {
+        auto downscaled_data = image::downscale_image_data(data.data, factor);
+        if (downscaled_data.is_err()) {
+            downscaled_data.error.handle();
+            return Image();
+        }
+
+        Image downscaled_image(std::move(downscaled_data.value));
+        downscaled_image.draw_order = draw_order;
+        return downscaled_image;
     }
 } // namespace rerun::archetypes
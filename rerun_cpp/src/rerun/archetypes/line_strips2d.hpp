@@ -13,6 +13,7 @@
 #include "../components/text.hpp"
 #include "../data_cell.hpp"
 #include "../indicator_component.hpp"
+#include "../polyline_simplification.hpp"
 #include "../result.hpp"
 
 #include <cstdint>
@@ -82,6 +83,22 @@ namespace rerun::archetypes {
         /// Indicator component, used to identify the archetype when converting to a list of components.
         using IndicatorComponent = rerun::components::IndicatorComponent<IndicatorComponentName>;
 
+      public:
+        // Extensions to generated type defined in 'line_strips2d_ext.cpp'
+
+        /// Simplifies all line strips, removing points that hardly change their shape.
+        ///
+        /// Meant for long trajectories and contours with many nearly collinear points.
+        /// All other components are per strip and kept as they are.
+        /// \param tolerance Largest distance of a removed point from the simplified line strip for
+        /// `RamerDouglasPeucker`, see `polyline::SimplificationMethod` for `Visvalingam`.
+        /// \see polyline::simplify
+        LineStrips2D simplify(
+            float tolerance,
+            polyline::SimplificationMethod method =
+                polyline::SimplificationMethod::RamerDouglasPeucker
+        ) &&;
+
       public:
         LineStrips2D() = default;
         LineStrips2D(LineStrips2D&& other) = default;
@@ -0,0 +1,39 @@
+#include "line_strips3d.hpp"
+
+// Uncomment for better auto-complete while editing the extension.
+// #define EDIT_EXTENSION
+
+// <CODEGEN_COPY_TO_HEADER>
+
+#include "../polyline_simplification.hpp"
+
+// </CODEGEN_COPY_TO_HEADER>
+
+namespace rerun::archetypes {
+
+#ifdef EDIT_EXTENSION
+    // <CODEGEN_COPY_TO_HEADER>
+
+    /// Simplifies all line strips, removing points that hardly change their shape.
+    ///
+    /// Meant for long trajectories and contours with many nearly collinear points.
+    /// All other components are per strip and kept as they are.
+    /// \param tolerance Largest distance of a removed point from the simplified line strip for
+    /// `RamerDouglasPeucker`, see `polyline::SimplificationMethod` for `Visvalingam`.
+    /// \see polyline::simplify
+    LineStrips3D simplify(
+        float tolerance,
+        polyline::SimplificationMethod method =
+            polyline::SimplificationMethod::RamerDouglasPeucker
+    ) &&;
+
+    // </CODEGEN_COPY_TO_HEADER>
+#endif
+
+    LineStrips3D LineStrips3D::simplify(
+        float tolerance, polyline::SimplificationMethod method
+    ) && {
+        strips = polyline::simplify(strips, tolerance, method);
+        return std::move(*this);
+    }
+} // namespace rerun::archetypes
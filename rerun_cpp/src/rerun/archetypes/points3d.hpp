@@ -97,6 +97,23 @@ namespace rerun::archetypes {
         /// Indicator component, used to identify the archetype when converting to a list of components.
         using IndicatorComponent = rerun::components::IndicatorComponent<IndicatorComponentName>;
 
+      public:
+        // Extensions to generated type defined in 'points3d_ext.cpp'
+
+        /// Returns a copy of the point cloud with at most one point per voxel, e.g. for previews.
+        ///
+        /// Positions and colors are averaged per voxel. A single radius for all points is kept,
+        /// all other per-point components are dropped since they can't be averaged.
+        /// Calls `Error::handle()` and returns an empty point cloud if it can't be downsampled.
+        /// \see try_voxel_downsampled, pointcloud::voxel_downsample
+        Points3D voxel_downsampled(float voxel_size) const;
+
+        /// Returns a copy of the point cloud with at most one point per voxel, e.g. for previews.
+        ///
+        /// See `voxel_downsampled` for more information.
+        /// \returns An error if the point cloud can't be downsampled.
+        Result<Points3D> try_voxel_downsampled(float voxel_size) const;
+
       public:
         Points3D() = default;
         Points3D(Points3D&& other) = default;
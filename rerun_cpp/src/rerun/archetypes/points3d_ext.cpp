@@ -0,0 +1,58 @@
+#include "../error.hpp"
+#include "points3d.hpp"
+
+#include "../pointcloud.hpp"
+
+// Uncomment for better auto-complete while editing the extension.
+// #define EDIT_EXTENSION
+
+namespace rerun::archetypes {
+
+#ifdef EDIT_EXTENSION
+    // <CODEGEN_COPY_TO_HEADER>
+
+    /// Returns a copy of the point cloud with at most one point per voxel, e.g. for previews.
+    ///
+    /// Positions and colors are averaged per voxel. A single radius for all points is kept,
+    /// all other per-point components are dropped since they can't be averaged.
+    /// Calls `Error::handle()` and returns an empty point cloud if it can't be downsampled.
+    /// \see try_voxel_downsampled, pointcloud::voxel_downsample
+    Points3D voxel_downsampled(float voxel_size) const;
+
+    /// Returns a copy of the point cloud with at most one point per voxel, e.g. for previews.
+    ///
+    /// See `voxel_downsampled` for more information.
+    /// \returns An error if the point cloud can't be downsampled.
+    Result<Points3D> try_voxel_downsampled(float voxel_size) const;
+
+    // </CODEGEN_COPY_TO_HEADER>
+#endif
+
+    Points3D Points3D::voxel_downsampled(float voxel_size) const {
+        auto downsampled = try_voxel_downsampled(voxel_size);
+        if (downsampled.is_err()) {
+            downsampled.error.handle();
+            return Points3D();
+        }
+        return std::move(downsampled.value);
+    }
+
+    Result<Points3D> Points3D::try_voxel_downsampled(float voxel_size) const {
+        const Collection<components::Color> no_colors;
+        auto downsampled = pointcloud::voxel_downsample(
+            positions,
+            colors.has_value() ? *colors : no_colors,
+            voxel_size
+        );
+        RR_RETURN_NOT_OK(downsampled.error);
+
+        Result<Points3D> points(Points3D(std::move(downsampled.value.positions)));
+        if (colors.has_value()) {
+            points.value.colors = std::move(downsampled.value.colors);
+        }
+        if (radii.has_value() && radii->size() == 1) {
+            points.value.radii = radii;
+        }
+        return points;
+    }
+} // namespace rerun::archetypes
@@ -55,16 +55,19 @@ namespace rerun::archetypes {
         bool overwrite_width = !shape[1].name.has_value();
 
         if (overwrite_height || overwrite_width) {
-            auto new_shape = shape.to_vector();
+            shape = Collection<datatypes::TensorDimension>::build(
+                shape.size(),
+                [&](auto& new_shape) {
+                    new_shape.insert(new_shape.end(), shape.begin(), shape.end());
 
-            if (overwrite_height) {
-                new_shape[0].name = "height";
-            }
-            if (overwrite_width) {
-                new_shape[1].name = "width";
-            }
-
-            shape = std::move(new_shape);
+                    if (overwrite_height) {
+                        new_shape[0].name = "height";
+                    }
+                    if (overwrite_width) {
+                        new_shape[1].name = "width";
+                    }
+                }
+            );
         }
     }
 
@@ -77,6 +77,18 @@ namespace rerun::archetypes {
         explicit Tensor(Collection<datatypes::TensorDimension> shape, const TElement* data_)
             : Tensor(datatypes::TensorData(std::move(shape), data_)) {}
 
+        /// New half float tensor from 32-bit floats, halving its size.
+        ///
+        /// \see tensor::f32_to_f16
+        static Tensor from_f32_as_f16(
+            Collection<datatypes::TensorDimension> shape, const float* data_
+        );
+
+        /// New 32-bit float tensor from 64-bit floats, halving its size.
+        static Tensor from_f64_as_f32(
+            Collection<datatypes::TensorDimension> shape, const double* data_
+        );
+
         /// Update the `names` of the contained `TensorData` dimensions.
         ///
         /// Any existing Dimension names will be overwritten.
@@ -6,6 +6,7 @@
 #include <utility>   // std::move
 
 #include "../collection_adapter_builtins.hpp"
+#include "../tensor_conversion.hpp"
 
 namespace rerun::archetypes {
 
@@ -27,6 +28,18 @@ namespace rerun::archetypes {
     explicit Tensor(Collection<datatypes::TensorDimension> shape, const TElement* data_)
         : Tensor(datatypes::TensorData(std::move(shape), data_)) {}
 
+    /// New half float tensor from 32-bit floats, halving its size.
+    ///
+    /// \see tensor::f32_to_f16
+    static Tensor from_f32_as_f16(
+        Collection<datatypes::TensorDimension> shape, const float* data_
+    );
+
+    /// New 32-bit float tensor from 64-bit floats, halving its size.
+    static Tensor from_f64_as_f32(
+        Collection<datatypes::TensorDimension> shape, const double* data_
+    );
+
     /// Update the `names` of the contained `TensorData` dimensions.
     ///
     /// Any existing Dimension names will be overwritten.
@@ -51,13 +64,28 @@ namespace rerun::archetypes {
                 .handle();
         }
 
-        auto new_shape = shape.to_vector();
-        for (size_t i = 0; i < std::min(shape.size(), names.size()); ++i) {
-            new_shape[i].name = std::move(names[i]);
-        }
-        shape = std::move(new_shape);
+        shape = Collection<datatypes::TensorDimension>::build(shape.size(), [&](auto& new_shape) {
+            new_shape.insert(new_shape.end(), shape.begin(), shape.end());
+            for (size_t i = 0; i < std::min(shape.size(), names.size()); ++i) {
+                new_shape[i].name = std::move(names[i]);
+            }
+        });
 
         return std::move(*this);
     }
 
+    Tensor Tensor::from_f32_as_f16(
+        Collection<datatypes::TensorDimension> shape, const float* data_
+    ) {
+        auto buffer = tensor::f16_buffer(data_, tensor::element_count(shape));
+        return Tensor(std::move(shape), std::move(buffer));
+    }
+
+    Tensor Tensor::from_f64_as_f32(
+        Collection<datatypes::TensorDimension> shape, const double* data_
+    ) {
+        auto buffer = tensor::f32_buffer(data_, tensor::element_count(shape));
+        return Tensor(std::move(shape), std::move(buffer));
+    }
+
 } // namespace rerun::archetypes
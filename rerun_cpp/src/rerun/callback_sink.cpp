@@ -0,0 +1,79 @@
+#include "callback_sink.hpp"
+
+#include <arrow/c/bridge.h>
+#include <arrow/record_batch.h>
+
+#include <utility> // std::exchange, std::move
+
+#include "c/rerun.h"
+
+namespace rerun {
+    static rr_sink_format sink_format_to_c(SinkFormat format) {
+        switch (format) {
+            case SinkFormat::Rrd:
+                return RR_SINK_FORMAT_RRD;
+
+            case SinkFormat::Arrow:
+                return RR_SINK_FORMAT_ARROW;
+        }
+
+        // This should never happen since if we missed a switch case we'll get a warning on
+        // compilers which compiles as an error on CI. But let's play it safe regardless and default
+        // to the byte stream.
+        return RR_SINK_FORMAT_RRD;
+    }
+
+    void SinkOptions::fill_rerun_c_struct(rr_sink_options& sink_opts) const {
+        sink_opts.format = sink_format_to_c(format);
+        sink_opts.min_chunk_bytes = min_chunk_bytes;
+        sink_opts.max_chunk_delay_sec = max_chunk_delay_sec;
+    }
+
+    SinkChunk::SinkChunk(SinkChunk&& other) noexcept
+        : _data(std::exchange(other._data, nullptr)),
+          _size(std::exchange(other._size, 0)),
+          _release(std::exchange(other._release, nullptr)),
+          _release_data(std::exchange(other._release_data, nullptr)),
+          _record_batch(std::move(other._record_batch)) {}
+
+    SinkChunk& SinkChunk::operator=(SinkChunk&& other) noexcept {
+        if (this != &other) {
+            release();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+            _release = std::exchange(other._release, nullptr);
+            _release_data = std::exchange(other._release_data, nullptr);
+            _record_batch = std::move(other._record_batch);
+        }
+        return *this;
+    }
+
+    void SinkChunk::release() {
+        if (_release) {
+            _release(_release_data);
+        }
+        _data = nullptr;
+        _size = 0;
+        _release = nullptr;
+        _release_data = nullptr;
+        _record_batch.reset();
+    }
+
+    Result<SinkChunk> SinkChunk::from_c_ffi_struct(rr_sink_chunk& chunk) {
+        SinkChunk sink_chunk;
+
+        // Imports and thereby moves out the arrow structs, if set.
+        if (chunk.array.release != nullptr) {
+            ARROW_ASSIGN_OR_RAISE(
+                sink_chunk._record_batch,
+                arrow::ImportRecordBatch(&chunk.array, &chunk.schema)
+            );
+        }
+
+        sink_chunk._data = chunk.bytes;
+        sink_chunk._size = static_cast<size_t>(chunk.num_bytes);
+        sink_chunk._release = std::exchange(chunk.release, nullptr);
+        sink_chunk._release_data = chunk.release_data;
+        return sink_chunk;
+    }
+} // namespace rerun
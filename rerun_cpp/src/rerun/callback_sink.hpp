@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory> // shared_ptr
+
+#include "result.hpp"
+
+namespace arrow {
+    class RecordBatch;
+} // namespace arrow
+
+extern "C" struct rr_sink_chunk;
+extern "C" struct rr_sink_options;
+
+namespace rerun {
+    /// Format of the chunks passed to the callback of `RecordingStream::set_sink`.
+    enum class SinkFormat {
+        /// Chunks of the `.rrd` byte stream, as written to a file or stdout.
+        ///
+        /// Only the first chunk starts with the `.rrd` file header, the chunks have to be
+        /// concatenated in order to form a valid stream.
+        Rrd,
+
+        /// One Arrow record batch per chunk, holding one logged table.
+        ///
+        /// Recording metadata is not passed on in this format.
+        Arrow,
+    };
+
+    /// Options of `RecordingStream::set_sink`.
+    ///
+    /// Keep this in sync with rerun.h's `rr_sink_options`.
+    struct SinkOptions {
+        /// Format of the chunks.
+        SinkFormat format = SinkFormat::Rrd;
+
+        /// `SinkFormat::Rrd` only: log messages are collected until a chunk has at least this
+        /// many bytes. Zero passes on every log message as soon as it's encoded.
+        uint64_t min_chunk_bytes = 0;
+
+        /// `SinkFormat::Rrd` only: a chunk is passed on as soon as its oldest log message is
+        /// older than this, even if it's smaller than `min_chunk_bytes`.
+        ///
+        /// This is also checked while no new log messages arrive, flushing the recording stream
+        /// passes on all collected log messages right away.
+        float max_chunk_delay_sec = 0.1f;
+
+        /// Convert to the corresponding rerun_c struct for internal use.
+        ///
+        /// _Implementation note:_
+        /// By not returning it we avoid including the C header in this header.
+        /// \private
+        void fill_rerun_c_struct(rr_sink_options& sink_opts) const;
+    };
+
+    /// A chunk of log data passed to the callback of `RecordingStream::set_sink`.
+    ///
+    /// Owns the data without having copied it out of the SDK, which frees it once the chunk is
+    /// destroyed or released. Move the chunk to keep it around, e.g. until a transport finished
+    /// sending it.
+    class SinkChunk {
+      public:
+        SinkChunk() = default;
+        SinkChunk(const SinkChunk&) = delete;
+        SinkChunk& operator=(const SinkChunk&) = delete;
+        SinkChunk(SinkChunk&& other) noexcept;
+        SinkChunk& operator=(SinkChunk&& other) noexcept;
+
+        ~SinkChunk() {
+            release();
+        }
+
+        /// `SinkFormat::Rrd` only: the encoded bytes.
+        const uint8_t* data() const {
+            return _data;
+        }
+
+        /// `SinkFormat::Rrd` only: number of encoded bytes.
+        size_t size() const {
+            return _size;
+        }
+
+        /// `SinkFormat::Arrow` only: the logged table, with its metadata in the schema.
+        const std::shared_ptr<arrow::RecordBatch>& record_batch() const {
+            return _record_batch;
+        }
+
+        /// Frees the data, leaving an empty chunk.
+        void release();
+
+        /// Takes ownership of the data of a rerun C API chunk.
+        ///
+        /// Whatever isn't taken, e.g. on failure, stays in `chunk` to be released by the SDK.
+        /// \private
+        static Result<SinkChunk> from_c_ffi_struct(rr_sink_chunk& chunk);
+
+      private:
+        const uint8_t* _data = nullptr;
+        size_t _size = 0;
+        void (*_release)(void* release_data) = nullptr;
+        void* _release_data = nullptr;
+        std::shared_ptr<arrow::RecordBatch> _record_batch;
+    };
+} // namespace rerun
@@ -3,11 +3,13 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring> // std::memset
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "collection.hpp"
 #include "collection_adapter.hpp"
+#include "collection_memory_resource.hpp"
 #include "compiler_utils.hpp"
 
 namespace rerun {
@@ -20,6 +22,12 @@ namespace rerun {
 
         /// The collection batch owns the data via an std::vector.
         VectorOwned,
+
+        /// The collection shares ownership of immutable data with other collections via a
+        /// reference count.
+        ///
+        /// Copying a shared collection only increments the reference count.
+        Shared,
     };
 
     /// Generic collection of elements that are roughly contiguous in memory.
@@ -28,8 +36,10 @@ namespace rerun {
     /// * Borrowed: If data is borrowed it *must* outlive its source (in particular, the pointer to
     /// the source mustn't invalidate)
     /// * Owned: Owned data is copied into an internal std::vector
+    /// * Shared: Immutable data is reference counted, copying the collection does not copy the data
     ///
-    /// Collections are either filled explicitly using `Collection::borrow` &`Collection::take_ownership`
+    /// Collections are either filled explicitly using `Collection::borrow`,
+    /// `Collection::take_ownership` & `Collection::share`
     /// or (most commonly in user code) implicitly using the `CollectionAdapter` trait
     /// (see documentation for `CollectionAdapter` for more information on how data can be adapted).
     ///
@@ -81,6 +91,7 @@ namespace rerun {
         /// If the data is owned, this will copy the data.
         /// If the data is borrowed, this will copy the borrow,
         /// meaning there's now (at least) two collections borrowing the same data.
+        /// If the data is shared, this will only increment the reference count.
         Collection(const Collection<TElement>& other) : ownership(other.ownership) {
             switch (other.ownership) {
                 case CollectionOwnership::Borrowed: {
@@ -92,6 +103,11 @@ namespace rerun {
                     new (&storage.vector_owned) std::vector<TElement>(other.storage.vector_owned);
                     break;
                 }
+
+                case CollectionOwnership::Shared: {
+                    new (&storage.shared) SharedData(other.storage.shared);
+                    break;
+                }
             }
         }
 
@@ -100,6 +116,7 @@ namespace rerun {
         /// If the data is owned, this will copy the data.
         /// If the data is borrowed, this will copy the borrow,
         /// meaning there's now (at least) two collections borrowing the same data.
+        /// If the data is shared, this will only increment the reference count.
         void operator=(const Collection<TElement>& other) {
             this->~Collection<TElement>();
             new (this) Collection(other);
@@ -129,11 +146,9 @@ namespace rerun {
         /// This is not done as a `CollectionAdapter` since it tends to cause deduction issues
         /// (since there's special rules for overload resolution for initializer lists)
         Collection(std::initializer_list<TElement> data)
-            : ownership(CollectionOwnership::VectorOwned) {
-            // Don't assign, since the vector is in an undefined state and assigning may
-            // attempt to free data.
-            new (&storage.vector_owned) std::vector<TElement>(data);
-        }
+            : Collection(build(data.size(), [&](auto& elements) {
+                  elements.insert(elements.end(), data.begin(), data.end());
+              })) {}
 
         /// Borrows binary compatible data into the collection.
         ///
@@ -192,51 +207,89 @@ namespace rerun {
         /// Takes ownership of a single element, moving it into the collection.
         static Collection<TElement> take_ownership(TElement&& data) {
             // TODO(andreas): there should be a special path here to avoid allocating a vector.
+            return build(1, [&](auto& elements) { elements.emplace_back(std::move(data)); });
+        }
+
+#if RERUN_HAS_MEMORY_RESOURCE
+        /// Takes ownership of a temporary `std::pmr::vector`, moving it into the collection.
+        ///
+        /// The vector and its reference count are kept in the vector's memory resource,
+        /// so the collection must not outlive the resource.
+        /// The resulting collection has shared ownership, i.e. copying it does not copy the data.
+        static Collection<TElement> take_ownership(std::pmr::vector<TElement>&& data) {
+            const std::pmr::polymorphic_allocator<std::pmr::vector<TElement>> allocator(
+                data.get_allocator().resource()
+            );
+            auto vector =
+                std::allocate_shared<std::pmr::vector<TElement>>(allocator, std::move(data));
+            const size_t num_instances = vector->size();
+            const TElement* elements = vector->data();
+            return share(
+                std::shared_ptr<const TElement>(std::move(vector), elements),
+                num_instances
+            );
+        }
+#endif
+
+        /// Builds a new collection that owns its data.
+        ///
+        /// `fill` is called with an empty vector with `capacity` reserved elements which it is
+        /// expected to fill, e.g. via `emplace_back`.
+        /// If a `CollectionMemoryResourceScope` is active, this is an `std::pmr::vector` allocating
+        /// from its memory resource, otherwise an `std::vector`.
+        template <typename F>
+        static Collection<TElement> build(size_t capacity, F&& fill) {
+#if RERUN_HAS_MEMORY_RESOURCE
+            auto* resource = get_collection_memory_resource();
+            if (resource != nullptr) {
+                std::pmr::vector<TElement> elements(resource);
+                elements.reserve(capacity);
+                fill(elements);
+                return take_ownership(std::move(elements));
+            }
+#endif
             std::vector<TElement> elements;
-            elements.emplace_back(std::move(data));
+            elements.reserve(capacity);
+            fill(elements);
             return take_ownership(std::move(elements));
         }
 
-        /// Swaps the content of this collection with another.
-        void swap(Collection<TElement>& other) {
-            // (writing out this-> here to make it less confusing!)
-            switch (this->ownership) {
-                case CollectionOwnership::Borrowed: {
-                    switch (other.ownership) {
-                        case CollectionOwnership::Borrowed:
-                            std::swap(this->storage.borrowed, other.storage.borrowed);
-                            break;
-
-                        case CollectionOwnership::VectorOwned: {
-                            auto this_borrowed_data_old = this->storage.borrowed;
-                            new (&this->storage.vector_owned)
-                                std::vector<TElement>(std::move(other.storage.vector_owned));
-                            other.storage.borrowed = this_borrowed_data_old;
-                            break;
-                        }
-                    }
-                    break;
-                }
+        /// Shares ownership of immutable data with other collections.
+        ///
+        /// `data` has to point to `num_instances` contiguous elements which are kept alive and
+        /// unchanged for as long as any reference to them exists.
+        /// Use the aliasing constructor of `std::shared_ptr` to share data owned by another object.
+        static Collection<TElement> share(
+            std::shared_ptr<const TElement> data, size_t num_instances
+        ) {
+            Collection<TElement> batch;
+            batch.ownership = CollectionOwnership::Shared;
+            new (&batch.storage.shared) SharedData{std::move(data), num_instances};
+            return batch;
+        }
 
-                case CollectionOwnership::VectorOwned: {
-                    switch (other.ownership) {
-                        case CollectionOwnership::Borrowed: {
-                            auto other_borrowed_data_old = other.storage.borrowed;
-                            new (&other.storage.vector_owned)
-                                std::vector<TElement>(std::move(this->storage.vector_owned));
-                            this->storage.borrowed = other_borrowed_data_old;
-                            break;
-                        }
-
-                        case CollectionOwnership::VectorOwned:
-                            std::swap(storage.vector_owned, other.storage.vector_owned);
-                            break;
-                    }
-                    break;
-                }
-            }
+        /// Moves a temporary `std::vector` into an immutable reference counted buffer.
+        ///
+        /// Unlike `take_ownership`, copies of the resulting collection don't copy the data.
+        /// Use this for large data that is copied around, e.g. images that are logged to several
+        /// entities or stored in several archetypes.
+        static Collection<TElement> share(std::vector<TElement>&& data) {
+            return share(std::make_shared<const std::vector<TElement>>(std::move(data)));
+        }
+
+        /// Shares ownership of an immutable `std::vector` with other collections.
+        static Collection<TElement> share(std::shared_ptr<const std::vector<TElement>> data) {
+            const size_t num_instances = data->size();
+            const TElement* elements = data->data();
+            return share(std::shared_ptr<const TElement>(std::move(data), elements), num_instances);
+        }
 
-            std::swap(ownership, other.ownership);
+        /// Swaps the content of this collection with another.
+        void swap(Collection<TElement>& other) {
+            Collection<TElement> temp;
+            temp.take_storage_from(*this);
+            this->take_storage_from(other);
+            other.take_storage_from(temp);
         }
 
         ~Collection() {
@@ -246,6 +299,9 @@ namespace rerun {
                 case CollectionOwnership::VectorOwned:
                     storage.vector_owned.~vector(); // Deallocate the vector!
                     break;
+                case CollectionOwnership::Shared:
+                    storage.shared.~SharedData(); // Release the reference.
+                    break;
             }
         }
 
@@ -256,6 +312,8 @@ namespace rerun {
                     return storage.borrowed.num_instances;
                 case CollectionOwnership::VectorOwned:
                     return storage.vector_owned.size();
+                case CollectionOwnership::Shared:
+                    return storage.shared.num_instances;
             }
             return 0;
         }
@@ -267,6 +325,8 @@ namespace rerun {
                     return storage.borrowed.num_instances == 0;
                 case CollectionOwnership::VectorOwned:
                     return storage.vector_owned.empty();
+                case CollectionOwnership::Shared:
+                    return storage.shared.num_instances == 0;
             }
             return 0;
         }
@@ -278,12 +338,15 @@ namespace rerun {
         ///
         /// The pointer is only valid as long as backing storage is alive
         /// which is either until the collection is destroyed the borrowed source is destroyed/moved.
+        /// For shared data, the pointer is valid as long as any collection sharing it is alive.
         const TElement* data() const {
             switch (ownership) {
                 case CollectionOwnership::Borrowed:
                     return storage.borrowed.data;
                 case CollectionOwnership::VectorOwned:
                     return storage.vector_owned.data();
+                case CollectionOwnership::Shared:
+                    return storage.shared.data.get();
             }
 
             // We need to return something to avoid compiler warnings.
@@ -328,6 +391,43 @@ namespace rerun {
         }
 
       private:
+        /// Moves the data of `source` into this collection, leaving `source` empty and borrowed.
+        ///
+        /// This collection must be borrowed, i.e. not hold any data that needs to be released.
+        void take_storage_from(Collection<TElement>& source) {
+            assert(ownership == CollectionOwnership::Borrowed);
+
+            switch (source.ownership) {
+                case CollectionOwnership::Borrowed:
+                    storage.borrowed = source.storage.borrowed;
+                    break;
+
+                case CollectionOwnership::VectorOwned:
+                    new (&storage.vector_owned)
+                        std::vector<TElement>(std::move(source.storage.vector_owned));
+                    source.storage.vector_owned.~vector();
+                    break;
+
+                case CollectionOwnership::Shared:
+                    new (&storage.shared) SharedData(std::move(source.storage.shared));
+                    source.storage.shared.~SharedData();
+                    break;
+            }
+
+            ownership = source.ownership;
+            source.ownership = CollectionOwnership::Borrowed;
+            source.storage.borrowed.data = nullptr;
+            source.storage.borrowed.num_instances = 0;
+        }
+
+        template <typename T>
+        struct SharedStorage {
+            std::shared_ptr<const T> data;
+            size_t num_instances;
+        };
+
+        using SharedData = SharedStorage<TElement>;
+
         template <typename T>
         union CollectionStorage {
             struct {
@@ -337,6 +437,8 @@ namespace rerun {
 
             std::vector<T> vector_owned;
 
+            SharedStorage<T> shared;
+
             CollectionStorage() {
                 std::memset(reinterpret_cast<void*>(this), 0, sizeof(CollectionStorage));
             }
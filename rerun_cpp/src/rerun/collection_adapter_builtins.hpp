@@ -2,9 +2,11 @@
 
 #include "collection.hpp"
 #include "collection_adapter.hpp"
+#include "collection_memory_resource.hpp"
 #include "type_traits.hpp"
 
 #include <array>
+#include <memory>
 #include <vector>
 
 // Documenting the builtin adapters is too much clutter for the doc class overview.
@@ -26,6 +28,34 @@ namespace rerun {
         }
     };
 
+#if RERUN_HAS_MEMORY_RESOURCE
+    /// Adapter from `std::pmr::vector` of elements with the target type.
+    ///
+    /// Only takes ownership if a temporary is passed, in which case the vector and its reference
+    /// count are kept in the vector's memory resource.
+    /// No copy is performed in any case. Furthermore, elements are not moved.
+    template <typename TElement>
+    struct CollectionAdapter<TElement, std::pmr::vector<TElement>> {
+        Collection<TElement> operator()(const std::pmr::vector<TElement>& input) {
+            return Collection<TElement>::borrow(input.data(), input.size());
+        }
+
+        Collection<TElement> operator()(std::pmr::vector<TElement>&& input) {
+            return Collection<TElement>::take_ownership(std::move(input));
+        }
+    };
+#endif
+
+    /// Adapter from a reference counted immutable `std::vector` of elements with the target type.
+    ///
+    /// Shares ownership of the vector, no allocation or copy is performed.
+    template <typename TElement>
+    struct CollectionAdapter<TElement, std::shared_ptr<const std::vector<TElement>>> {
+        Collection<TElement> operator()(std::shared_ptr<const std::vector<TElement>> input) {
+            return Collection<TElement>::share(std::move(input));
+        }
+    };
+
     /// Adapter for a iterable container (see `rerun::traits::is_iterable_v`) which
     /// has a value type from which `TElement` can be constructed but is not equal to `TElement`.
     ///
@@ -42,22 +72,24 @@ namespace rerun {
                 traits::value_type_of_t<TContainer>> //
             >> {
         Collection<TElement> operator()(const TContainer& input) {
-            std::vector<TElement> elements(std::begin(input), std::end(input));
-            return Collection<TElement>::take_ownership(std::move(elements));
+            const auto size = std::distance(std::begin(input), std::end(input));
+            return Collection<TElement>::build(static_cast<size_t>(size), [&](auto& elements) {
+                for (const auto& element : input) {
+                    elements.emplace_back(element);
+                }
+            });
         }
 
         Collection<TElement> operator()(TContainer&& input) {
-            std::vector<TElement> elements;
             // There's no batch emplace method, so we need to reserve and then emplace manually.
             // We decide here to take the performance cost if a the input's iterator is not a random access iterator.
             // (in that case determining the size will have linear complexity)
-            elements.reserve(static_cast<size_t>(std::distance(std::begin(input), std::end(input)))
-            );
-            for (auto& element : input) {
-                elements.emplace_back(std::move(element));
-            }
-
-            return Collection<TElement>::take_ownership(std::move(elements));
+            const auto size = std::distance(std::begin(input), std::end(input));
+            return Collection<TElement>::build(static_cast<size_t>(size), [&](auto& elements) {
+                for (auto& element : input) {
+                    elements.emplace_back(std::move(element));
+                }
+            });
         }
     };
 
@@ -71,11 +103,13 @@ namespace rerun {
         }
 
         Collection<TElement> operator()(std::array<TElement, NumInstances>&& array) {
-            std::vector<TElement> elements(
-                std::make_move_iterator(array.begin()),
-                std::make_move_iterator(array.end())
-            );
-            return Collection<TElement>::take_ownership(std::move(elements));
+            return Collection<TElement>::build(NumInstances, [&](auto& elements) {
+                elements.insert(
+                    elements.end(),
+                    std::make_move_iterator(array.begin()),
+                    std::make_move_iterator(array.end())
+                );
+            });
         }
     };
 
@@ -89,11 +123,13 @@ namespace rerun {
         }
 
         Collection<TElement> operator()(TElement (&&array)[NumInstances]) {
-            std::vector<TElement> elements(
-                std::make_move_iterator(array),
-                std::make_move_iterator(array + NumInstances)
-            );
-            return Collection<TElement>::take_ownership(std::move(elements));
+            return Collection<TElement>::build(NumInstances, [&](auto& elements) {
+                elements.insert(
+                    elements.end(),
+                    std::make_move_iterator(array),
+                    std::make_move_iterator(array + NumInstances)
+                );
+            });
         }
     };
 
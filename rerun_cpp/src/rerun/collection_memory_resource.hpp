@@ -0,0 +1,78 @@
+#pragma once
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
+// Some standard libraries (e.g. libc++ on older macOS deployment targets) ship without `std::pmr`.
+#ifndef RERUN_HAS_MEMORY_RESOURCE
+#ifdef __cpp_lib_memory_resource
+#define RERUN_HAS_MEMORY_RESOURCE 1
+#else
+#define RERUN_HAS_MEMORY_RESOURCE 0
+#endif
+#endif
+
+#if RERUN_HAS_MEMORY_RESOURCE
+
+namespace rerun {
+    /// \private
+    namespace detail {
+        inline std::pmr::memory_resource*& collection_memory_resource() {
+            static thread_local std::pmr::memory_resource* resource = nullptr;
+            return resource;
+        }
+    } // namespace detail
+
+    /// Returns the memory resource that collections allocate from on the current thread.
+    ///
+    /// Null if no `CollectionMemoryResourceScope` is active, in which case collections allocate
+    /// via `std::vector` from the default heap.
+    inline std::pmr::memory_resource* get_collection_memory_resource() {
+        return detail::collection_memory_resource();
+    }
+
+    /// Makes all collections that the SDK allocates on the current thread allocate from a
+    /// memory resource for the lifetime of the scope.
+    ///
+    /// This applies to collections built by the builtin `CollectionAdapter`s that need to convert
+    /// or move elements and to collections built by archetype & component extensions,
+    /// e.g. when `rerun::archetypes::Image` sets default dimension names.
+    /// Together with `std::pmr::vector` data passed in by the user this allows keeping all
+    /// temporaries of a log call in an arena that is reset after every frame:
+    /// ```
+    /// std::pmr::monotonic_buffer_resource arena(1024 * 1024);
+    /// for (;;) {
+    ///     {
+    ///         rerun::CollectionMemoryResourceScope scope(&arena);
+    ///         rec.log("image", rerun::Image({height, width, 3}, pixels));
+    ///     }
+    ///     arena.release();
+    /// }
+    /// ```
+    ///
+    /// Collections allocated from the resource must not outlive it.
+    /// Logging serializes the data before returning, so it is safe to release the resource after
+    /// all archetypes logged with it were destroyed.
+    /// Scopes may be nested, the previous resource is restored when a scope ends.
+    class CollectionMemoryResourceScope {
+      public:
+        /// Sets the memory resource of the current thread, null restores default allocation.
+        explicit CollectionMemoryResourceScope(std::pmr::memory_resource* resource)
+            : _previous(detail::collection_memory_resource()) {
+            detail::collection_memory_resource() = resource;
+        }
+
+        ~CollectionMemoryResourceScope() {
+            detail::collection_memory_resource() = _previous;
+        }
+
+        CollectionMemoryResourceScope(const CollectionMemoryResourceScope&) = delete;
+        CollectionMemoryResourceScope& operator=(const CollectionMemoryResourceScope&) = delete;
+
+      private:
+        std::pmr::memory_resource* _previous;
+    };
+} // namespace rerun
+
+#endif
@@ -0,0 +1,293 @@
+#include "colormap.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+
+#include "shared_array.hpp"
+
+namespace rerun::colormap {
+    constexpr size_t LUT_SIZE = 256;
+    using Lut = std::array<uint32_t, LUT_SIZE>;
+
+    // The colormaps are the same polynomial approximations that the viewer uses,
+    // see `crates/re_renderer/src/colormap.rs`.
+
+    /// Degree 6 polynomial approximation of a matplotlib colormap, in Horner order.
+    using MatplotlibCoefficients = double[7][3];
+
+    // Polynomials fitted to matplotlib colormaps, taken from https://www.shadertoy.com/view/WlfXRN.
+    //
+    // License CC0 (public domain)
+    //   https://creativecommons.org/share-your-work/public-domain/cc0/
+    //
+    // Data fitted from https://github.com/BIDS/colormap/blob/master/colormaps.py (CC0).
+
+    static constexpr MatplotlibCoefficients INFERNO = {
+        {0.00021894036911922, 0.0016510046310010, -0.019480898437091},
+        {0.1065134194856116, 0.5639564367884091, 3.932712388889277},
+        {11.60249308247187, -3.972853965665698, -15.9423941062914},
+        {-41.70399613139459, 17.43639888205313, 44.35414519872813},
+        {77.162935699427, -33.40235894210092, -81.80730925738993},
+        {-71.31942824499214, 32.62606426397723, 73.20951985803202},
+        {25.13112622477341, -12.24266895238567, -23.07032500287172},
+    };
+
+    static constexpr MatplotlibCoefficients MAGMA = {
+        {-0.002136485053939, -0.000749655052795, -0.005386127855323},
+        {0.2516605407371642, 0.6775232436837668, 2.494026599312351},
+        {8.353717279216625, -3.577719514958484, 0.3144679030132573},
+        {-27.66873308576866, 14.26473078096533, -13.64921318813922},
+        {52.17613981234068, -27.94360607168351, 12.94416944238394},
+        {-50.76852536473588, 29.04658282127291, 4.23415299384598},
+        {18.65570506591883, -11.48977351997711, -5.601961508734096},
+    };
+
+    static constexpr MatplotlibCoefficients PLASMA = {
+        {0.05873234392399702, 0.02333670892565664, 0.5433401826748754},
+        {2.176514634195958, 0.2383834171260182, 0.7539604599784036},
+        {-2.689460476458034, -7.455851135738909, 3.110799939717086},
+        {6.130348345893603, 42.3461881477227, -28.51885465332158},
+        {-11.10743619062271, -82.66631109428045, 60.13984767418263},
+        {10.02306557647065, 71.41361770095349, -54.07218655560067},
+        {-3.658713842777788, -22.93153465461149, 18.19190778539828},
+    };
+
+    static constexpr MatplotlibCoefficients VIRIDIS = {
+        {0.2777273272234177, 0.005407344544966578, 0.3340998053353061},
+        {0.1050930431085774, 1.404613529898575, 1.384590162594685},
+        {-0.3308618287255563, 0.214847559468213, 0.09509516302823659},
+        {-4.634230498983486, -5.799100973351585, -19.33244095627987},
+        {6.228269936347081, 14.17993336680509, 56.69055260068105},
+        {4.776384997670288, -13.74514537774601, -65.35303263337234},
+        {-5.435455855934631, 4.645852612178535, 26.3124352495832},
+    };
+
+    /// Converts a color channel in the range 0 to 1 to 8 bits, truncating like the viewer.
+    static uint8_t channel_u8(float value) {
+        const float scaled = value * 255.0f;
+        return scaled > 0.0f ? static_cast<uint8_t>(std::min(scaled, 255.0f)) : 0;
+    }
+
+    static uint32_t pack_rgb(uint8_t r, uint8_t g, uint8_t b) {
+        return (static_cast<uint32_t>(r) << 24) | (static_cast<uint32_t>(g) << 16) |
+               (static_cast<uint32_t>(b) << 8) | 0xFFu;
+    }
+
+    static uint32_t matplotlib_rgba(const MatplotlibCoefficients& coefficients, float t) {
+        float rgb[3];
+        for (size_t c = 0; c < 3; ++c) {
+            float value = static_cast<float>(coefficients[6][c]);
+            for (size_t i = 6; i-- > 0;) {
+                value = static_cast<float>(coefficients[i][c]) + t * value;
+            }
+            rgb[c] = value;
+        }
+        return pack_rgb(channel_u8(rgb[0]), channel_u8(rgb[1]), channel_u8(rgb[2]));
+    }
+
+    // Polynomial approximation in GLSL for the Turbo colormap.
+    // Taken from https://gist.github.com/mikhailov-work/0d177465a8151eb6ede1768d51d476c7.
+    // Original LUT: https://gist.github.com/mikhailov-work/ee72ba4191942acecc03fe6da94fc73f.
+    //
+    // Copyright 2019 Google LLC.
+    // SPDX-License-Identifier: Apache-2.0
+    //
+    // Authors:
+    //   Colormap Design: Anton Mikhailov (mikhailov@google.com)
+    //   GLSL Approximation: Ruofei Du (ruofei@google.com)
+    static uint32_t turbo_rgba(float t) {
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+        const float t4 = t2 * t2;
+        const float t5 = t3 * t2;
+
+        const float r = 0.13572138f + 4.61539260f * t - 42.66032258f * t2 + 132.13108234f * t3 -
+                        152.94239396f * t4 + 59.28637943f * t5;
+        const float g = 0.09140261f + 2.19418839f * t + 4.84296658f * t2 - 14.18503333f * t3 +
+                        4.27729857f * t4 + 2.82956604f * t5;
+        const float b = 0.10667330f + 12.64194608f * t - 60.58204836f * t2 + 110.36276771f * t3 -
+                        89.90310912f * t4 + 27.34824973f * t5;
+        return pack_rgb(channel_u8(r), channel_u8(g), channel_u8(b));
+    }
+
+    static uint32_t evaluate(Colormap colormap, float t) {
+        switch (colormap) {
+            case Colormap::Grayscale: {
+                const auto gray = static_cast<uint8_t>(t * 255.0f + 0.5f);
+                return pack_rgb(gray, gray, gray);
+            }
+            case Colormap::Inferno:
+                return matplotlib_rgba(INFERNO, t);
+            case Colormap::Magma:
+                return matplotlib_rgba(MAGMA, t);
+            case Colormap::Plasma:
+                return matplotlib_rgba(PLASMA, t);
+            case Colormap::Turbo:
+                return turbo_rgba(t);
+            case Colormap::Viridis:
+                return matplotlib_rgba(VIRIDIS, t);
+        }
+        return pack_rgb(0, 0, 0);
+    }
+
+    /// Returns the lookup table of a colormap, sampling it on first use.
+    static const Lut& lut(Colormap colormap) {
+        static const auto luts = [] {
+            std::array<Lut, 6> tables;
+            for (size_t m = 0; m < tables.size(); ++m) {
+                for (size_t i = 0; i < LUT_SIZE; ++i) {
+                    const float t = static_cast<float>(i) / static_cast<float>(LUT_SIZE - 1);
+                    tables[m][i] = evaluate(static_cast<Colormap>(m), t);
+                }
+            }
+            return tables;
+        }();
+        return luts[static_cast<size_t>(colormap)];
+    }
+
+    /// Maps values to lookup table indices.
+    struct Normalization {
+        float offset;
+        float scale;
+
+        explicit Normalization(Range range)
+            : offset(range.min),
+              scale(
+                  range.max > range.min ? static_cast<float>(LUT_SIZE - 1) / (range.max - range.min)
+                                        : 0.0f
+              ) {}
+
+        size_t index(float value) const {
+            // Written so that NaN fails the comparison.
+            const float scaled = (value - offset) * scale + 0.5f;
+            return scaled > 0.0f
+                       ? static_cast<size_t>(std::min(scaled, static_cast<float>(LUT_SIZE - 1)))
+                       : 0;
+        }
+    };
+
+    template <typename TValue>
+    static void apply_lut(
+        const Lut& table, const TValue* values, size_t num_values, Range range,
+        components::Color* colors
+    ) {
+        const Normalization normalization(range);
+        for (size_t i = 0; i < num_values; ++i) {
+            colors[i] = table[normalization.index(static_cast<float>(values[i]))];
+        }
+    }
+
+    template <typename TValue>
+    static void apply_lut_rgb(
+        const Lut& table, const TValue* values, size_t num_values, Range range, uint8_t* rgb
+    ) {
+        const Normalization normalization(range);
+        for (size_t i = 0; i < num_values; ++i) {
+            const uint32_t rgba = table[normalization.index(static_cast<float>(values[i]))];
+            rgb[i * 3 + 0] = static_cast<uint8_t>(rgba >> 24);
+            rgb[i * 3 + 1] = static_cast<uint8_t>(rgba >> 16);
+            rgb[i * 3 + 2] = static_cast<uint8_t>(rgba >> 8);
+        }
+    }
+
+    Range value_range(const float* values, size_t num_values) {
+        float min = INFINITY;
+        float max = -INFINITY;
+        for (size_t i = 0; i < num_values; ++i) {
+            if (std::isfinite(values[i])) {
+                min = std::min(min, values[i]);
+                max = std::max(max, values[i]);
+            }
+        }
+        return min <= max ? Range{min, max} : Range{0.0f, 1.0f};
+    }
+
+    Range value_range(const uint16_t* values, size_t num_values) {
+        if (num_values == 0) {
+            return Range{0.0f, 1.0f};
+        }
+        const auto [min, max] = std::minmax_element(values, values + num_values);
+        return Range{static_cast<float>(*min), static_cast<float>(*max)};
+    }
+
+    components::Color color(Colormap colormap, float t) {
+        return lut(colormap)[Normalization(Range{0.0f, 1.0f}).index(t)];
+    }
+
+    void apply(
+        Colormap colormap, const float* values, size_t num_values, Range range,
+        components::Color* colors
+    ) {
+        apply_lut(lut(colormap), values, num_values, range, colors);
+    }
+
+    void apply(
+        Colormap colormap, const uint16_t* values, size_t num_values, Range range,
+        components::Color* colors
+    ) {
+        apply_lut(lut(colormap), values, num_values, range, colors);
+    }
+
+    template <typename TValue>
+    static Collection<components::Color> colorize_values(
+        Colormap colormap, const TValue* values, size_t num_values, std::optional<Range> range
+    ) {
+        auto colors = detail::allocate_shared_array<components::Color>(num_values);
+        apply(
+            colormap,
+            values,
+            num_values,
+            range ? *range : value_range(values, num_values),
+            colors.get()
+        );
+        return Collection<components::Color>::share(std::move(colors), num_values);
+    }
+
+    Collection<components::Color> colorize(
+        Colormap colormap, const float* values, size_t num_values, std::optional<Range> range
+    ) {
+        return colorize_values(colormap, values, num_values, range);
+    }
+
+    Collection<components::Color> colorize(
+        Colormap colormap, const uint16_t* values, size_t num_values, std::optional<Range> range
+    ) {
+        return colorize_values(colormap, values, num_values, range);
+    }
+
+    template <typename TValue>
+    static archetypes::Image colorize_image_values(
+        Colormap colormap, const TValue* values, size_t width, size_t height,
+        std::optional<Range> range
+    ) {
+        const size_t num_values = width * height;
+        auto rgb = detail::allocate_shared_array<uint8_t>(num_values * 3);
+        apply_lut_rgb(
+            lut(colormap),
+            values,
+            num_values,
+            range ? *range : value_range(values, num_values),
+            rgb.get()
+        );
+        return archetypes::Image(
+            {height, width, 3},
+            datatypes::TensorBuffer::u8(Collection<uint8_t>::share(std::move(rgb), num_values * 3))
+        );
+    }
+
+    archetypes::Image colorize_image(
+        Colormap colormap, const float* values, size_t width, size_t height,
+        std::optional<Range> range
+    ) {
+        return colorize_image_values(colormap, values, width, height, range);
+    }
+
+    archetypes::Image colorize_image(
+        Colormap colormap, const uint16_t* values, size_t width, size_t height,
+        std::optional<Range> range
+    ) {
+        return colorize_image_values(colormap, values, width, height, range);
+    }
+} // namespace rerun::colormap
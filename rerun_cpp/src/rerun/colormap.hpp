@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "archetypes/image.hpp"
+#include "collection.hpp"
+#include "components/color.hpp"
+
+namespace rerun {
+    /// Colormaps for mapping scalar values to colors.
+    ///
+    /// Same colormaps as the viewer uses, e.g. for depth images.
+    enum class Colormap {
+        /// sRGB gray gradient, which is perceptually even.
+        Grayscale,
+
+        Inferno,
+        Magma,
+        Plasma,
+        Turbo,
+        Viridis,
+    };
+
+    /// Colorizing scalar values like height, intensity or depth with a `Colormap`.
+    ///
+    /// Each colormap is sampled into a lookup table of 256 colors once, so that colorizing
+    /// boils down to normalizing the value and a table lookup.
+    /// This is much faster than evaluating the colormap for every value, as
+    /// `rerun::demo::colormap_turbo_srgb` does:
+    /// ```
+    /// rec.log(
+    ///     "points",
+    ///     rerun::Points3D(positions)
+    ///         .with_colors(rerun::colormap::colorize(rerun::Colormap::Turbo, heights.data(), n))
+    /// );
+    /// ```
+    namespace colormap {
+        /// Range of values that is mapped to the whole colormap.
+        ///
+        /// Values outside of the range are clamped to the first and last color respectively.
+        struct Range {
+            float min;
+            float max;
+        };
+
+        /// Returns the range of all finite values.
+        ///
+        /// Returns `{0, 1}` if there are no finite values.
+        Range value_range(const float* values, size_t num_values);
+
+        /// Returns the range of all values.
+        ///
+        /// Returns `{0, 1}` if there are no values.
+        Range value_range(const uint16_t* values, size_t num_values);
+
+        /// Returns the color of `t`, normalized to the range 0 to 1.
+        components::Color color(Colormap colormap, float t);
+
+        /// Writes the colors of `num_values` values to `colors`.
+        ///
+        /// NaN values get the first color of the colormap.
+        void apply(
+            Colormap colormap, const float* values, size_t num_values, Range range,
+            components::Color* colors
+        );
+
+        /// Writes the colors of `num_values` values to `colors`.
+        void apply(
+            Colormap colormap, const uint16_t* values, size_t num_values, Range range,
+            components::Color* colors
+        );
+
+        /// Returns the colors of `num_values` values, ready to be used as a component batch.
+        ///
+        /// \param range Range of values mapped to the colormap, uses the range of all finite
+        /// values if not set.
+        Collection<components::Color> colorize(
+            Colormap colormap, const float* values, size_t num_values,
+            std::optional<Range> range = std::nullopt
+        );
+
+        /// \copydoc colorize
+        Collection<components::Color> colorize(
+            Colormap colormap, const uint16_t* values, size_t num_values,
+            std::optional<Range> range = std::nullopt
+        );
+
+        /// Creates an RGB image from a single channel image, e.g. for viewing depth or
+        /// intensity images with a custom colormap.
+        ///
+        /// \param range Range of values mapped to the colormap, uses the range of all finite
+        /// values if not set.
+        archetypes::Image colorize_image(
+            Colormap colormap, const float* values, size_t width, size_t height,
+            std::optional<Range> range = std::nullopt
+        );
+
+        /// \copydoc colorize_image
+        archetypes::Image colorize_image(
+            Colormap colormap, const uint16_t* values, size_t width, size_t height,
+            std::optional<Range> range = std::nullopt
+        );
+    } // namespace colormap
+} // namespace rerun
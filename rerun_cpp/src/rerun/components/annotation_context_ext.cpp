@@ -26,13 +26,13 @@ namespace rerun::components {
             std::is_constructible_v<datatypes::ClassDescriptionMapElem, TElement>> //
         >
     AnnotationContext(std::initializer_list<TElement> class_descriptions) {
-        std::vector<datatypes::ClassDescriptionMapElem> class_map_new;
-        class_map_new.reserve(class_descriptions.size());
-        for (const auto& class_description : class_descriptions) {
-            class_map_new.emplace_back(std::move(class_description));
-        }
-        class_map = Collection<datatypes::ClassDescriptionMapElem>::take_ownership(
-            std::move(class_map_new)
+        class_map = Collection<datatypes::ClassDescriptionMapElem>::build(
+            class_descriptions.size(),
+            [&](auto& class_map_new) {
+                for (const auto& class_description : class_descriptions) {
+                    class_map_new.emplace_back(std::move(class_description));
+                }
+            }
         );
     }
 
@@ -1,6 +1,10 @@
 #pragma once
 #include <atomic>
 
+/// Set to `0` to remove `RERUN_LOG` and `RecordingStream::log_lazy` calls at compile time.
+///
+/// Only affects macros and templates instantiated in user code, so the SDK library and user code
+/// may be compiled with different values.
 #ifndef RERUN_ENABLED
 #define RERUN_ENABLED 1
 #endif
@@ -0,0 +1,102 @@
+#include "entity_path_filter.hpp"
+
+namespace rerun {
+    /// Pops the next non-empty part of an entity path, returns an empty string if there is none.
+    static std::string_view next_path_part(std::string_view& path) {
+        while (!path.empty() && path.front() == '/') {
+            path.remove_prefix(1);
+        }
+        const auto end = path.find('/');
+        const auto part = path.substr(0, end);
+        path.remove_prefix(part.size());
+        return part;
+    }
+
+    static std::string_view trim_whitespace(std::string_view str) {
+        const auto first = str.find_first_not_of(" \t\r");
+        if (first == std::string_view::npos) {
+            return {};
+        }
+        const auto last = str.find_last_not_of(" \t\r");
+        return str.substr(first, last - first + 1);
+    }
+
+    Result<EntityPathPattern> EntityPathPattern::parse(std::string_view pattern) {
+        EntityPathPattern result;
+
+        auto remaining = pattern;
+        for (auto part = next_path_part(remaining); !part.empty();
+             part = next_path_part(remaining)) {
+            if (result._recursive) {
+                return Error(
+                    ErrorCode::InvalidEntityPathFilter,
+                    "'**' may only appear at the end of an entity path pattern, got '" +
+                        std::string(pattern) + "'."
+                );
+            }
+            if (part == "**") {
+                result._recursive = true;
+            } else if (part != "*" && part.find('*') != std::string_view::npos) {
+                return Error(
+                    ErrorCode::InvalidEntityPathFilter,
+                    "Wildcards in entity path patterns have to span an entire path part, got '" +
+                        std::string(pattern) + "'."
+                );
+            } else {
+                result._parts.emplace_back(part);
+            }
+        }
+
+        return result;
+    }
+
+    bool EntityPathPattern::matches(std::string_view entity_path) const {
+        for (const auto& part : _parts) {
+            const auto path_part = next_path_part(entity_path);
+            if (path_part.empty() || (part != "*" && part != path_part)) {
+                return false;
+            }
+        }
+        return _recursive || next_path_part(entity_path).empty();
+    }
+
+    Result<EntityPathFilter> EntityPathFilter::parse(std::string_view rules) {
+        EntityPathFilter filter;
+
+        while (!rules.empty()) {
+            const auto rule_end = rules.find_first_of(",\n");
+            auto rule_str = trim_whitespace(rules.substr(0, rule_end));
+            rules.remove_prefix(rule_end == std::string_view::npos ? rules.size() : rule_end + 1);
+            if (rule_str.empty()) {
+                continue;
+            }
+
+            const bool include = rule_str.front() != '-';
+            if (rule_str.front() == '+' || rule_str.front() == '-') {
+                rule_str = trim_whitespace(rule_str.substr(1));
+            }
+            if (rule_str.empty()) {
+                return Error(
+                    ErrorCode::InvalidEntityPathFilter,
+                    "Entity path filter rule has no path pattern."
+                );
+            }
+
+            auto pattern = EntityPathPattern::parse(rule_str);
+            RR_RETURN_NOT_OK(pattern.error);
+            filter._rules.push_back({include, std::move(pattern.value)});
+        }
+
+        return filter;
+    }
+
+    bool EntityPathFilter::is_included(std::string_view entity_path) const {
+        // Later rules take precedence, so look for the last rule that matches.
+        for (auto rule = _rules.rbegin(); rule != _rules.rend(); ++rule) {
+            if (rule->pattern.matches(entity_path)) {
+                return rule->include;
+            }
+        }
+        return true;
+    }
+} // namespace rerun
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "result.hpp"
+
+namespace rerun {
+    /// A pattern matching entity paths.
+    ///
+    /// - `*` matches any single path part, e.g. `world/*/points`.
+    /// - A trailing `**` matches the path before it and everything below it, e.g. `world/debug/**`.
+    ///   A pattern of only `**` matches every path.
+    ///
+    /// Leading and trailing slashes are ignored, both in patterns and in matched entity paths.
+    class EntityPathPattern {
+      public:
+        /// Creates a pattern that only matches the root path.
+        EntityPathPattern() = default;
+
+        /// Parses a pattern.
+        ///
+        /// Returns `ErrorCode::InvalidEntityPathFilter` if the pattern is malformed.
+        static Result<EntityPathPattern> parse(std::string_view pattern);
+
+        /// Returns whether the given entity path matches this pattern.
+        bool matches(std::string_view entity_path) const;
+
+      private:
+        /// Path parts to match, `*` matches any part.
+        std::vector<std::string> _parts;
+
+        /// Whether the pattern ended with `**`.
+        bool _recursive = false;
+    };
+
+    /// A set of rules deciding which entity paths are logged by a `RecordingStream`.
+    ///
+    /// Rules are separated by newlines or `,`. Each rule is an `EntityPathPattern`, optionally
+    /// prefixed with `+` (include, the default) or `-` (exclude):
+    /// ```
+    /// - world/debug/**
+    /// + world/debug/important
+    /// ```
+    ///
+    /// The last rule that matches an entity path decides whether it is logged.
+    /// Entity paths that match no rule at all are logged, so an empty filter logs everything.
+    ///
+    /// \see RecordingStream::set_entity_path_filter
+    class EntityPathFilter {
+      public:
+        /// Creates an empty filter which doesn't filter out any entity path.
+        EntityPathFilter() = default;
+
+        /// Parses a filter from a list of rules.
+        ///
+        /// Returns `ErrorCode::InvalidEntityPathFilter` if any of the rules is malformed.
+        static Result<EntityPathFilter> parse(std::string_view rules);
+
+        /// Returns true if the filter has no rules.
+        bool empty() const {
+            return _rules.empty();
+        }
+
+        /// Returns whether data logged to the given entity path passes the filter.
+        ///
+        /// This evaluates all rules, `RecordingStream` caches the result per entity path.
+        bool is_included(std::string_view entity_path) const;
+
+      private:
+        struct Rule {
+            bool include;
+            EntityPathPattern pattern;
+        };
+
+        std::vector<Rule> _rules;
+    };
+} // namespace rerun
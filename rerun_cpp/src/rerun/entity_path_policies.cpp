@@ -0,0 +1,665 @@
+#include "entity_path_policies.hpp"
+#include "components/scalar.hpp"
+#include "data_cell.hpp"
+
+#include <arrow/array/array_base.h>
+#include <arrow/array/data.h>
+#include <arrow/buffer.h>
+#include <arrow/type.h>
+#include <arrow/util/bit_util.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib> // getenv
+#include <functional>
+#include <iterator>
+#include <optional>
+
+namespace rerun {
+    namespace detail {
+        /// Don't let programs that log to ever new entity paths grow the cache unbounded.
+        static constexpr size_t MAX_CACHED_ENTITY_PATHS = 16 * 1024;
+
+        static constexpr double MAX_RATE_LIMIT_PERIOD_NS = 100.0 * 365.0 * 24.0 * 3600.0 * 1.0e9;
+
+        static uint64_t hash_combine(uint64_t seed, uint64_t value) {
+            return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+        }
+
+        static uint64_t hash_bytes(const uint8_t* bytes, int64_t num_bytes) {
+            return std::hash<std::string_view>()(std::string_view(
+                reinterpret_cast<const char*>(bytes),
+                static_cast<size_t>(num_bytes)
+            ));
+        }
+
+        static uint64_t hash_bits(const uint8_t* bits, int64_t start, int64_t length) {
+            uint64_t hash = 0;
+            uint64_t word = 0;
+            for (int64_t i = 0; i < length; ++i) {
+                const bool bit = arrow::bit_util::GetBit(bits, static_cast<uint64_t>(start + i));
+                word = (word << 1) | static_cast<uint64_t>(bit);
+                if (i % 64 == 63) {
+                    hash = hash_combine(hash, word);
+                    word = 0;
+                }
+            }
+            return hash_combine(hash, word);
+        }
+
+        static std::optional<uint64_t> hash_array_values(
+            const arrow::ArrayData& data, int64_t offset, int64_t length
+        );
+
+        /// Hashes the lengths of `length` list or binary elements, given their first offset.
+        template <typename TOffset>
+        static uint64_t hash_lengths(const TOffset* offsets, int64_t length) {
+            uint64_t hash = 0;
+            for (int64_t i = 0; i < length; ++i) {
+                hash = hash_combine(hash, static_cast<uint64_t>(offsets[i + 1] - offsets[i]));
+            }
+            return hash;
+        }
+
+        template <typename TOffset>
+        static uint64_t hash_binary_values(
+            const arrow::ArrayData& data, int64_t start, int64_t length
+        ) {
+            const auto* offsets = data.GetValues<TOffset>(1, start);
+            const uint8_t* bytes = data.buffers[2]->data() + offsets[0];
+            const auto num_bytes = static_cast<int64_t>(offsets[length] - offsets[0]);
+            return hash_combine(hash_lengths(offsets, length), hash_bytes(bytes, num_bytes));
+        }
+
+        template <typename TOffset>
+        static std::optional<uint64_t> hash_list_values(
+            const arrow::ArrayData& data, int64_t start, int64_t length
+        ) {
+            const auto* offsets = data.GetValues<TOffset>(1, start);
+            const auto values_hash = hash_array_values(
+                *data.child_data[0],
+                static_cast<int64_t>(offsets[0]),
+                static_cast<int64_t>(offsets[length] - offsets[0])
+            );
+            if (!values_hash.has_value()) {
+                return std::nullopt;
+            }
+            return hash_combine(hash_lengths(offsets, length), *values_hash);
+        }
+
+        /// Hashes all children of a struct or sparse union for the same elements as the parent.
+        static std::optional<uint64_t> hash_children_values(
+            const arrow::ArrayData& data, int64_t start, int64_t length
+        ) {
+            uint64_t hash = 0;
+            for (const auto& child : data.child_data) {
+                const auto child_hash = hash_array_values(*child, start, length);
+                if (!child_hash.has_value()) {
+                    return std::nullopt;
+                }
+                hash = hash_combine(hash, *child_hash);
+            }
+            return hash;
+        }
+
+        static std::optional<uint64_t> hash_dense_union_values(
+            const arrow::ArrayData& data, int64_t start, int64_t length
+        ) {
+            const auto& child_ids = static_cast<const arrow::UnionType&>(*data.type).child_ids();
+            const auto* type_codes = data.GetValues<int8_t>(1, start);
+            const auto* offsets = data.GetValues<int32_t>(2, start);
+
+            uint64_t hash = 0;
+            for (int64_t i = 0; i < length; ++i) {
+                const auto child_id = child_ids[static_cast<size_t>(type_codes[i])];
+                const auto& child = *data.child_data[static_cast<size_t>(child_id)];
+                const auto child_hash = hash_array_values(child, offsets[i], 1);
+                if (!child_hash.has_value()) {
+                    return std::nullopt;
+                }
+                hash = hash_combine(hash, static_cast<uint64_t>(child_id));
+                hash = hash_combine(hash, *child_hash);
+            }
+            return hash;
+        }
+
+        static std::optional<uint64_t> hash_fixed_width_values(
+            const arrow::ArrayData& data, int64_t start, int64_t length
+        ) {
+            const auto* type = dynamic_cast<const arrow::FixedWidthType*>(data.type.get());
+            if (type == nullptr || type->bit_width() % 8 != 0) {
+                return std::nullopt;
+            }
+            const int64_t byte_width = type->bit_width() / 8;
+            return hash_bytes(data.buffers[1]->data() + start * byte_width, length * byte_width);
+        }
+
+        /// Hashes the values of `length` elements of an array, starting at `offset` relative to
+        /// the array's own offset.
+        ///
+        /// Only covers the logical values, not padding or data outside of the array's slice.
+        /// Values under nulls are hashed as well, so equal arrays that differ in there don't hash
+        /// the same.
+        /// \returns Nothing if the array's type isn't supported.
+        static std::optional<uint64_t> hash_array_values(
+            const arrow::ArrayData& data, int64_t offset, int64_t length
+        ) {
+            const auto type_id = data.type->id();
+            uint64_t hash =
+                hash_combine(static_cast<uint64_t>(type_id), static_cast<uint64_t>(length));
+            if (length == 0) {
+                return hash;
+            }
+
+            const int64_t start = data.offset + offset;
+            if (!data.buffers.empty() && data.buffers[0] != nullptr) {
+                hash = hash_combine(hash, hash_bits(data.buffers[0]->data(), start, length));
+            }
+
+            if (type_id == arrow::Type::NA) {
+                return hash;
+            }
+
+            // Not a switch, which would have to list all other types.
+            std::optional<uint64_t> values_hash;
+            if (type_id == arrow::Type::BOOL) {
+                values_hash = hash_bits(data.buffers[1]->data(), start, length);
+            } else if (type_id == arrow::Type::STRING || type_id == arrow::Type::BINARY) {
+                values_hash = hash_binary_values<int32_t>(data, start, length);
+            } else if (type_id == arrow::Type::LARGE_STRING ||
+                       type_id == arrow::Type::LARGE_BINARY) {
+                values_hash = hash_binary_values<int64_t>(data, start, length);
+            } else if (type_id == arrow::Type::LIST || type_id == arrow::Type::MAP) {
+                values_hash = hash_list_values<int32_t>(data, start, length);
+            } else if (type_id == arrow::Type::LARGE_LIST) {
+                values_hash = hash_list_values<int64_t>(data, start, length);
+            } else if (type_id == arrow::Type::FIXED_SIZE_LIST) {
+                const int64_t list_size =
+                    static_cast<const arrow::FixedSizeListType&>(*data.type).list_size();
+                values_hash =
+                    hash_array_values(*data.child_data[0], start * list_size, length * list_size);
+            } else if (type_id == arrow::Type::STRUCT) {
+                values_hash = hash_children_values(data, start, length);
+            } else if (type_id == arrow::Type::SPARSE_UNION) {
+                const auto children_hash = hash_children_values(data, start, length);
+                if (children_hash.has_value()) {
+                    const uint64_t type_codes_hash =
+                        hash_bytes(data.GetValues<uint8_t>(1, start), length);
+                    values_hash = hash_combine(type_codes_hash, *children_hash);
+                }
+            } else if (type_id == arrow::Type::DENSE_UNION) {
+                values_hash = hash_dense_union_values(data, start, length);
+            } else if (type_id != arrow::Type::DICTIONARY && type_id != arrow::Type::EXTENSION) {
+                values_hash = hash_fixed_width_values(data, start, length);
+            }
+
+            if (!values_hash.has_value()) {
+                return std::nullopt;
+            }
+            return hash_combine(hash, *values_hash);
+        }
+
+        static int64_t steady_clock_now_ns() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch()
+            )
+                .count();
+        }
+
+        EntityPathPolicies::EntityPathPolicies() {
+            const char* rules = std::getenv("RERUN_ENTITY_PATH_FILTER");
+            if (rules != nullptr) {
+                auto filter = EntityPathFilter::parse(rules);
+                filter.error.handle();
+                set_filter(std::move(filter.value));
+            }
+        }
+
+        void EntityPathPolicies::set_filter(EntityPathFilter filter) {
+            std::unique_lock lock(_mutex);
+            _filter = std::move(filter);
+            clear_cache();
+        }
+
+        void EntityPathPolicies::set_rate_limit(
+            std::string_view pattern_str, EntityPathPattern pattern, double max_rate_hz,
+            RateLimitMode mode
+        ) {
+            std::unique_lock lock(_mutex);
+
+            RateLimitRule* rule = nullptr;
+            for (auto& existing_rule : _rate_limits) {
+                if (existing_rule->pattern_str == pattern_str) {
+                    rule = existing_rule.get();
+                }
+            }
+            if (rule == nullptr) {
+                _rate_limits.emplace_back(std::make_unique<RateLimitRule>());
+                rule = _rate_limits.back().get();
+                rule->pattern_str = pattern_str;
+            }
+
+            rule->pattern = std::move(pattern);
+            // Clamped to a century, such that it fits into 64 bit for any positive rate.
+            rule->period_ns =
+                std::llround(std::clamp(1.0e9 / max_rate_hz, 1.0, MAX_RATE_LIMIT_PERIOD_NS));
+            rule->max_rate_hz = max_rate_hz;
+            rule->mode = mode;
+
+            // Cached rate limiters may point to a now changed rule.
+            clear_cache();
+        }
+
+        void EntityPathPolicies::clear_rate_limits() {
+            std::unique_lock lock(_mutex);
+            _rate_limits.clear();
+            clear_cache();
+        }
+
+        std::vector<RateLimitStats> EntityPathPolicies::rate_limit_stats() const {
+            std::shared_lock lock(_mutex);
+
+            std::vector<RateLimitStats> stats;
+            stats.reserve(_rate_limits.size());
+            for (const auto& rule : _rate_limits) {
+                stats.push_back(RateLimitStats{
+                    rule->pattern_str,
+                    rule->max_rate_hz,
+                    rule->mode,
+                    rule->num_logged.load(std::memory_order_relaxed),
+                    rule->num_suppressed.load(std::memory_order_relaxed),
+                });
+            }
+            return stats;
+        }
+
+        void EntityPathPolicies::enable_change_detection(EntityPathPattern pattern) {
+            std::unique_lock lock(_mutex);
+            _change_detection_patterns.emplace_back(std::move(pattern));
+            clear_cache();
+        }
+
+        void EntityPathPolicies::disable_change_detection() {
+            std::unique_lock lock(_mutex);
+            _change_detection_patterns.clear();
+            clear_cache();
+            // Only the cache pointed to the change detectors.
+            _change_detectors.clear();
+        }
+
+        /// Whether `path` is `ancestor` or one of its descendants.
+        static bool is_descendant_or_self(std::string_view path, std::string_view ancestor) {
+            while (!ancestor.empty() && ancestor.back() == '/') {
+                ancestor.remove_suffix(1);
+            }
+            if (ancestor.empty()) {
+                return true;
+            }
+            return path.substr(0, ancestor.size()) == ancestor &&
+                   (path.size() == ancestor.size() || path[ancestor.size()] == '/');
+        }
+
+        void EntityPathPolicies::reset_change_detection(
+            std::string_view entity_path, bool recursive
+        ) {
+            std::unique_lock lock(_mutex);
+            for (auto& [path, change_detector] : _change_detectors) {
+                if (recursive ? is_descendant_or_self(path, entity_path) : path == entity_path) {
+                    change_detector->last_batches.clear();
+                }
+            }
+        }
+
+        void EntityPathPolicies::enable_previews(
+            EntityPathPattern pattern, size_t factor, image::DepthDownscaleMode depth_mode
+        ) {
+            std::unique_lock lock(_mutex);
+            _previews.push_back(PreviewRule{std::move(pattern), factor, depth_mode, 0.0f, 0, {}});
+            clear_cache();
+        }
+
+        void EntityPathPolicies::enable_point_cloud_previews(
+            EntityPathPattern pattern, float voxel_size
+        ) {
+            std::unique_lock lock(_mutex);
+            _previews.push_back(PreviewRule{
+                std::move(pattern),
+                0,
+                image::DepthDownscaleMode::Nearest,
+                voxel_size,
+                0,
+                {},
+            });
+            clear_cache();
+        }
+
+        void EntityPathPolicies::enable_scalar_previews(
+            EntityPathPattern pattern, size_t window_size
+        ) {
+            std::unique_lock lock(_mutex);
+            _previews.push_back(PreviewRule{
+                std::move(pattern),
+                0,
+                image::DepthDownscaleMode::Nearest,
+                0.0f,
+                window_size,
+                {},
+            });
+            clear_cache();
+        }
+
+        void EntityPathPolicies::disable_previews() {
+            std::unique_lock lock(_mutex);
+            _previews.clear();
+            clear_cache();
+        }
+
+        bool EntityPathPolicies::is_included(std::string_view entity_path) {
+            if (!_is_active.load(std::memory_order_acquire)) {
+                return true;
+            }
+            return with_cached_policy(entity_path, [](const CachedPolicy& policy) {
+                return policy.included;
+            });
+        }
+
+        bool EntityPathPolicies::admit(std::string_view entity_path) {
+            if (!_is_active.load(std::memory_order_acquire)) {
+                return true;
+            }
+            // Rate limiters are only ever destroyed under a unique lock, so it is safe to use
+            // them while holding a shared lock.
+            return with_cached_policy(entity_path, admit_cached);
+        }
+
+        bool EntityPathPolicies::remove_unchanged_batches(
+            std::string_view entity_path, bool timeless, std::vector<DataCell>& instanced,
+            std::vector<DataCell>& splatted
+        ) {
+            if (!_is_active.load(std::memory_order_acquire)) {
+                return false;
+            }
+            return with_cached_policy(entity_path, [&](const CachedPolicy& policy) {
+                if (policy.change_detector == nullptr) {
+                    return false;
+                }
+                // Like rate limiters, change detectors are only ever destroyed under a unique lock.
+                std::lock_guard lock(policy.change_detector->mutex);
+                const bool removed_instanced =
+                    policy.change_detector->remove_unchanged(instanced, timeless, false);
+                const bool removed_splatted =
+                    policy.change_detector->remove_unchanged(splatted, timeless, true);
+                return removed_instanced || removed_splatted;
+            });
+        }
+
+        size_t EntityPathPolicies::preview_factor(std::string_view entity_path) {
+            if (!_is_active.load(std::memory_order_acquire)) {
+                return 0;
+            }
+            return with_cached_policy(entity_path, [](const CachedPolicy& policy) {
+                return policy.preview_factor;
+            });
+        }
+
+        image::DepthDownscaleMode EntityPathPolicies::preview_depth_mode(
+            std::string_view entity_path
+        ) {
+            if (!_is_active.load(std::memory_order_acquire)) {
+                return image::DepthDownscaleMode::Nearest;
+            }
+            return with_cached_policy(entity_path, [](const CachedPolicy& policy) {
+                return policy.preview_depth_mode;
+            });
+        }
+
+        float EntityPathPolicies::preview_voxel_size(std::string_view entity_path) {
+            if (!_is_active.load(std::memory_order_acquire)) {
+                return 0.0f;
+            }
+            return with_cached_policy(entity_path, [](const CachedPolicy& policy) {
+                return policy.preview_voxel_size;
+            });
+        }
+
+        std::optional<series::MinMax> EntityPathPolicies::add_preview_scalar(
+            std::string_view entity_path, double value
+        ) {
+            if (!_is_active.load(std::memory_order_acquire)) {
+                return std::nullopt;
+            }
+            // Like rate limiters, scalar previews are only ever destroyed under a unique lock.
+            return with_cached_policy(
+                entity_path,
+                [&](const CachedPolicy& policy) -> std::optional<series::MinMax> {
+                    if (policy.scalar_preview == nullptr) {
+                        return std::nullopt;
+                    }
+                    std::lock_guard lock(policy.scalar_preview->mutex);
+                    return policy.scalar_preview->window.add(value);
+                }
+            );
+        }
+
+        std::vector<std::pair<size_t, series::MinMax>> EntityPathPolicies::add_preview_scalars(
+            std::string_view entity_path, const components::Scalar* values, size_t num_values
+        ) {
+            std::vector<std::pair<size_t, series::MinMax>> windows;
+            if (!_is_active.load(std::memory_order_acquire)) {
+                return windows;
+            }
+            // See `add_preview_scalar`.
+            with_cached_policy(entity_path, [&](const CachedPolicy& policy) {
+                if (policy.scalar_preview == nullptr) {
+                    return;
+                }
+                std::lock_guard lock(policy.scalar_preview->mutex);
+                for (size_t i = 0; i < num_values; ++i) {
+                    const auto min_max = policy.scalar_preview->window.add(values[i].value);
+                    if (min_max.has_value()) {
+                        windows.emplace_back(i, *min_max);
+                    }
+                }
+            });
+            return windows;
+        }
+
+        bool EntityPathPolicies::admit_cached(const CachedPolicy& policy) {
+            if (!policy.included) {
+                return false;
+            }
+            if (policy.rate_limiter == nullptr) {
+                return true;
+            }
+            return policy.rate_limiter->admit(steady_clock_now_ns());
+        }
+
+        const EntityPathPolicies::CachedPolicy& EntityPathPolicies::insert_into_cache(
+            std::string_view entity_path
+        ) {
+            // Another thread may have inserted the path while we waited for the lock.
+            const auto it = _cache.find(entity_path);
+            if (it != _cache.end()) {
+                return it->second;
+            }
+
+            if (_cache.size() >= MAX_CACHED_ENTITY_PATHS) {
+                clear_cache();
+            }
+
+            CachedPolicy policy;
+            policy.included = _filter.is_included(entity_path);
+            if (policy.included) {
+                // Later rate limits take precedence.
+                for (auto rule = _rate_limits.rbegin(); rule != _rate_limits.rend(); ++rule) {
+                    if ((*rule)->pattern.matches(entity_path)) {
+                        auto& limiter = (*rule)->limiters[std::string(entity_path)];
+                        if (limiter == nullptr) {
+                            limiter = std::make_unique<RateLimiter>();
+                            limiter->rule = rule->get();
+                        }
+                        policy.rate_limiter = limiter.get();
+                        break;
+                    }
+                }
+                for (const auto& pattern : _change_detection_patterns) {
+                    if (pattern.matches(entity_path)) {
+                        auto& change_detector = _change_detectors[std::string(entity_path)];
+                        if (change_detector == nullptr) {
+                            change_detector = std::make_unique<ChangeDetector>();
+                        }
+                        policy.change_detector = change_detector.get();
+                        break;
+                    }
+                }
+                // Later previews take precedence.
+                for (auto rule = _previews.rbegin(); rule != _previews.rend(); ++rule) {
+                    if (!rule->pattern.matches(entity_path)) {
+                        continue;
+                    }
+                    if (policy.preview_factor == 0 && rule->factor != 0) {
+                        policy.preview_factor = rule->factor;
+                        policy.preview_depth_mode = rule->depth_mode;
+                    }
+                    if (policy.preview_voxel_size == 0.0f) {
+                        policy.preview_voxel_size = rule->voxel_size;
+                    }
+                    if (policy.scalar_preview == nullptr && rule->scalar_window_size != 0) {
+                        auto& scalar_preview = rule->scalar_previews[std::string(entity_path)];
+                        if (scalar_preview == nullptr) {
+                            scalar_preview =
+                                std::make_unique<ScalarPreview>(rule->scalar_window_size);
+                        }
+                        policy.scalar_preview = scalar_preview.get();
+                    }
+                }
+            }
+
+            _interned_paths.emplace_back(entity_path);
+            return _cache.emplace(_interned_paths.back(), std::move(policy)).first->second;
+        }
+
+        void EntityPathPolicies::clear_cache() {
+            _cache.clear();
+            _interned_paths.clear();
+
+            // With the cache cleared, nothing points to the rate limiters, change detectors and
+            // scalar preview windows anymore.
+            const int64_t now_ns = steady_clock_now_ns();
+            for (auto& rule : _rate_limits) {
+                if (rule->limiters.size() < MAX_CACHED_ENTITY_PATHS) {
+                    continue;
+                }
+                for (auto it = rule->limiters.begin(); it != rule->limiters.end();) {
+                    it = it->second->is_idle(now_ns) ? rule->limiters.erase(it) : std::next(it);
+                }
+            }
+            if (_change_detectors.size() >= MAX_CACHED_ENTITY_PATHS) {
+                // Only makes the next batches of each entity get logged again.
+                _change_detectors.clear();
+            }
+            for (auto& rule : _previews) {
+                // Only loses the scalars of incomplete windows.
+                if (rule.scalar_previews.size() >= MAX_CACHED_ENTITY_PATHS) {
+                    rule.scalar_previews.clear();
+                }
+            }
+
+            _is_active.store(
+                !_filter.empty() || !_rate_limits.empty() || !_change_detection_patterns.empty() ||
+                    !_previews.empty(),
+                std::memory_order_release
+            );
+        }
+
+        bool EntityPathPolicies::RateLimiter::admit(int64_t now_ns) {
+            std::lock_guard lock(mutex);
+
+            const int64_t period = now_ns / rule->period_ns;
+            bool keep = false;
+
+            switch (rule->mode) {
+                case RateLimitMode::KeepFirst:
+                    keep = period != last_logged_period;
+                    break;
+
+                case RateLimitMode::KeepLatest: {
+                    if (last_call_ns != 0) {
+                        // Exponential moving average of the interval between calls.
+                        const int64_t interval_ns = now_ns - last_call_ns;
+                        avg_interval_ns =
+                            avg_interval_ns == 0
+                                ? interval_ns
+                                : avg_interval_ns + (interval_ns - avg_interval_ns) / 8;
+                    }
+                    last_call_ns = now_ns;
+
+                    // Keep this call if the next one is expected to fall into the next period.
+                    const bool is_last_of_period =
+                        avg_interval_ns == 0 ||
+                        (now_ns + avg_interval_ns) / rule->period_ns != period;
+                    const bool missed_period = period > last_logged_period + 1;
+                    keep = period != last_logged_period && (is_last_of_period || missed_period);
+                    break;
+                }
+            }
+
+            if (keep) {
+                last_logged_period = period;
+                rule->num_logged.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                rule->num_suppressed.fetch_add(1, std::memory_order_relaxed);
+            }
+            return keep;
+        }
+
+        bool EntityPathPolicies::RateLimiter::is_idle(int64_t now_ns) {
+            std::lock_guard lock(mutex);
+
+            // After a whole period without calls, both modes keep the next call.
+            return last_logged_period < now_ns / rule->period_ns - 1;
+        }
+
+        bool EntityPathPolicies::ChangeDetector::remove_unchanged(
+            std::vector<DataCell>& batches, bool timeless, bool splatted
+        ) {
+            const auto num_batches = batches.size();
+            batches.erase(
+                std::remove_if(
+                    batches.begin(),
+                    batches.end(),
+                    [&](const DataCell& batch) {
+                        if (batch.array == nullptr) {
+                            return false;
+                        }
+                        const uint64_t key = (static_cast<uint64_t>(batch.component_type) << 2) |
+                                             (static_cast<uint64_t>(timeless) << 1) |
+                                             static_cast<uint64_t>(splatted);
+
+                        const int64_t length = batch.array->length();
+                        const auto hash = hash_array_values(*batch.array->data(), 0, length);
+                        if (!hash.has_value()) {
+                            return false;
+                        }
+                        const LoggedBatch logged{*hash, length, batch.num_instances};
+
+                        auto [it, inserted] = last_batches.emplace(key, logged);
+                        if (inserted) {
+                            return false;
+                        }
+                        LoggedBatch& last = it->second;
+                        if (last.hash == logged.hash && last.length == logged.length &&
+                            last.num_instances == logged.num_instances) {
+                            return true;
+                        }
+                        last = logged;
+                        return false;
+                    }
+                ),
+                batches.end()
+            );
+            return batches.size() != num_batches;
+        }
+    } // namespace detail
+} // namespace rerun
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "component_type.hpp"
+#include "entity_path_filter.hpp"
+#include "image_downscale.hpp"
+#include "rate_limit.hpp"
+#include "series_downsampling.hpp"
+
+namespace rerun {
+    struct DataCell;
+
+    namespace components {
+        struct Scalar;
+    }
+
+    namespace detail {
+        /// Entity path filter, rate limits, change detection and previews of a `RecordingStream`.
+        ///
+        /// Which of them apply to an entity path is cached per entity path, so that a log call to
+        /// an already seen path costs one hash lookup.
+        /// All methods are thread-safe.
+        ///
+        /// Internal, not part of the public API.
+        class EntityPathPolicies {
+          public:
+            /// Reads the initial filter from `RERUN_ENTITY_PATH_FILTER`.
+            EntityPathPolicies();
+
+            void set_filter(EntityPathFilter filter);
+
+            void set_rate_limit(
+                std::string_view pattern_str, EntityPathPattern pattern, double max_rate_hz,
+                RateLimitMode mode
+            );
+
+            void clear_rate_limits();
+
+            void enable_change_detection(EntityPathPattern pattern);
+
+            void disable_change_detection();
+
+            /// Forgets which data was logged to the entity path before, so that the next log calls
+            /// aren't skipped.
+            ///
+            /// \param recursive Whether to also forget about all descendants of the entity path.
+            void reset_change_detection(std::string_view entity_path, bool recursive);
+
+            std::vector<RateLimitStats> rate_limit_stats() const;
+
+            void enable_previews(
+                EntityPathPattern pattern, size_t factor, image::DepthDownscaleMode depth_mode
+            );
+
+            void enable_point_cloud_previews(EntityPathPattern pattern, float voxel_size);
+
+            void enable_scalar_previews(EntityPathPattern pattern, size_t window_size);
+
+            void disable_previews();
+
+            /// Returns whether the entity path passes the filter.
+            bool is_included(std::string_view entity_path);
+
+            /// Returns whether a log call to the entity path passes the filter and rate limits.
+            ///
+            /// Unlike `is_included` this counts as a log call for rate limiting.
+            bool admit(std::string_view entity_path);
+
+            /// Removes all batches whose data is identical to what was last logged in their place.
+            ///
+            /// Does nothing unless change detection is enabled for the entity path.
+            /// Instanced and splatted batches are tracked separately since splatting changes
+            /// their meaning.
+            ///
+            /// \returns whether any batch was removed.
+            bool remove_unchanged_batches(
+                std::string_view entity_path, bool timeless, std::vector<DataCell>& instanced,
+                std::vector<DataCell>& splatted
+            );
+
+            /// Returns the factor by which images logged to the entity path are downscaled for
+            /// their preview, or 0 if there are no previews for the entity path.
+            size_t preview_factor(std::string_view entity_path);
+
+            /// Returns how depth images logged to the entity path are downscaled for their
+            /// preview.
+            image::DepthDownscaleMode preview_depth_mode(std::string_view entity_path);
+
+            /// Returns the voxel size to which point clouds logged to the entity path are
+            /// downsampled for their preview, or 0 if there are no point cloud previews for the
+            /// entity path.
+            float preview_voxel_size(std::string_view entity_path);
+
+            /// Adds a scalar logged to the entity path to its preview window.
+            ///
+            /// \returns The smallest and largest scalar of the window if the scalar completed it,
+            /// nothing otherwise or if there are no scalar previews for the entity path.
+            std::optional<series::MinMax> add_preview_scalar(
+                std::string_view entity_path, double value
+            );
+
+            /// Adds scalars logged to the entity path at once to its preview window.
+            ///
+            /// \returns For each window the scalars completed, the index of the scalar that
+            /// completed it and the window's smallest and largest scalar. Empty if there are no
+            /// scalar previews for the entity path.
+            std::vector<std::pair<size_t, series::MinMax>> add_preview_scalars(
+                std::string_view entity_path, const components::Scalar* values, size_t num_values
+            );
+
+          private:
+            /// Min/max window of the scalars logged to a single entity path.
+            struct ScalarPreview {
+                std::mutex mutex;
+                series::MinMaxWindow window;
+
+                explicit ScalarPreview(size_t window_size) : window(window_size) {}
+            };
+
+            /// Either an image, a point cloud or a scalar preview, the others are 0.
+            struct PreviewRule {
+                EntityPathPattern pattern;
+                size_t factor;
+                image::DepthDownscaleMode depth_mode;
+                float voxel_size;
+                size_t scalar_window_size;
+
+                /// Scalar preview windows per entity path.
+                ///
+                /// Kept outside the cache, such that clearing the cache doesn't lose the scalars
+                /// of incomplete windows. Only modified under a unique lock.
+                std::unordered_map<std::string, std::unique_ptr<ScalarPreview>> scalar_previews;
+            };
+
+            struct RateLimitRule;
+
+            /// Rate limiting state of a single entity path.
+            struct RateLimiter {
+                RateLimitRule* rule;
+                std::mutex mutex;
+                int64_t last_call_ns = 0;
+                int64_t avg_interval_ns = 0;
+                int64_t last_logged_period = -1;
+
+                bool admit(int64_t now_ns);
+
+                /// Whether the limiter would admit the next call just like a new one.
+                bool is_idle(int64_t now_ns);
+            };
+
+            struct RateLimitRule {
+                std::string pattern_str;
+                EntityPathPattern pattern;
+                int64_t period_ns;
+                double max_rate_hz;
+                RateLimitMode mode;
+                std::atomic<uint64_t> num_logged = 0;
+                std::atomic<uint64_t> num_suppressed = 0;
+
+                /// State per entity path.
+                ///
+                /// Kept outside the cache, such that clearing the cache doesn't let a burst of
+                /// log calls through. Only modified under a unique lock.
+                std::unordered_map<std::string, std::unique_ptr<RateLimiter>> limiters;
+            };
+
+            /// Hash of the values of a batch as it was last logged.
+            struct LoggedBatch {
+                uint64_t hash;
+                int64_t length;
+                size_t num_instances;
+            };
+
+            /// The last logged batches of a single entity path.
+            struct ChangeDetector {
+                std::mutex mutex;
+
+                /// Keyed by component type, whether it was timeless and whether it was splatted.
+                std::unordered_map<uint64_t, LoggedBatch> last_batches;
+
+                bool remove_unchanged(std::vector<DataCell>& batches, bool timeless, bool splatted);
+            };
+
+            struct CachedPolicy {
+                bool included;
+
+                /// Null if no rate limit applies, owned by its rule.
+                RateLimiter* rate_limiter = nullptr;
+
+                /// Null if change detection is disabled, owned by `_change_detectors`.
+                ChangeDetector* change_detector = nullptr;
+
+                /// 0 if there are no previews.
+                size_t preview_factor = 0;
+                image::DepthDownscaleMode preview_depth_mode = image::DepthDownscaleMode::Nearest;
+
+                /// 0 if there are no point cloud previews.
+                float preview_voxel_size = 0.0f;
+
+                /// Null if there are no scalar previews, owned by its rule.
+                ScalarPreview* scalar_preview = nullptr;
+            };
+
+            /// Calls `func` with the cached policy of the entity path, computing it if needed.
+            template <typename F>
+            auto with_cached_policy(std::string_view entity_path, F func) {
+                {
+                    std::shared_lock lock(_mutex);
+                    const auto it = _cache.find(entity_path);
+                    if (it != _cache.end()) {
+                        return func(it->second);
+                    }
+                }
+
+                std::unique_lock lock(_mutex);
+                return func(insert_into_cache(entity_path));
+            }
+
+            /// Requires a shared or unique lock on `_mutex`.
+            static bool admit_cached(const CachedPolicy& policy);
+
+            /// Requires a unique lock on `_mutex`.
+            const CachedPolicy& insert_into_cache(std::string_view entity_path);
+
+            /// Also drops idle rate limiters, change detectors and scalar preview windows if there
+            /// are too many.
+            ///
+            /// Requires a unique lock on `_mutex`.
+            void clear_cache();
+
+            /// Fast path for streams without any filter, rate limit, change detection or previews.
+            std::atomic_bool _is_active = false;
+
+            mutable std::shared_mutex _mutex;
+            EntityPathFilter _filter;
+            std::vector<std::unique_ptr<RateLimitRule>> _rate_limits;
+            std::vector<EntityPathPattern> _change_detection_patterns;
+
+            /// Change detection state per entity path.
+            ///
+            /// Kept outside the cache, such that clearing the cache doesn't make unchanged data
+            /// get logged again. Only modified under a unique lock.
+            std::unordered_map<std::string, std::unique_ptr<ChangeDetector>> _change_detectors;
+            std::vector<PreviewRule> _previews;
+
+            std::unordered_map<std::string_view, CachedPolicy> _cache;
+
+            /// Storage of the cache keys, deque elements never move on insertion.
+            std::deque<std::string> _interned_paths;
+        };
+    } // namespace detail
+} // namespace rerun
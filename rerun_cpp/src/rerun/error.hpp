@@ -40,6 +40,12 @@ namespace rerun {
         InvalidSocketAddress,
         InvalidComponentTypeHandle,
         InvalidTensorDimension,
+        InvalidEntityPathFilter,
+        InvalidRateLimit,
+        InvalidPointCloud,
+        InvalidDownsamplingWindow,
+        InvalidAppendableEntity,
+        InvalidTemporalBatch,
 
         // Recording stream errors
         _CategoryRecordingStream = 0x0000'0100,
@@ -48,6 +54,8 @@ namespace rerun {
         RecordingStreamSaveFailure,
         RecordingStreamStdoutFailure,
         RecordingStreamSpawnFailure,
+        RecordingStreamShmFailure,
+        RecordingStreamMemoryFailure,
 
         // Arrow data processing errors.
         _CategoryArrow = 0x0000'1000,
@@ -0,0 +1,225 @@
+#include "image_conversion.hpp"
+
+#include <memory>
+#include <string>
+
+#include "error.hpp"
+#include "shared_array.hpp"
+
+namespace rerun::image {
+    // Fixed point BT.601 limited range coefficients, scaled by 256.
+    // Adding `128 * 256` to the chroma sums keeps them positive before shifting,
+    // the additional `128` rounds to nearest.
+    static constexpr int32_t LUMA_OFFSET = 16 * 256 + 128;
+    static constexpr int32_t CHROMA_OFFSET = 128 * 256 + 128;
+
+    static inline uint8_t rgb_to_y(int32_t r, int32_t g, int32_t b) {
+        return static_cast<uint8_t>((66 * r + 129 * g + 25 * b + LUMA_OFFSET) >> 8);
+    }
+
+    /// `r`, `g`, `b` are sums of `1 << shift` pixels.
+    static inline uint8_t rgb_to_u(int32_t r, int32_t g, int32_t b, int shift) {
+        return static_cast<uint8_t>(
+            (-38 * r - 74 * g + 112 * b + (CHROMA_OFFSET << shift)) >> (8 + shift)
+        );
+    }
+
+    /// `r`, `g`, `b` are sums of `1 << shift` pixels.
+    static inline uint8_t rgb_to_v(int32_t r, int32_t g, int32_t b, int shift) {
+        return static_cast<uint8_t>(
+            (112 * r - 94 * g - 18 * b + (CHROMA_OFFSET << shift)) >> (8 + shift)
+        );
+    }
+
+    void bgr_to_rgb(const uint8_t* bgr, uint8_t* rgb, size_t num_pixels) {
+        for (size_t i = 0; i < num_pixels * 3; i += 3) {
+            const uint8_t b = bgr[i + 0];
+            const uint8_t g = bgr[i + 1];
+            const uint8_t r = bgr[i + 2];
+            rgb[i + 0] = r;
+            rgb[i + 1] = g;
+            rgb[i + 2] = b;
+        }
+    }
+
+    void bgra_to_rgba(const uint8_t* bgra, uint8_t* rgba, size_t num_pixels) {
+        for (size_t i = 0; i < num_pixels * 4; i += 4) {
+            const uint8_t b = bgra[i + 0];
+            const uint8_t g = bgra[i + 1];
+            const uint8_t r = bgra[i + 2];
+            const uint8_t a = bgra[i + 3];
+            rgba[i + 0] = r;
+            rgba[i + 1] = g;
+            rgba[i + 2] = b;
+            rgba[i + 3] = a;
+        }
+    }
+
+    void rgb_to_nv12(const uint8_t* rgb, size_t width, size_t height, uint8_t* nv12) {
+        uint8_t* y_plane = nv12;
+        uint8_t* uv_plane = nv12 + width * height;
+
+        for (size_t i = 0; i < width * height; ++i) {
+            y_plane[i] = rgb_to_y(rgb[i * 3 + 0], rgb[i * 3 + 1], rgb[i * 3 + 2]);
+        }
+
+        // Chroma of every 2x2 block.
+        for (size_t y = 0; y < height; y += 2) {
+            const uint8_t* row0 = rgb + y * width * 3;
+            const uint8_t* row1 = row0 + width * 3;
+            uint8_t* uv_row = uv_plane + y / 2 * width;
+
+            for (size_t x = 0; x < width; x += 2) {
+                const size_t i = x * 3;
+                const int32_t r = row0[i + 0] + row0[i + 3] + row1[i + 0] + row1[i + 3];
+                const int32_t g = row0[i + 1] + row0[i + 4] + row1[i + 1] + row1[i + 4];
+                const int32_t b = row0[i + 2] + row0[i + 5] + row1[i + 2] + row1[i + 5];
+                uv_row[x + 0] = rgb_to_u(r, g, b, 2);
+                uv_row[x + 1] = rgb_to_v(r, g, b, 2);
+            }
+        }
+    }
+
+    void rgb_to_yuy2(const uint8_t* rgb, size_t width, size_t height, uint8_t* yuy2) {
+        const size_t num_pairs = width * height / 2;
+        for (size_t p = 0; p < num_pairs; ++p) {
+            const uint8_t* pixels = rgb + p * 6;
+            const int32_t r = pixels[0] + pixels[3];
+            const int32_t g = pixels[1] + pixels[4];
+            const int32_t b = pixels[2] + pixels[5];
+
+            yuy2[p * 4 + 0] = rgb_to_y(pixels[0], pixels[1], pixels[2]);
+            yuy2[p * 4 + 1] = rgb_to_u(r, g, b, 1);
+            yuy2[p * 4 + 2] = rgb_to_y(pixels[3], pixels[4], pixels[5]);
+            yuy2[p * 4 + 3] = rgb_to_v(r, g, b, 1);
+        }
+    }
+
+    void bayer_to_rgb(
+        const uint8_t* raw, size_t width, size_t height, BayerPattern pattern, uint8_t* rgb
+    ) {
+        // Channel (0 = red, 1 = green, 2 = blue) of the top-left 2x2 block, indexed by [y][x].
+        static constexpr int CFA_CHANNELS[4][2][2] = {
+            {{0, 1}, {1, 2}}, // RGGB
+            {{2, 1}, {1, 0}}, // BGGR
+            {{1, 0}, {2, 1}}, // GRBG
+            {{1, 2}, {0, 1}}, // GBRG
+        };
+        const auto& cfa = CFA_CHANNELS[static_cast<size_t>(pattern)];
+
+        // Neighbors outside the image are mirrored, which keeps their color the same as the one
+        // of the missing neighbor.
+        for (size_t y = 0; y < height; ++y) {
+            const uint8_t* row = raw + y * width;
+            const uint8_t* row_above = raw + (y == 0 ? 1 : y - 1) * width;
+            const uint8_t* row_below = raw + (y + 1 == height ? height - 2 : y + 1) * width;
+            uint8_t* out = rgb + y * width * 3;
+
+            for (size_t x = 0; x < width; ++x) {
+                const size_t left = x == 0 ? 1 : x - 1;
+                const size_t right = x + 1 == width ? width - 2 : x + 1;
+
+                const int channel = cfa[y & 1][x & 1];
+                const int cross = (row[left] + row[right] + row_above[x] + row_below[x] + 2) / 4;
+                const int horizontal = (row[left] + row[right] + 1) / 2;
+                const int vertical = (row_above[x] + row_below[x] + 1) / 2;
+                const int diagonal = (row_above[left] + row_above[right] + row_below[left] +
+                                      row_below[right] + 2) /
+                                     4;
+
+                uint8_t* pixel = out + x * 3;
+                pixel[channel] = row[x];
+                if (channel == 1) {
+                    pixel[cfa[y & 1][(x + 1) & 1]] = static_cast<uint8_t>(horizontal);
+                    pixel[cfa[(y + 1) & 1][x & 1]] = static_cast<uint8_t>(vertical);
+                } else {
+                    pixel[1] = static_cast<uint8_t>(cross);
+                    pixel[2 - channel] = static_cast<uint8_t>(diagonal);
+                }
+            }
+        }
+    }
+
+    archetypes::Image bgr_image(const uint8_t* bgr, size_t width, size_t height) {
+        const size_t num_bytes = width * height * 3;
+        auto pixels = detail::allocate_shared_array<uint8_t>(num_bytes);
+        bgr_to_rgb(bgr, pixels.get(), width * height);
+        return archetypes::Image(
+            {height, width, 3},
+            datatypes::TensorBuffer::u8(Collection<uint8_t>::share(std::move(pixels), num_bytes))
+        );
+    }
+
+    archetypes::Image bgra_image(const uint8_t* bgra, size_t width, size_t height) {
+        const size_t num_bytes = width * height * 4;
+        auto pixels = detail::allocate_shared_array<uint8_t>(num_bytes);
+        bgra_to_rgba(bgra, pixels.get(), width * height);
+        return archetypes::Image(
+            {height, width, 4},
+            datatypes::TensorBuffer::u8(Collection<uint8_t>::share(std::move(pixels), num_bytes))
+        );
+    }
+
+    archetypes::Image nv12_image(const uint8_t* rgb, size_t width, size_t height) {
+        if (width % 2 != 0 || height % 2 != 0) {
+            Error(
+                ErrorCode::InvalidTensorDimension,
+                "NV12 images need an even width and height, got " + std::to_string(width) + "x" +
+                    std::to_string(height) + "."
+            )
+                .handle();
+            return archetypes::Image();
+        }
+
+        const size_t num_bytes = width * height * 3 / 2;
+        auto pixels = detail::allocate_shared_array<uint8_t>(num_bytes);
+        rgb_to_nv12(rgb, width, height, pixels.get());
+        // The viewer expects the luma and chroma planes stacked on top of each other.
+        return archetypes::Image(
+            {height * 3 / 2, width},
+            datatypes::TensorBuffer::nv12(Collection<uint8_t>::share(std::move(pixels), num_bytes))
+        );
+    }
+
+    archetypes::Image yuy2_image(const uint8_t* rgb, size_t width, size_t height) {
+        if (width % 2 != 0) {
+            Error(
+                ErrorCode::InvalidTensorDimension,
+                "YUY2 images need an even width, got " + std::to_string(width) + "."
+            )
+                .handle();
+            return archetypes::Image();
+        }
+
+        const size_t num_bytes = width * height * 2;
+        auto pixels = detail::allocate_shared_array<uint8_t>(num_bytes);
+        rgb_to_yuy2(rgb, width, height, pixels.get());
+        // The viewer expects two bytes per pixel along the width.
+        return archetypes::Image(
+            {height, width * 2},
+            datatypes::TensorBuffer::yuy2(Collection<uint8_t>::share(std::move(pixels), num_bytes))
+        );
+    }
+
+    archetypes::Image bayer_image(
+        const uint8_t* raw, size_t width, size_t height, BayerPattern pattern
+    ) {
+        if (width < 2 || height < 2) {
+            Error(
+                ErrorCode::InvalidTensorDimension,
+                "Bayer images need to be at least 2x2 pixels, got " + std::to_string(width) + "x" +
+                    std::to_string(height) + "."
+            )
+                .handle();
+            return archetypes::Image();
+        }
+
+        const size_t num_bytes = width * height * 3;
+        auto pixels = detail::allocate_shared_array<uint8_t>(num_bytes);
+        bayer_to_rgb(raw, width, height, pattern, pixels.get());
+        return archetypes::Image(
+            {height, width, 3},
+            datatypes::TensorBuffer::u8(Collection<uint8_t>::share(std::move(pixels), num_bytes))
+        );
+    }
+} // namespace rerun::image
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "archetypes/image.hpp"
+
+namespace rerun {
+    /// Conversions of common camera pixel formats to formats that Rerun can display.
+    ///
+    /// The `*_to_*` kernels work on raw, tightly packed 8-bit pixel buffers.
+    /// The `*_image` functions convert straight into a newly allocated, reference counted
+    /// `rerun::archetypes::Image` buffer, so there is no further copy until serialization and
+    /// copies of the resulting image are cheap.
+    ///
+    /// All YUV conversions use limited range BT.601, which is what the viewer expects.
+    namespace image {
+        /// Color filter array layout of a raw Bayer image, named after its top-left 2x2 block.
+        enum class BayerPattern {
+            RGGB,
+            BGGR,
+            GRBG,
+            GBRG,
+        };
+
+        /// Converts BGR pixels (e.g. OpenCV's default layout) to RGB.
+        ///
+        /// `bgr` and `rgb` may point to the same buffer.
+        void bgr_to_rgb(const uint8_t* bgr, uint8_t* rgb, size_t num_pixels);
+
+        /// Converts BGRA pixels to RGBA.
+        ///
+        /// `bgra` and `rgba` may point to the same buffer.
+        void bgra_to_rgba(const uint8_t* bgra, uint8_t* rgba, size_t num_pixels);
+
+        /// Converts RGB pixels to NV12, i.e. a full resolution luma plane followed by a
+        /// half resolution plane of interleaved chroma.
+        ///
+        /// Width and height have to be even. `nv12` has to hold `width * height * 3 / 2` bytes.
+        /// This halves the size of the data compared to RGB.
+        void rgb_to_nv12(const uint8_t* rgb, size_t width, size_t height, uint8_t* nv12);
+
+        /// Converts RGB pixels to YUY2, i.e. `Y0 U Y1 V` for every pair of horizontal pixels.
+        ///
+        /// Width has to be even. `yuy2` has to hold `width * height * 2` bytes.
+        void rgb_to_yuy2(const uint8_t* rgb, size_t width, size_t height, uint8_t* yuy2);
+
+        /// Demosaics a raw Bayer image to RGB using bilinear interpolation.
+        ///
+        /// Width and height have to be at least 2. `rgb` has to hold `width * height * 3` bytes.
+        void bayer_to_rgb(
+            const uint8_t* raw, size_t width, size_t height, BayerPattern pattern, uint8_t* rgb
+        );
+
+        /// Creates an RGB image from BGR pixels.
+        archetypes::Image bgr_image(const uint8_t* bgr, size_t width, size_t height);
+
+        /// Creates an RGBA image from BGRA pixels.
+        archetypes::Image bgra_image(const uint8_t* bgra, size_t width, size_t height);
+
+        /// Creates an NV12 encoded image from RGB pixels.
+        ///
+        /// Calls `Error::handle()` and returns an empty image if width or height are odd.
+        archetypes::Image nv12_image(const uint8_t* rgb, size_t width, size_t height);
+
+        /// Creates a YUY2 encoded image from RGB pixels.
+        ///
+        /// Calls `Error::handle()` and returns an empty image if the width is odd.
+        archetypes::Image yuy2_image(const uint8_t* rgb, size_t width, size_t height);
+
+        /// Creates an RGB image from a raw Bayer image.
+        ///
+        /// Calls `Error::handle()` and returns an empty image if width or height are less than 2.
+        archetypes::Image bayer_image(
+            const uint8_t* raw, size_t width, size_t height, BayerPattern pattern
+        );
+    } // namespace image
+} // namespace rerun
@@ -0,0 +1,290 @@
+#include "image_downscale.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "error.hpp"
+#include "shared_array.hpp"
+
+namespace rerun::image {
+    /// Type used to sum up elements of type `TElement` without overflowing.
+    template <typename TElement>
+    struct BoxSum {
+        using Type = uint64_t;
+
+        static TElement average(uint64_t sum, size_t count) {
+            return static_cast<TElement>((sum + count / 2) / count);
+        }
+    };
+
+    template <>
+    struct BoxSum<float> {
+        using Type = float;
+
+        static float average(float sum, size_t count) {
+            return sum / static_cast<float>(count);
+        }
+    };
+
+    template <typename TElement>
+    static void box_downscale(
+        const TElement* src, size_t width, size_t height, size_t num_channels, size_t factor,
+        TElement* dst
+    ) {
+        using TSum = typename BoxSum<TElement>::Type;
+
+        const size_t row_length = width * num_channels;
+        const size_t dst_row_length = downscaled_size(width, factor) * num_channels;
+        std::vector<TSum> column_sums(row_length);
+
+        for (size_t y0 = 0; y0 < height; y0 += factor) {
+            const size_t y1 = std::min(y0 + factor, height);
+
+            std::fill(column_sums.begin(), column_sums.end(), TSum(0));
+            for (size_t y = y0; y < y1; ++y) {
+                const TElement* row = src + y * row_length;
+                for (size_t i = 0; i < row_length; ++i) {
+                    column_sums[i] += row[i];
+                }
+            }
+
+            TElement* dst_row = dst + y0 / factor * dst_row_length;
+            for (size_t x0 = 0; x0 < width; x0 += factor) {
+                const size_t x1 = std::min(x0 + factor, width);
+                const size_t count = (x1 - x0) * (y1 - y0);
+                for (size_t c = 0; c < num_channels; ++c) {
+                    TSum sum = 0;
+                    for (size_t x = x0; x < x1; ++x) {
+                        sum += column_sums[x * num_channels + c];
+                    }
+                    dst_row[x0 / factor * num_channels + c] = BoxSum<TElement>::average(sum, count);
+                }
+            }
+        }
+    }
+
+    template <typename TElement>
+    static void depth_downscale(
+        const TElement* src, size_t width, size_t height, size_t factor, DepthDownscaleMode mode,
+        TElement* dst
+    ) {
+        const size_t dst_width = downscaled_size(width, factor);
+
+        for (size_t y0 = 0; y0 < height; y0 += factor) {
+            const size_t y1 = std::min(y0 + factor, height);
+            TElement* dst_row = dst + y0 / factor * dst_width;
+
+            for (size_t x0 = 0; x0 < width; x0 += factor) {
+                const size_t x1 = std::min(x0 + factor, width);
+
+                TElement depth = 0;
+                switch (mode) {
+                    case DepthDownscaleMode::Nearest:
+                        depth = src[(y0 + (y1 - y0) / 2) * width + x0 + (x1 - x0) / 2];
+                        break;
+
+                    case DepthDownscaleMode::Min:
+                    case DepthDownscaleMode::Max:
+                        for (size_t y = y0; y < y1; ++y) {
+                            for (size_t x = x0; x < x1; ++x) {
+                                // Written so that NaN fails the comparison.
+                                const TElement value = src[y * width + x];
+                                if (!(value > 0)) {
+                                    continue;
+                                }
+                                if (depth == 0 || (mode == DepthDownscaleMode::Min
+                                                       ? value < depth
+                                                       : value > depth)) {
+                                    depth = value;
+                                }
+                            }
+                        }
+                        break;
+                }
+                dst_row[x0 / factor] = depth;
+            }
+        }
+    }
+
+    void downscale(
+        const uint8_t* src, size_t width, size_t height, size_t num_channels, size_t factor,
+        uint8_t* dst
+    ) {
+        box_downscale(src, width, height, num_channels, factor, dst);
+    }
+
+    void downscale(
+        const uint16_t* src, size_t width, size_t height, size_t num_channels, size_t factor,
+        uint16_t* dst
+    ) {
+        box_downscale(src, width, height, num_channels, factor, dst);
+    }
+
+    void downscale(
+        const float* src, size_t width, size_t height, size_t num_channels, size_t factor,
+        float* dst
+    ) {
+        box_downscale(src, width, height, num_channels, factor, dst);
+    }
+
+    void downscale_depth(
+        const uint16_t* src, size_t width, size_t height, size_t factor, DepthDownscaleMode mode,
+        uint16_t* dst
+    ) {
+        depth_downscale(src, width, height, factor, mode, dst);
+    }
+
+    void downscale_depth(
+        const float* src, size_t width, size_t height, size_t factor, DepthDownscaleMode mode,
+        float* dst
+    ) {
+        depth_downscale(src, width, height, factor, mode, dst);
+    }
+
+    /// Downscales the pixels of `src` into a new collection with `downscale_pixels`.
+    template <typename TElement, typename F>
+    static Collection<TElement> downscale_collection(
+        const Collection<TElement>& src, size_t num_dst_elements, F&& downscale_pixels
+    ) {
+        auto elements = detail::allocate_shared_array<TElement>(num_dst_elements);
+        downscale_pixels(src.data(), elements.get());
+        return Collection<TElement>::share(std::move(elements), num_dst_elements);
+    }
+
+    /// Validates the factor and the number of elements of an image and returns its
+    /// downscaled shape.
+    static Result<Collection<datatypes::TensorDimension>> downscaled_shape(
+        const datatypes::TensorData& image, size_t num_channels, size_t factor
+    ) {
+        if (factor == 0) {
+            return Error(ErrorCode::InvalidTensorDimension, "Downscale factor must be positive.");
+        }
+
+        const auto& shape = image.shape;
+        const size_t width = shape[1].size;
+        const size_t height = shape[0].size;
+        if (image.buffer.num_elems() != width * height * num_channels) {
+            return Error(
+                ErrorCode::InvalidTensorDimension,
+                "Image shape doesn't match the number of pixels, expected " +
+                    std::to_string(width * height * num_channels) + " elements, got " +
+                    std::to_string(image.buffer.num_elems()) + "."
+            );
+        }
+
+        return Collection<datatypes::TensorDimension>::build(shape.size(), [&](auto& new_shape) {
+            new_shape.insert(new_shape.end(), shape.begin(), shape.end());
+            new_shape[0].size = downscaled_size(height, factor);
+            new_shape[1].size = downscaled_size(width, factor);
+        });
+    }
+
+    bool is_downscale_supported(const datatypes::TensorData& image) {
+        const auto& shape = image.shape;
+        if (shape.size() != 2 && shape.size() != 3) {
+            return false;
+        }
+        const size_t num_channels = shape.size() == 3 ? shape[2].size : 1;
+        if (num_channels != 1 && num_channels != 3 && num_channels != 4) {
+            return false;
+        }
+        return image.buffer.get_u8() != nullptr || image.buffer.get_u16() != nullptr ||
+               image.buffer.get_f32() != nullptr;
+    }
+
+    bool is_depth_downscale_supported(const datatypes::TensorData& depth_image) {
+        if (depth_image.shape.size() != 2) {
+            return false;
+        }
+        return depth_image.buffer.get_u16() != nullptr || depth_image.buffer.get_f32() != nullptr;
+    }
+
+    Result<datatypes::TensorData> downscale_image_data(
+        const datatypes::TensorData& image, size_t factor
+    ) {
+        const auto& shape = image.shape;
+        if (shape.size() != 2 && shape.size() != 3) {
+            return Error(
+                ErrorCode::InvalidTensorDimension,
+                "Image shape is expected to be either rank 2 or 3."
+            );
+        }
+        const size_t num_channels = shape.size() == 3 ? shape[2].size : 1;
+        if (num_channels != 1 && num_channels != 3 && num_channels != 4) {
+            return Error(
+                ErrorCode::InvalidTensorDimension,
+                "Only images with 1, 3 and 4 channels can be downscaled."
+            );
+        }
+
+        auto new_shape = downscaled_shape(image, num_channels, factor);
+        RR_RETURN_NOT_OK(new_shape.error);
+
+        const size_t width = shape[1].size;
+        const size_t height = shape[0].size;
+        const size_t num_dst_elements =
+            downscaled_size(width, factor) * downscaled_size(height, factor) * num_channels;
+        const auto downscale_pixels = [&](const auto* src, auto* dst) {
+            downscale(src, width, height, num_channels, factor, dst);
+        };
+
+        if (const auto* pixels = image.buffer.get_u8()) {
+            return datatypes::TensorData(
+                std::move(new_shape.value),
+                downscale_collection(*pixels, num_dst_elements, downscale_pixels)
+            );
+        } else if (const auto* pixels_u16 = image.buffer.get_u16()) {
+            return datatypes::TensorData(
+                std::move(new_shape.value),
+                downscale_collection(*pixels_u16, num_dst_elements, downscale_pixels)
+            );
+        } else if (const auto* pixels_f32 = image.buffer.get_f32()) {
+            return datatypes::TensorData(
+                std::move(new_shape.value),
+                downscale_collection(*pixels_f32, num_dst_elements, downscale_pixels)
+            );
+        }
+        return Error(
+            ErrorCode::InvalidTensorDimension,
+            "Only images with u8, u16 and f32 pixels can be downscaled."
+        );
+    }
+
+    Result<datatypes::TensorData> downscale_depth_image_data(
+        const datatypes::TensorData& depth_image, size_t factor, DepthDownscaleMode mode
+    ) {
+        const auto& shape = depth_image.shape;
+        if (shape.size() != 2) {
+            return Error(ErrorCode::InvalidTensorDimension, "Shape must be rank 2.");
+        }
+
+        auto new_shape = downscaled_shape(depth_image, 1, factor);
+        RR_RETURN_NOT_OK(new_shape.error);
+
+        const size_t width = shape[1].size;
+        const size_t height = shape[0].size;
+        const size_t num_dst_elements =
+            downscaled_size(width, factor) * downscaled_size(height, factor);
+        const auto downscale_pixels = [&](const auto* src, auto* dst) {
+            downscale_depth(src, width, height, factor, mode, dst);
+        };
+
+        if (const auto* depth_u16 = depth_image.buffer.get_u16()) {
+            return datatypes::TensorData(
+                std::move(new_shape.value),
+                downscale_collection(*depth_u16, num_dst_elements, downscale_pixels)
+            );
+        } else if (const auto* depth_f32 = depth_image.buffer.get_f32()) {
+            return datatypes::TensorData(
+                std::move(new_shape.value),
+                downscale_collection(*depth_f32, num_dst_elements, downscale_pixels)
+            );
+        }
+        return Error(
+            ErrorCode::InvalidTensorDimension,
+            "Only depth images with u16 and f32 pixels can be downscaled."
+        );
+    }
+} // namespace rerun::image
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "datatypes/tensor_data.hpp"
+#include "result.hpp"
+
+namespace rerun {
+    namespace image {
+        /// How a downscaled depth image picks the depth of each of its pixels.
+        ///
+        /// Unlike color images, averaging depth would create surfaces that don't exist at the
+        /// edges of objects.
+        enum class DepthDownscaleMode {
+            /// Depth at the center of the downscaled pixel.
+            Nearest,
+
+            /// Closest valid depth within the downscaled pixel.
+            Min,
+
+            /// Farthest valid depth within the downscaled pixel.
+            Max,
+        };
+
+        /// Size of an image dimension after downscaling by the given factor.
+        ///
+        /// Pixels at the right and bottom edge cover fewer source pixels if the size is not a
+        /// multiple of the factor.
+        inline size_t downscaled_size(size_t size, size_t factor) {
+            return (size + factor - 1) / factor;
+        }
+
+        /// Downscales an image by an integer factor, averaging each `factor x factor` block.
+        ///
+        /// `dst` has to hold `downscaled_size(width, factor) * downscaled_size(height, factor)`
+        /// pixels of `num_channels` elements.
+        void downscale(
+            const uint8_t* src, size_t width, size_t height, size_t num_channels, size_t factor,
+            uint8_t* dst
+        );
+
+        /// \copydoc downscale
+        void downscale(
+            const uint16_t* src, size_t width, size_t height, size_t num_channels, size_t factor,
+            uint16_t* dst
+        );
+
+        /// \copydoc downscale
+        void downscale(
+            const float* src, size_t width, size_t height, size_t num_channels, size_t factor,
+            float* dst
+        );
+
+        /// Downscales a depth image by an integer factor.
+        ///
+        /// Zero, negative and NaN depths are invalid and ignored by the `Min` and `Max` modes.
+        /// Pixels without any valid depth become 0.
+        /// `dst` has to hold `downscaled_size(width, factor) * downscaled_size(height, factor)`
+        /// pixels.
+        void downscale_depth(
+            const uint16_t* src, size_t width, size_t height, size_t factor,
+            DepthDownscaleMode mode, uint16_t* dst
+        );
+
+        /// \copydoc downscale_depth
+        void downscale_depth(
+            const float* src, size_t width, size_t height, size_t factor, DepthDownscaleMode mode,
+            float* dst
+        );
+
+        /// Whether `downscale_image_data` supports the rank, channels and pixel type of the image.
+        ///
+        /// Encoded and chroma subsampled images, e.g. JPEG and NV12, aren't supported.
+        bool is_downscale_supported(const datatypes::TensorData& image);
+
+        /// Whether `downscale_depth_image_data` supports the rank and pixel type of the depth
+        /// image.
+        bool is_depth_downscale_supported(const datatypes::TensorData& depth_image);
+
+        /// Downscales the data of an image with u8, u16 or f32 pixels and 1, 3 or 4 channels.
+        ///
+        /// Dimension names are kept.
+        /// \returns An error if the image can't be downscaled.
+        Result<datatypes::TensorData> downscale_image_data(
+            const datatypes::TensorData& image, size_t factor
+        );
+
+        /// Downscales the data of a depth image with u16 or f32 pixels.
+        ///
+        /// Dimension names are kept.
+        /// \returns An error if the depth image can't be downscaled.
+        Result<datatypes::TensorData> downscale_depth_image_data(
+            const datatypes::TensorData& depth_image, size_t factor, DepthDownscaleMode mode
+        );
+    } // namespace image
+} // namespace rerun
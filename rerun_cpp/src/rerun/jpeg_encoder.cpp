@@ -0,0 +1,542 @@
+#include "jpeg_encoder.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "error.hpp"
+
+// Baseline JPEG as specified by ITU T.81, using the example quantization and Huffman tables of
+// its Annex K.
+
+namespace rerun::image {
+    /// Natural (row-major) index of the n-th coefficient in zig-zag order.
+    static constexpr uint8_t ZIGZAG[64] = {
+        0,  1,  8,  16, 9,  2,  3,  10, 17, 24, 32, 25, 18, 11, 4,  5,  //
+        12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6,  7,  14, 21, 28, //
+        35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51, //
+        58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63, //
+    };
+
+    static constexpr uint8_t LUMA_QUANTIZATION[64] = {
+        16, 11, 10, 16, 24,  40,  51,  61,  //
+        12, 12, 14, 19, 26,  58,  60,  55,  //
+        14, 13, 16, 24, 40,  57,  69,  56,  //
+        14, 17, 22, 29, 51,  87,  80,  62,  //
+        18, 22, 37, 56, 68,  109, 103, 77,  //
+        24, 35, 55, 64, 81,  104, 113, 92,  //
+        49, 64, 78, 87, 103, 121, 120, 101, //
+        72, 92, 95, 98, 112, 100, 103, 99,  //
+    };
+
+    static constexpr uint8_t CHROMA_QUANTIZATION[64] = {
+        17, 18, 24, 47, 99, 99, 99, 99, //
+        18, 21, 26, 66, 99, 99, 99, 99, //
+        24, 26, 56, 99, 99, 99, 99, 99, //
+        47, 66, 99, 99, 99, 99, 99, 99, //
+        99, 99, 99, 99, 99, 99, 99, 99, //
+        99, 99, 99, 99, 99, 99, 99, 99, //
+        99, 99, 99, 99, 99, 99, 99, 99, //
+        99, 99, 99, 99, 99, 99, 99, 99, //
+    };
+
+    // Huffman tables as number of codes per code length (1 to 16) followed by the coded values.
+
+    static constexpr uint8_t LUMA_DC_CODE_LENGTHS[16] = {0, 1, 5, 1, 1, 1, 1, 1, 1};
+    static constexpr uint8_t CHROMA_DC_CODE_LENGTHS[16] = {0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+    static constexpr uint8_t DC_VALUES[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+    static constexpr uint8_t LUMA_AC_CODE_LENGTHS[16] =
+        {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d};
+    static constexpr uint8_t LUMA_AC_VALUES[162] = {
+        0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61,
+        0x07, 0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52,
+        0xd1, 0xf0, 0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25,
+        0x26, 0x27, 0x28, 0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45,
+        0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64,
+        0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83,
+        0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+        0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6,
+        0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3,
+        0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8,
+        0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa,
+    };
+
+    static constexpr uint8_t CHROMA_AC_CODE_LENGTHS[16] =
+        {0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77};
+    static constexpr uint8_t CHROMA_AC_VALUES[162] = {
+        0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61,
+        0x71, 0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33,
+        0x52, 0xf0, 0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18,
+        0x19, 0x1a, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44,
+        0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63,
+        0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a,
+        0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+        0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4,
+        0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca,
+        0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7,
+        0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa,
+    };
+
+    /// Scale factors of the AAN DCT's outputs.
+    static constexpr float AAN_SCALE_FACTORS[8] = {
+        1.0f,
+        1.387039845f,
+        1.306562965f,
+        1.175875602f,
+        1.0f,
+        0.785694958f,
+        0.541196100f,
+        0.275899379f,
+    };
+
+    namespace {
+        struct HuffmanTable {
+            uint16_t codes[256] = {};
+            uint8_t code_lengths[256] = {};
+
+            /// Assigns the canonical codes of a table given as in the DHT segment.
+            HuffmanTable(const uint8_t* num_codes_per_length, const uint8_t* values) {
+                uint16_t code = 0;
+                size_t value_index = 0;
+                for (uint8_t length = 1; length <= 16; ++length) {
+                    for (uint8_t i = 0; i < num_codes_per_length[length - 1]; ++i) {
+                        const uint8_t value = values[value_index++];
+                        codes[value] = code++;
+                        code_lengths[value] = length;
+                    }
+                    code = static_cast<uint16_t>(code << 1);
+                }
+            }
+        };
+
+        /// Writes entropy coded data, stuffing a zero byte after every `0xFF`.
+        class BitWriter {
+          public:
+            explicit BitWriter(std::vector<uint8_t>& out) : _out(out) {}
+
+            void write(uint32_t bits, int num_bits) {
+                _buffer = (_buffer << num_bits) | bits;
+                _num_bits += num_bits;
+                while (_num_bits >= 8) {
+                    const auto byte = static_cast<uint8_t>(_buffer >> (_num_bits - 8));
+                    _out.push_back(byte);
+                    if (byte == 0xFF) {
+                        _out.push_back(0x00);
+                    }
+                    _num_bits -= 8;
+                }
+            }
+
+            void write_code(const HuffmanTable& table, uint8_t value) {
+                write(table.codes[value], table.code_lengths[value]);
+            }
+
+            /// Pads the last byte with one bits.
+            void flush() {
+                if (_num_bits > 0) {
+                    write((1u << (8 - _num_bits)) - 1, 8 - _num_bits);
+                }
+            }
+
+          private:
+            std::vector<uint8_t>& _out;
+            uint32_t _buffer = 0;
+            int _num_bits = 0;
+        };
+
+        /// Quantization and entropy coding state of one color component.
+        struct Component {
+            /// Reciprocal of the quantization step including the DCT's scale factors,
+            /// in natural order.
+            float scale[64];
+            const HuffmanTable* dc_table;
+            const HuffmanTable* ac_table;
+            int previous_dc = 0;
+        };
+    } // namespace
+
+    static void scale_quantization_table(const uint8_t* base, int quality, uint8_t* table) {
+        // Same scaling as libjpeg, so that quality values are comparable.
+        const int scale = quality < 50 ? 5000 / quality : 200 - quality * 2;
+        for (size_t i = 0; i < 64; ++i) {
+            table[i] = static_cast<uint8_t>(std::clamp((base[i] * scale + 50) / 100, 1, 255));
+        }
+    }
+
+    static void init_component_scale(const uint8_t* quantization_table, Component& component) {
+        for (size_t row = 0; row < 8; ++row) {
+            for (size_t col = 0; col < 8; ++col) {
+                component.scale[row * 8 + col] =
+                    1.0f / (static_cast<float>(quantization_table[row * 8 + col]) *
+                            AAN_SCALE_FACTORS[row] * AAN_SCALE_FACTORS[col] * 8.0f);
+            }
+        }
+    }
+
+    /// One dimensional AAN forward DCT of 8 values with the given stride, in place.
+    static inline void fdct_1d(float* d, size_t stride) {
+        const float tmp0 = d[0 * stride] + d[7 * stride];
+        const float tmp7 = d[0 * stride] - d[7 * stride];
+        const float tmp1 = d[1 * stride] + d[6 * stride];
+        const float tmp6 = d[1 * stride] - d[6 * stride];
+        const float tmp2 = d[2 * stride] + d[5 * stride];
+        const float tmp5 = d[2 * stride] - d[5 * stride];
+        const float tmp3 = d[3 * stride] + d[4 * stride];
+        const float tmp4 = d[3 * stride] - d[4 * stride];
+
+        // Even part.
+        const float tmp10 = tmp0 + tmp3;
+        const float tmp13 = tmp0 - tmp3;
+        const float tmp11 = tmp1 + tmp2;
+        const float tmp12 = tmp1 - tmp2;
+
+        d[0 * stride] = tmp10 + tmp11;
+        d[4 * stride] = tmp10 - tmp11;
+
+        const float z1 = (tmp12 + tmp13) * 0.707106781f;
+        d[2 * stride] = tmp13 + z1;
+        d[6 * stride] = tmp13 - z1;
+
+        // Odd part.
+        const float odd10 = tmp4 + tmp5;
+        const float odd11 = tmp5 + tmp6;
+        const float odd12 = tmp6 + tmp7;
+
+        const float z5 = (odd10 - odd12) * 0.382683433f;
+        const float z2 = 0.541196100f * odd10 + z5;
+        const float z4 = 1.306562965f * odd12 + z5;
+        const float z3 = odd11 * 0.707106781f;
+
+        const float z11 = tmp7 + z3;
+        const float z13 = tmp7 - z3;
+
+        d[5 * stride] = z13 + z2;
+        d[3 * stride] = z13 - z2;
+        d[1 * stride] = z11 + z4;
+        d[7 * stride] = z11 - z4;
+    }
+
+    /// Number of bits needed for the magnitude of a value, called its category.
+    static uint8_t bit_length(int value) {
+        auto magnitude = static_cast<uint32_t>(value < 0 ? -value : value);
+        uint8_t length = 0;
+        while (magnitude != 0) {
+            magnitude >>= 1;
+            ++length;
+        }
+        return length;
+    }
+
+    /// Writes the low `category` bits of a value, negative values as their one's complement.
+    static void write_value_bits(BitWriter& writer, int value, uint8_t category) {
+        if (category > 0) {
+            const int bits = value < 0 ? value + (1 << category) - 1 : value;
+            writer.write(static_cast<uint32_t>(bits), category);
+        }
+    }
+
+    static void encode_block(float* block, Component& component, BitWriter& writer) {
+        for (size_t row = 0; row < 8; ++row) {
+            fdct_1d(block + row * 8, 1);
+        }
+        for (size_t col = 0; col < 8; ++col) {
+            fdct_1d(block + col, 8);
+        }
+
+        int coefficients[64];
+        for (size_t i = 0; i < 64; ++i) {
+            const float value = block[i] * component.scale[i];
+            coefficients[i] = static_cast<int>(value < 0.0f ? value - 0.5f : value + 0.5f);
+        }
+
+        const int dc_difference = coefficients[0] - component.previous_dc;
+        component.previous_dc = coefficients[0];
+        const uint8_t dc_category = bit_length(dc_difference);
+        writer.write_code(*component.dc_table, dc_category);
+        write_value_bits(writer, dc_difference, dc_category);
+
+        int last_nonzero = 0;
+        for (int i = 63; i > 0; --i) {
+            if (coefficients[ZIGZAG[i]] != 0) {
+                last_nonzero = i;
+                break;
+            }
+        }
+
+        uint8_t zero_run = 0;
+        for (int i = 1; i <= last_nonzero; ++i) {
+            const int value = coefficients[ZIGZAG[i]];
+            if (value == 0) {
+                ++zero_run;
+                continue;
+            }
+            while (zero_run >= 16) {
+                writer.write_code(*component.ac_table, 0xF0); // 16 zeros.
+                zero_run = static_cast<uint8_t>(zero_run - 16);
+            }
+            const uint8_t category = bit_length(value);
+            writer.write_code(*component.ac_table, static_cast<uint8_t>(zero_run << 4 | category));
+            write_value_bits(writer, value, category);
+            zero_run = 0;
+        }
+        if (last_nonzero < 63) {
+            writer.write_code(*component.ac_table, 0x00); // End of block.
+        }
+    }
+
+    static void write_u16(std::vector<uint8_t>& out, size_t value) {
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value & 0xFF));
+    }
+
+    static void write_huffman_table(
+        std::vector<uint8_t>& out, uint8_t table_class_and_id, const uint8_t* num_codes_per_length,
+        const uint8_t* values
+    ) {
+        size_t num_values = 0;
+        for (size_t i = 0; i < 16; ++i) {
+            num_values += num_codes_per_length[i];
+        }
+        out.push_back(table_class_and_id);
+        out.insert(out.end(), num_codes_per_length, num_codes_per_length + 16);
+        out.insert(out.end(), values, values + num_values);
+    }
+
+    static void write_headers(
+        std::vector<uint8_t>& out, size_t width, size_t height, bool is_grayscale,
+        const uint8_t* luma_quantization, const uint8_t* chroma_quantization
+    ) {
+        const uint8_t num_components = is_grayscale ? 1 : 3;
+        const uint8_t num_tables = is_grayscale ? 1 : 2;
+
+        // Start of image & JFIF marker.
+        const uint8_t jfif[] = {
+            0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 'J', 'F', 'I', 'F', 0x00,
+            0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00,
+        };
+        out.insert(out.end(), std::begin(jfif), std::end(jfif));
+
+        // Quantization tables in zig-zag order.
+        out.push_back(0xFF);
+        out.push_back(0xDB);
+        write_u16(out, 2 + num_tables * 65);
+        for (uint8_t id = 0; id < num_tables; ++id) {
+            const uint8_t* table = id == 0 ? luma_quantization : chroma_quantization;
+            out.push_back(id);
+            for (size_t i = 0; i < 64; ++i) {
+                out.push_back(table[ZIGZAG[i]]);
+            }
+        }
+
+        // Baseline frame header. For color images, luma is sampled at twice the chroma
+        // resolution in both directions.
+        out.push_back(0xFF);
+        out.push_back(0xC0);
+        write_u16(out, 8 + num_components * 3);
+        out.push_back(0x08);
+        write_u16(out, height);
+        write_u16(out, width);
+        out.push_back(num_components);
+        if (is_grayscale) {
+            const uint8_t components[] = {0x01, 0x11, 0x00}; // Y
+            out.insert(out.end(), std::begin(components), std::end(components));
+        } else {
+            const uint8_t components[] = {
+                0x01, 0x22, 0x00, // Y
+                0x02, 0x11, 0x01, // Cb
+                0x03, 0x11, 0x01, // Cr
+            };
+            out.insert(out.end(), std::begin(components), std::end(components));
+        }
+
+        // Huffman tables.
+        out.push_back(0xFF);
+        out.push_back(0xC4);
+        write_u16(out, 2 + num_tables * (2 * (1 + 16) + 12 + 162));
+        write_huffman_table(out, 0x00, LUMA_DC_CODE_LENGTHS, DC_VALUES);
+        write_huffman_table(out, 0x10, LUMA_AC_CODE_LENGTHS, LUMA_AC_VALUES);
+        if (!is_grayscale) {
+            write_huffman_table(out, 0x01, CHROMA_DC_CODE_LENGTHS, DC_VALUES);
+            write_huffman_table(out, 0x11, CHROMA_AC_CODE_LENGTHS, CHROMA_AC_VALUES);
+        }
+
+        // Start of scan.
+        out.push_back(0xFF);
+        out.push_back(0xDA);
+        write_u16(out, 6 + num_components * 2);
+        out.push_back(num_components);
+        if (is_grayscale) {
+            const uint8_t components[] = {0x01, 0x00}; // Y
+            out.insert(out.end(), std::begin(components), std::end(components));
+        } else {
+            const uint8_t components[] = {
+                0x01, 0x00, // Y
+                0x02, 0x11, // Cb
+                0x03, 0x11, // Cr
+            };
+            out.insert(out.end(), std::begin(components), std::end(components));
+        }
+        const uint8_t spectral_selection[] = {0x00, 0x3F, 0x00};
+        out.insert(out.end(), std::begin(spectral_selection), std::end(spectral_selection));
+    }
+
+    Result<std::vector<uint8_t>> encode_jpeg(
+        const uint8_t* pixels, size_t width, size_t height, size_t num_channels, int quality
+    ) {
+        if (width == 0 || height == 0 || width > 0xFFFF || height > 0xFFFF) {
+            return Error(
+                ErrorCode::InvalidTensorDimension,
+                "JPEG images need to be between 1x1 and 65535x65535 pixels, got " +
+                    std::to_string(width) + "x" + std::to_string(height) + "."
+            );
+        }
+        if (num_channels != 1 && num_channels != 3 && num_channels != 4) {
+            return Error(
+                ErrorCode::InvalidTensorDimension,
+                "Only images with 1, 3 and 4 channels can be JPEG encoded, got " +
+                    std::to_string(num_channels) + " channels."
+            );
+        }
+        quality = std::clamp(quality, 1, 100);
+
+        uint8_t luma_quantization[64];
+        uint8_t chroma_quantization[64];
+        scale_quantization_table(LUMA_QUANTIZATION, quality, luma_quantization);
+        scale_quantization_table(CHROMA_QUANTIZATION, quality, chroma_quantization);
+
+        const HuffmanTable luma_dc(LUMA_DC_CODE_LENGTHS, DC_VALUES);
+        const HuffmanTable luma_ac(LUMA_AC_CODE_LENGTHS, LUMA_AC_VALUES);
+        const HuffmanTable chroma_dc(CHROMA_DC_CODE_LENGTHS, DC_VALUES);
+        const HuffmanTable chroma_ac(CHROMA_AC_CODE_LENGTHS, CHROMA_AC_VALUES);
+
+        Component y_component;
+        Component cb_component;
+        Component cr_component;
+        init_component_scale(luma_quantization, y_component);
+        init_component_scale(chroma_quantization, cb_component);
+        init_component_scale(chroma_quantization, cr_component);
+        y_component.dc_table = &luma_dc;
+        y_component.ac_table = &luma_ac;
+        cb_component.dc_table = &chroma_dc;
+        cb_component.ac_table = &chroma_ac;
+        cr_component.dc_table = &chroma_dc;
+        cr_component.ac_table = &chroma_ac;
+
+        const bool is_grayscale = num_channels == 1;
+
+        std::vector<uint8_t> out;
+        out.reserve(width * height / 4 + 1024);
+        write_headers(out, width, height, is_grayscale, luma_quantization, chroma_quantization);
+
+        // For grayscale images each MCU is a single luma block. For color images each MCU covers
+        // 16x16 pixels: four luma blocks and one block per chroma component.
+        // Pixels beyond the image are filled by repeating the last column and row.
+        const size_t mcu_size = is_grayscale ? 8 : 16;
+        const size_t padded_width = (width + mcu_size - 1) / mcu_size * mcu_size;
+        const size_t num_chroma_rows = is_grayscale ? 0 : 16;
+        std::vector<float> y_rows(mcu_size * padded_width);
+        std::vector<float> cb_rows(num_chroma_rows * padded_width);
+        std::vector<float> cr_rows(num_chroma_rows * padded_width);
+        std::vector<float> cb_subsampled(num_chroma_rows / 2 * padded_width / 2);
+        std::vector<float> cr_subsampled(num_chroma_rows / 2 * padded_width / 2);
+
+        BitWriter writer(out);
+        float block[64];
+
+        for (size_t mcu_y = 0; mcu_y < height; mcu_y += mcu_size) {
+            // Convert to level shifted YCbCr.
+            for (size_t row = 0; row < mcu_size; ++row) {
+                const size_t src_row = std::min(mcu_y + row, height - 1);
+                const uint8_t* src = pixels + src_row * width * num_channels;
+                float* y = y_rows.data() + row * padded_width;
+
+                if (is_grayscale) {
+                    for (size_t x = 0; x < width; ++x) {
+                        y[x] = static_cast<float>(src[x]) - 128.0f;
+                    }
+                    std::fill(y + width, y + padded_width, y[width - 1]);
+                } else {
+                    float* cb = cb_rows.data() + row * padded_width;
+                    float* cr = cr_rows.data() + row * padded_width;
+                    for (size_t x = 0; x < width; ++x) {
+                        const auto r = static_cast<float>(src[x * num_channels + 0]);
+                        const auto g = static_cast<float>(src[x * num_channels + 1]);
+                        const auto b = static_cast<float>(src[x * num_channels + 2]);
+                        y[x] = 0.299f * r + 0.587f * g + 0.114f * b - 128.0f;
+                        cb[x] = -0.168736f * r - 0.331264f * g + 0.5f * b;
+                        cr[x] = 0.5f * r - 0.418688f * g - 0.081312f * b;
+                    }
+                    std::fill(y + width, y + padded_width, y[width - 1]);
+                    std::fill(cb + width, cb + padded_width, cb[width - 1]);
+                    std::fill(cr + width, cr + padded_width, cr[width - 1]);
+                }
+            }
+
+            // Average 2x2 chroma pixels.
+            const size_t subsampled_width = padded_width / 2;
+            for (size_t row = 0; row < num_chroma_rows / 2; ++row) {
+                const float* cb0 = cb_rows.data() + row * 2 * padded_width;
+                const float* cb1 = cb0 + padded_width;
+                const float* cr0 = cr_rows.data() + row * 2 * padded_width;
+                const float* cr1 = cr0 + padded_width;
+                float* cb = cb_subsampled.data() + row * subsampled_width;
+                float* cr = cr_subsampled.data() + row * subsampled_width;
+                for (size_t x = 0; x < subsampled_width; ++x) {
+                    cb[x] = 0.25f * (cb0[x * 2] + cb0[x * 2 + 1] + cb1[x * 2] + cb1[x * 2 + 1]);
+                    cr[x] = 0.25f * (cr0[x * 2] + cr0[x * 2 + 1] + cr1[x * 2] + cr1[x * 2 + 1]);
+                }
+            }
+
+            const auto encode_block_at = [&](const std::vector<float>& plane,
+                                             size_t plane_width,
+                                             size_t block_x,
+                                             size_t block_y,
+                                             Component& component) {
+                for (size_t row = 0; row < 8; ++row) {
+                    const float* src = plane.data() + (block_y + row) * plane_width + block_x;
+                    std::copy(src, src + 8, block + row * 8);
+                }
+                encode_block(block, component, writer);
+            };
+
+            for (size_t mcu_x = 0; mcu_x < padded_width; mcu_x += mcu_size) {
+                encode_block_at(y_rows, padded_width, mcu_x, 0, y_component);
+                if (is_grayscale) {
+                    continue;
+                }
+                encode_block_at(y_rows, padded_width, mcu_x + 8, 0, y_component);
+                encode_block_at(y_rows, padded_width, mcu_x, 8, y_component);
+                encode_block_at(y_rows, padded_width, mcu_x + 8, 8, y_component);
+                encode_block_at(cb_subsampled, subsampled_width, mcu_x / 2, 0, cb_component);
+                encode_block_at(cr_subsampled, subsampled_width, mcu_x / 2, 0, cr_component);
+            }
+        }
+
+        writer.flush();
+
+        // End of image.
+        out.push_back(0xFF);
+        out.push_back(0xD9);
+
+        return out;
+    }
+
+    archetypes::Image jpeg_image(
+        const uint8_t* pixels, size_t width, size_t height, size_t num_channels, int quality
+    ) {
+        auto jpeg = encode_jpeg(pixels, width, height, num_channels, quality);
+        if (jpeg.is_err()) {
+            jpeg.error.handle();
+            return archetypes::Image();
+        }
+
+        // Color JPEG images are decoded to RGB, dropping alpha.
+        const size_t num_decoded_channels = num_channels == 1 ? 1 : 3;
+        return archetypes::Image(
+            {height, width, num_decoded_channels},
+            datatypes::TensorBuffer::jpeg(
+                Collection<uint8_t>::take_ownership(std::move(jpeg.value))
+            )
+        );
+    }
+} // namespace rerun::image
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "archetypes/image.hpp"
+#include "result.hpp"
+
+namespace rerun {
+    namespace image {
+        /// Encodes 8-bit pixels as a baseline JPEG, color images with 4:2:0 chroma subsampling.
+        ///
+        /// Grayscale pixels are encoded as a single component JPEG.
+        ///
+        /// Raw camera images are typically an order of magnitude larger than their JPEG encoding.
+        /// This encoder has no external dependencies, if you already link against an optimized
+        /// JPEG library (e.g. libjpeg-turbo) it will be faster.
+        ///
+        /// \param pixels Tightly packed pixels, row by row.
+        /// \param width Width of the image in pixels.
+        /// \param height Height of the image in pixels.
+        /// \param num_channels 1 for grayscale, 3 for RGB or 4 for RGBA. Alpha is dropped.
+        /// \param quality JPEG quality between 1 and 100, values outside are clamped.
+        Result<std::vector<uint8_t>> encode_jpeg(
+            const uint8_t* pixels, size_t width, size_t height, size_t num_channels,
+            int quality = 75
+        );
+
+        /// Creates a JPEG compressed image from 8-bit pixels.
+        ///
+        /// Calls `Error::handle()` and returns an empty image if the pixels can't be encoded.
+        /// \see encode_jpeg
+        archetypes::Image jpeg_image(
+            const uint8_t* pixels, size_t width, size_t height, size_t num_channels,
+            int quality = 75
+        );
+    } // namespace image
+} // namespace rerun
@@ -0,0 +1,192 @@
+#include "pointcloud.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "error.hpp"
+#include "shared_array.hpp"
+
+// Points are bucketed by an LSD radix sort of their voxel coordinates instead of a hash map:
+// every pass streams linearly through the points, and passes over digits that are the same for
+// all points are skipped, so a scan spanning fewer than 65536 voxels per axis takes three passes.
+
+namespace rerun::pointcloud {
+    /// Voxel coordinates of a point, relative to the smallest occupied voxel.
+    struct VoxelPoint {
+        std::array<uint32_t, 3> voxel;
+        uint32_t point;
+    };
+
+    static bool is_finite(const components::Position3D& position) {
+        const auto& xyz = position.xyz.xyz;
+        return std::isfinite(xyz[0]) && std::isfinite(xyz[1]) && std::isfinite(xyz[2]);
+    }
+
+    constexpr size_t RADIX_BITS = 16;
+    constexpr size_t RADIX_SIZE = size_t{1} << RADIX_BITS;
+
+    /// Sorts points by z, then y, then x voxel coordinate.
+    static void radix_sort(std::vector<VoxelPoint>& points) {
+        std::vector<VoxelPoint> sorted(points.size());
+        std::vector<size_t> offsets(RADIX_SIZE);
+
+        for (size_t axis = 0; axis < 3; ++axis) {
+            for (size_t shift = 0; shift < 32; shift += RADIX_BITS) {
+                const auto digit = [&](const VoxelPoint& point) {
+                    return (point.voxel[axis] >> shift) & (RADIX_SIZE - 1);
+                };
+
+                std::fill(offsets.begin(), offsets.end(), 0);
+                for (const auto& point : points) {
+                    ++offsets[digit(point)];
+                }
+                if (offsets[digit(points.front())] == points.size()) {
+                    continue;
+                }
+
+                size_t offset = 0;
+                for (auto& count : offsets) {
+                    const size_t bucket_size = count;
+                    count = offset;
+                    offset += bucket_size;
+                }
+                for (const auto& point : points) {
+                    sorted[offsets[digit(point)]++] = point;
+                }
+                points.swap(sorted);
+            }
+        }
+    }
+
+    Result<VoxelDownsampled> voxel_downsample(
+        const Collection<components::Position3D>& positions,
+        const Collection<components::Color>& colors, float voxel_size
+    ) {
+        if (!(voxel_size > 0.0f) || !std::isfinite(voxel_size)) {
+            return Error(
+                ErrorCode::InvalidPointCloud,
+                "Voxel size must be positive, got " + std::to_string(voxel_size) + "."
+            );
+        }
+        const bool has_colors = colors.size() > 1;
+        if (has_colors && colors.size() != positions.size()) {
+            return Error(
+                ErrorCode::InvalidPointCloud,
+                "Expected one color per position, got " + std::to_string(colors.size()) +
+                    " colors for " + std::to_string(positions.size()) + " positions."
+            );
+        }
+        if (positions.size() > std::numeric_limits<uint32_t>::max()) {
+            return Error(
+                ErrorCode::InvalidPointCloud,
+                "Point clouds with more than 2^32 points can't be downsampled."
+            );
+        }
+
+        // Voxel coordinates are computed in double precision to stay exact for large scans
+        // with small voxels.
+        const double inv_voxel_size = 1.0 / static_cast<double>(voxel_size);
+        std::array<double, 3> min_voxel;
+        min_voxel.fill(std::numeric_limits<double>::infinity());
+        for (const auto& position : positions) {
+            if (!is_finite(position)) {
+                continue;
+            }
+            for (size_t axis = 0; axis < 3; ++axis) {
+                min_voxel[axis] =
+                    std::min(min_voxel[axis], std::floor(position.xyz.xyz[axis] * inv_voxel_size));
+            }
+        }
+
+        std::vector<VoxelPoint> points;
+        points.reserve(positions.size());
+        constexpr double MAX_VOXEL = std::numeric_limits<uint32_t>::max();
+        for (size_t i = 0; i < positions.size(); ++i) {
+            if (!is_finite(positions[i])) {
+                continue;
+            }
+            const auto& xyz = positions[i].xyz.xyz;
+            VoxelPoint point;
+            for (size_t axis = 0; axis < 3; ++axis) {
+                const double voxel = std::floor(xyz[axis] * inv_voxel_size) - min_voxel[axis];
+                point.voxel[axis] = static_cast<uint32_t>(std::min(voxel, MAX_VOXEL));
+            }
+            point.point = static_cast<uint32_t>(i);
+            points.push_back(point);
+        }
+        if (points.empty()) {
+            return VoxelDownsampled{{}, has_colors ? Collection<components::Color>() : colors};
+        }
+
+        radix_sort(points);
+
+        size_t num_voxels = 1;
+        for (size_t i = 1; i < points.size(); ++i) {
+            num_voxels += points[i].voxel != points[i - 1].voxel;
+        }
+
+        auto downsampled_positions =
+            detail::allocate_shared_array<components::Position3D>(num_voxels);
+        std::shared_ptr<components::Color> downsampled_colors;
+        if (has_colors) {
+            downsampled_colors = detail::allocate_shared_array<components::Color>(num_voxels);
+        }
+
+        size_t voxel_index = 0;
+        for (size_t begin = 0; begin < points.size();) {
+            size_t end = begin + 1;
+            while (end < points.size() && points[end].voxel == points[begin].voxel) {
+                ++end;
+            }
+            const size_t count = end - begin;
+
+            std::array<double, 3> position_sum = {0.0, 0.0, 0.0};
+            std::array<uint64_t, 4> color_sum = {0, 0, 0, 0};
+            for (size_t i = begin; i < end; ++i) {
+                const auto& xyz = positions[points[i].point].xyz.xyz;
+                for (size_t axis = 0; axis < 3; ++axis) {
+                    position_sum[axis] += xyz[axis];
+                }
+                if (has_colors) {
+                    const auto& color = colors[points[i].point];
+                    color_sum[0] += color.r();
+                    color_sum[1] += color.g();
+                    color_sum[2] += color.b();
+                    color_sum[3] += color.a();
+                }
+            }
+
+            const auto mean = [&](size_t axis) {
+                return static_cast<float>(position_sum[axis] / static_cast<double>(count));
+            };
+            downsampled_positions.get()[voxel_index] =
+                components::Position3D(mean(0), mean(1), mean(2));
+            if (has_colors) {
+                const auto channel = [&](size_t c) {
+                    return static_cast<uint8_t>((color_sum[c] + count / 2) / count);
+                };
+                downsampled_colors.get()[voxel_index] =
+                    components::Color(channel(0), channel(1), channel(2), channel(3));
+            }
+
+            ++voxel_index;
+            begin = end;
+        }
+
+        VoxelDownsampled downsampled;
+        downsampled.positions =
+            Collection<components::Position3D>::share(std::move(downsampled_positions), num_voxels);
+        if (has_colors) {
+            downsampled.colors =
+                Collection<components::Color>::share(std::move(downsampled_colors), num_voxels);
+        } else {
+            downsampled.colors = colors;
+        }
+        return downsampled;
+    }
+} // namespace rerun::pointcloud
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "collection.hpp"
+#include "components/color.hpp"
+#include "components/position3d.hpp"
+#include "result.hpp"
+
+namespace rerun {
+    /// Processing of point clouds before logging, e.g. to thin out dense LiDAR scans.
+    namespace pointcloud {
+        /// Point cloud with at most one point per voxel.
+        struct VoxelDownsampled {
+            Collection<components::Position3D> positions;
+
+            /// One color per position, or as many colors as were passed in if there were
+            /// fewer than two.
+            Collection<components::Color> colors;
+        };
+
+        /// Downsamples a point cloud to one point per occupied voxel of a regular grid.
+        ///
+        /// Each voxel is represented by the centroid of its points, with their average color.
+        /// Points are ordered by voxel, which keeps neighboring points close in memory.
+        /// Points with non-finite coordinates are dropped.
+        ///
+        /// The points are bucketed by sorting their voxel coordinates with a radix sort, which
+        /// only takes a few linear passes over the point cloud for the voxel counts of
+        /// typical scans.
+        ///
+        /// \param colors Either one color per position, a single color for all positions or none.
+        /// \param voxel_size Edge length of the voxels, must be positive.
+        /// \returns An error if the voxel size isn't positive or the number of colors doesn't
+        /// match the number of positions.
+        Result<VoxelDownsampled> voxel_downsample(
+            const Collection<components::Position3D>& positions,
+            const Collection<components::Color>& colors, float voxel_size
+        );
+
+        /// \copydoc voxel_downsample
+        inline Result<VoxelDownsampled> voxel_downsample(
+            const Collection<components::Position3D>& positions, float voxel_size
+        ) {
+            return voxel_downsample(positions, Collection<components::Color>(), voxel_size);
+        }
+    } // namespace pointcloud
+} // namespace rerun
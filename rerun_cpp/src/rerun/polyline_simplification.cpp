@@ -0,0 +1,263 @@
+#include "polyline_simplification.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "shared_array.hpp"
+
+namespace rerun::polyline {
+    static const std::array<float, 2>& coordinates(const datatypes::Vec2D& point) {
+        return point.xy;
+    }
+
+    static const std::array<float, 3>& coordinates(const datatypes::Vec3D& point) {
+        return point.xyz;
+    }
+
+    /// Squared distance of `point` to the segment from `start` to `end`.
+    template <size_t N>
+    static double squared_segment_distance(
+        const std::array<float, N>& point, const std::array<float, N>& start,
+        const std::array<float, N>& end
+    ) {
+        double segment_length_sq = 0.0;
+        double projection = 0.0;
+        for (size_t i = 0; i < N; ++i) {
+            const double segment = static_cast<double>(end[i]) - start[i];
+            segment_length_sq += segment * segment;
+            projection += segment * (static_cast<double>(point[i]) - start[i]);
+        }
+        const double t =
+            segment_length_sq > 0.0 ? std::clamp(projection / segment_length_sq, 0.0, 1.0) : 0.0;
+
+        double distance_sq = 0.0;
+        for (size_t i = 0; i < N; ++i) {
+            const double closest = start[i] + t * (static_cast<double>(end[i]) - start[i]);
+            const double offset = point[i] - closest;
+            distance_sq += offset * offset;
+        }
+        return distance_sq;
+    }
+
+    /// Area of the triangle spanned by three points, in any dimension.
+    template <size_t N>
+    static double triangle_area(
+        const std::array<float, N>& a, const std::array<float, N>& b, const std::array<float, N>& c
+    ) {
+        // |u x v|^2 = |u|^2 |v|^2 - (u . v)^2
+        double uu = 0.0;
+        double vv = 0.0;
+        double uv = 0.0;
+        for (size_t i = 0; i < N; ++i) {
+            const double u = static_cast<double>(b[i]) - a[i];
+            const double v = static_cast<double>(c[i]) - a[i];
+            uu += u * u;
+            vv += v * v;
+            uv += u * v;
+        }
+        return 0.5 * std::sqrt(std::max(uu * vv - uv * uv, 0.0));
+    }
+
+    /// Marks the points kept by the Ramer-Douglas-Peucker algorithm.
+    ///
+    /// Uses an explicit stack since long, detailed line strips would overflow the call stack.
+    template <typename TPoint>
+    static void ramer_douglas_peucker(
+        const TPoint* points, size_t num_points, float tolerance, std::vector<bool>& keep
+    ) {
+        const double tolerance_sq = static_cast<double>(tolerance) * tolerance;
+
+        std::vector<std::pair<size_t, size_t>> ranges = {{0, num_points - 1}};
+        while (!ranges.empty()) {
+            const auto [first, last] = ranges.back();
+            ranges.pop_back();
+
+            double max_distance_sq = -1.0;
+            size_t farthest = first;
+            for (size_t i = first + 1; i < last; ++i) {
+                const double distance_sq = squared_segment_distance(
+                    coordinates(points[i]),
+                    coordinates(points[first]),
+                    coordinates(points[last])
+                );
+                if (distance_sq > max_distance_sq) {
+                    max_distance_sq = distance_sq;
+                    farthest = i;
+                }
+            }
+
+            if (max_distance_sq > tolerance_sq) {
+                keep[farthest] = true;
+                ranges.emplace_back(first, farthest);
+                ranges.emplace_back(farthest, last);
+            }
+        }
+    }
+
+    /// Marks the points kept by the Visvalingam-Whyatt algorithm.
+    template <typename TPoint>
+    static void visvalingam(
+        const TPoint* points, size_t num_points, float tolerance, std::vector<bool>& keep
+    ) {
+        const double min_area = static_cast<double>(tolerance) * tolerance;
+
+        // Doubly linked list of the remaining points.
+        std::vector<size_t> prev(num_points);
+        std::vector<size_t> next(num_points);
+        std::vector<double> areas(num_points);
+        using AreaEntry = std::pair<double, size_t>;
+        std::priority_queue<AreaEntry, std::vector<AreaEntry>, std::greater<AreaEntry>> queue;
+
+        for (size_t i = 1; i + 1 < num_points; ++i) {
+            prev[i] = i - 1;
+            next[i] = i + 1;
+            areas[i] = triangle_area(
+                coordinates(points[i - 1]),
+                coordinates(points[i]),
+                coordinates(points[i + 1])
+            );
+            keep[i] = true;
+            queue.emplace(areas[i], i);
+        }
+
+        while (!queue.empty()) {
+            const auto [area, i] = queue.top();
+            queue.pop();
+            // Skip entries of removed points and outdated areas.
+            if (!keep[i] || area != areas[i]) {
+                continue;
+            }
+            if (area >= min_area) {
+                break;
+            }
+
+            keep[i] = false;
+            const size_t before = prev[i];
+            const size_t after = next[i];
+            next[before] = after;
+            prev[after] = before;
+
+            // The area of a neighbor never drops below the area of the removed point, otherwise
+            // the neighbor would be removed before points that are less significant.
+            for (const size_t neighbor : {before, after}) {
+                if (neighbor == 0 || neighbor == num_points - 1) {
+                    continue;
+                }
+                const double neighbor_area = triangle_area(
+                    coordinates(points[prev[neighbor]]),
+                    coordinates(points[neighbor]),
+                    coordinates(points[next[neighbor]])
+                );
+                areas[neighbor] = std::max(neighbor_area, area);
+                queue.emplace(areas[neighbor], neighbor);
+            }
+        }
+    }
+
+    template <typename TPoint>
+    static size_t simplify_points(
+        const TPoint* points, size_t num_points, float tolerance, SimplificationMethod method,
+        TPoint* simplified
+    ) {
+        if (num_points <= 2) {
+            std::copy(points, points + num_points, simplified);
+            return num_points;
+        }
+
+        std::vector<bool> keep(num_points, false);
+        keep.front() = true;
+        keep.back() = true;
+        switch (method) {
+            case SimplificationMethod::RamerDouglasPeucker:
+                ramer_douglas_peucker(points, num_points, tolerance, keep);
+                break;
+            case SimplificationMethod::Visvalingam:
+                visvalingam(points, num_points, tolerance, keep);
+                break;
+        }
+
+        size_t num_kept = 0;
+        for (size_t i = 0; i < num_points; ++i) {
+            if (keep[i]) {
+                simplified[num_kept++] = points[i];
+            }
+        }
+        return num_kept;
+    }
+
+    size_t simplify(
+        const datatypes::Vec2D* points, size_t num_points, float tolerance,
+        SimplificationMethod method, datatypes::Vec2D* simplified
+    ) {
+        return simplify_points(points, num_points, tolerance, method, simplified);
+    }
+
+    size_t simplify(
+        const datatypes::Vec3D* points, size_t num_points, float tolerance,
+        SimplificationMethod method, datatypes::Vec3D* simplified
+    ) {
+        return simplify_points(points, num_points, tolerance, method, simplified);
+    }
+
+    template <typename TStrip, typename TPoint>
+    static Collection<TStrip> simplify_strips(
+        const Collection<TStrip>& strips, float tolerance, SimplificationMethod method
+    ) {
+        size_t num_points = 0;
+        for (const auto& strip : strips) {
+            num_points += strip.points.size();
+        }
+
+        auto points = detail::allocate_shared_array<TPoint>(num_points);
+        auto simplified_strips = detail::allocate_shared_array<TStrip>(strips.size());
+
+        size_t offset = 0;
+        for (size_t i = 0; i < strips.size(); ++i) {
+            const auto& strip_points = strips[i].points;
+            TPoint* simplified = points.get() + offset;
+            const size_t num_kept = simplify_points(
+                strip_points.data(),
+                strip_points.size(),
+                tolerance,
+                method,
+                simplified
+            );
+            // Each strip shares ownership of the common point buffer.
+            simplified_strips.get()[i].points = Collection<TPoint>::share(
+                std::shared_ptr<const TPoint>(points, simplified),
+                num_kept
+            );
+            offset += num_kept;
+        }
+
+        return Collection<TStrip>::share(std::move(simplified_strips), strips.size());
+    }
+
+    Collection<components::LineStrip2D> simplify(
+        const Collection<components::LineStrip2D>& strips, float tolerance,
+        SimplificationMethod method
+    ) {
+        return simplify_strips<components::LineStrip2D, datatypes::Vec2D>(
+            strips,
+            tolerance,
+            method
+        );
+    }
+
+    Collection<components::LineStrip3D> simplify(
+        const Collection<components::LineStrip3D>& strips, float tolerance,
+        SimplificationMethod method
+    ) {
+        return simplify_strips<components::LineStrip3D, datatypes::Vec3D>(
+            strips,
+            tolerance,
+            method
+        );
+    }
+} // namespace rerun::polyline
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+
+#include "collection.hpp"
+#include "components/line_strip2d.hpp"
+#include "components/line_strip3d.hpp"
+#include "datatypes/vec2d.hpp"
+#include "datatypes/vec3d.hpp"
+
+namespace rerun {
+    /// Simplification of line strips, e.g. to thin out long trajectories or contours with many
+    /// nearly collinear points before logging.
+    namespace polyline {
+        /// How a line strip is simplified.
+        enum class SimplificationMethod {
+            /// Ramer-Douglas-Peucker: keeps the fewest points such that no removed point is
+            /// farther than the tolerance from the simplified line strip.
+            ///
+            /// Preserves sharp features well.
+            RamerDouglasPeucker,
+
+            /// Visvalingam-Whyatt: repeatedly removes the point whose triangle with its neighbors
+            /// has the smallest area, as long as that area is below `tolerance * tolerance`.
+            ///
+            /// Gives smoother results than Ramer-Douglas-Peucker for noisy line strips.
+            Visvalingam,
+        };
+
+        /// Simplifies a single line strip, writing the kept points to `simplified`.
+        ///
+        /// The first and last point are always kept.
+        /// `simplified` has to hold `num_points` points and must not overlap with `points`.
+        /// \returns The number of kept points.
+        size_t simplify(
+            const datatypes::Vec2D* points, size_t num_points, float tolerance,
+            SimplificationMethod method, datatypes::Vec2D* simplified
+        );
+
+        /// \copydoc simplify
+        size_t simplify(
+            const datatypes::Vec3D* points, size_t num_points, float tolerance,
+            SimplificationMethod method, datatypes::Vec3D* simplified
+        );
+
+        /// Simplifies a batch of line strips.
+        ///
+        /// The points of all simplified strips are stored in a single buffer, each strip refers
+        /// to its range of it.
+        Collection<components::LineStrip2D> simplify(
+            const Collection<components::LineStrip2D>& strips, float tolerance,
+            SimplificationMethod method = SimplificationMethod::RamerDouglasPeucker
+        );
+
+        /// Simplifies a batch of line strips.
+        ///
+        /// The points of all simplified strips are stored in a single buffer, each strip refers
+        /// to its range of it.
+        Collection<components::LineStrip3D> simplify(
+            const Collection<components::LineStrip3D>& strips, float tolerance,
+            SimplificationMethod method = SimplificationMethod::RamerDouglasPeucker
+        );
+    } // namespace polyline
+} // namespace rerun
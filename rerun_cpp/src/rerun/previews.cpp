@@ -0,0 +1,190 @@
+#include "previews.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "archetypes/depth_image.hpp"
+#include "archetypes/image.hpp"
+#include "archetypes/points3d.hpp"
+#include "archetypes/scalar.hpp"
+#include "as_components.hpp"
+#include "entity_path_policies.hpp"
+#include "image_downscale.hpp"
+
+namespace rerun::detail {
+    /// Previews are logged to the same entity path under `preview/`.
+    static std::string preview_entity_path(std::string_view entity_path) {
+        if (!entity_path.empty() && entity_path.front() == '/') {
+            entity_path.remove_prefix(1);
+        }
+        return "preview/" + std::string(entity_path);
+    }
+
+    /// Serializes the only preview of an archetype.
+    template <typename T>
+    static Result<std::vector<PreviewBatches>> single_preview(
+        std::string preview_path, const T& preview
+    ) {
+        auto batches = AsComponents<T>().serialize(preview);
+        RR_RETURN_NOT_OK(batches.error);
+
+        std::vector<PreviewBatches> previews;
+        previews.push_back({std::move(preview_path), std::move(batches.value)});
+        return previews;
+    }
+
+    Result<std::vector<PreviewBatches>> Preview<archetypes::Image>::admitted_previews(
+        EntityPathPolicies& policies, std::string_view entity_path, const archetypes::Image& image
+    ) {
+        const size_t factor = policies.preview_factor(entity_path);
+        // Unsupported images are common in a stream of images, e.g. JPEG compressed ones, and
+        // simply don't have a preview.
+        if (factor == 0 || !image::is_downscale_supported(image.data.data)) {
+            return std::vector<PreviewBatches>();
+        }
+        auto preview_path = preview_entity_path(entity_path);
+        if (!policies.admit(preview_path)) {
+            return std::vector<PreviewBatches>();
+        }
+
+        auto data = image::downscale_image_data(image.data.data, factor);
+        RR_RETURN_NOT_OK(data.error);
+        archetypes::Image preview(std::move(data.value));
+        preview.draw_order = image.draw_order;
+        return single_preview(std::move(preview_path), preview);
+    }
+
+    Result<std::vector<PreviewBatches>> Preview<archetypes::DepthImage>::admitted_previews(
+        EntityPathPolicies& policies, std::string_view entity_path,
+        const archetypes::DepthImage& depth_image
+    ) {
+        const size_t factor = policies.preview_factor(entity_path);
+        if (factor == 0 || !image::is_depth_downscale_supported(depth_image.data.data)) {
+            return std::vector<PreviewBatches>();
+        }
+        auto preview_path = preview_entity_path(entity_path);
+        if (!policies.admit(preview_path)) {
+            return std::vector<PreviewBatches>();
+        }
+
+        auto data = image::downscale_depth_image_data(
+            depth_image.data.data,
+            factor,
+            policies.preview_depth_mode(entity_path)
+        );
+        RR_RETURN_NOT_OK(data.error);
+        archetypes::DepthImage preview(std::move(data.value));
+        preview.meter = depth_image.meter;
+        preview.draw_order = depth_image.draw_order;
+        return single_preview(std::move(preview_path), preview);
+    }
+
+    Result<std::vector<PreviewBatches>> Preview<archetypes::Points3D>::admitted_previews(
+        EntityPathPolicies& policies, std::string_view entity_path,
+        const archetypes::Points3D& points
+    ) {
+        const float voxel_size = policies.preview_voxel_size(entity_path);
+        if (voxel_size == 0.0f) {
+            return std::vector<PreviewBatches>();
+        }
+        auto preview_path = preview_entity_path(entity_path);
+        if (!policies.admit(preview_path)) {
+            return std::vector<PreviewBatches>();
+        }
+
+        const auto preview = points.try_voxel_downsampled(voxel_size);
+        RR_RETURN_NOT_OK(preview.error);
+        return single_preview(std::move(preview_path), preview.value);
+    }
+
+    Result<std::vector<PreviewBatches>> Preview<archetypes::Scalar>::admitted_previews(
+        EntityPathPolicies& policies, std::string_view entity_path,
+        const archetypes::Scalar& scalar
+    ) {
+        const auto min_max = policies.add_preview_scalar(entity_path, scalar.scalar.value);
+        if (!min_max.has_value()) {
+            return std::vector<PreviewBatches>();
+        }
+
+        // Separate entities, such that both form a continuous line.
+        const auto preview_path = preview_entity_path(entity_path);
+        const std::pair<const char*, double> children[] = {
+            {"/min", std::min(min_max->first, min_max->second)},
+            {"/max", std::max(min_max->first, min_max->second)},
+        };
+        std::vector<PreviewBatches> previews;
+        for (const auto& [name, value] : children) {
+            auto child_path = preview_path + name;
+            if (!policies.admit(child_path)) {
+                continue;
+            }
+
+            auto batches = AsComponents<archetypes::Scalar>().serialize(archetypes::Scalar(value));
+            RR_RETURN_NOT_OK(batches.error);
+            previews.push_back({std::move(child_path), std::move(batches.value)});
+        }
+        return previews;
+    }
+
+    Result<std::vector<TemporalPreviewBatches>>
+        TemporalPreview<Collection<components::Scalar>>::admitted_previews(
+            EntityPathPolicies& policies, std::string_view entity_path,
+            const TimeColumn& time_column, const Collection<components::Scalar>& scalars
+        ) {
+        // A single scalar shared by all rows doesn't add to the series.
+        if (scalars.size() != time_column.times.size()) {
+            return std::vector<TemporalPreviewBatches>();
+        }
+        const auto windows =
+            policies.add_preview_scalars(entity_path, scalars.data(), scalars.size());
+        if (windows.empty()) {
+            return std::vector<TemporalPreviewBatches>();
+        }
+
+        // Each window is logged at the time of the scalar that completed it.
+        std::vector<int64_t> times;
+        std::vector<components::Scalar> mins;
+        std::vector<components::Scalar> maxs;
+        times.reserve(windows.size());
+        mins.reserve(windows.size());
+        maxs.reserve(windows.size());
+        for (const auto& [index, min_max] : windows) {
+            times.push_back(time_column.times[index]);
+            mins.emplace_back(std::min(min_max.first, min_max.second));
+            maxs.emplace_back(std::max(min_max.first, min_max.second));
+        }
+        const TimeColumn preview_time_column(
+            time_column.timeline_name,
+            time_column.time_type,
+            Collection<int64_t>::take_ownership(std::move(times))
+        );
+
+        const auto preview_path = preview_entity_path(entity_path);
+        std::pair<const char*, std::vector<components::Scalar>> children[] = {
+            {"/min", std::move(mins)},
+            {"/max", std::move(maxs)},
+        };
+        std::vector<TemporalPreviewBatches> previews;
+        for (auto& [name, values] : children) {
+            auto child_path = preview_path + name;
+            if (!policies.admit(child_path)) {
+                continue;
+            }
+
+            auto values_cell = DataCell::from_loggable<components::Scalar>(
+                Collection<components::Scalar>::take_ownership(std::move(values))
+            );
+            RR_RETURN_NOT_OK(values_cell.error);
+            auto indicator_cell = DataCell::from_loggable<archetypes::Scalar::IndicatorComponent>(
+                archetypes::Scalar::IndicatorComponent()
+            );
+            RR_RETURN_NOT_OK(indicator_cell.error);
+
+            std::vector<DataCell> batches;
+            batches.push_back(std::move(values_cell.value));
+            batches.push_back(std::move(indicator_cell.value));
+            previews.push_back({std::move(child_path), preview_time_column, std::move(batches)});
+        }
+        return previews;
+    }
+} // namespace rerun::detail
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "collection.hpp"
+#include "data_cell.hpp"
+#include "result.hpp"
+#include "time_column.hpp"
+
+namespace rerun {
+    namespace archetypes {
+        struct DepthImage;
+        struct Image;
+        struct Points3D;
+        struct Scalar;
+    } // namespace archetypes
+
+    namespace components {
+        struct Scalar;
+    }
+
+    namespace detail {
+        class EntityPathPolicies;
+
+        /// Serialized preview of logged data, to be logged to its own entity path.
+        struct PreviewBatches {
+            std::string entity_path;
+            std::vector<DataCell> batches;
+        };
+
+        /// Serialized preview of many rows logged at once, to be logged to its own entity path.
+        struct TemporalPreviewBatches {
+            std::string entity_path;
+            TimeColumn time_column;
+            std::vector<DataCell> batches;
+        };
+
+        /// Computes the previews of data logged with `RecordingStream::log`, see
+        /// `RecordingStream::enable_previews`.
+        ///
+        /// Only types specialized below have previews.
+        ///
+        /// Internal, not part of the public API.
+        template <typename T>
+        struct Preview {
+            /// Returns the previews of `data` whose entity paths pass the entity path filter and
+            /// rate limits, which counts as a log call to them.
+            static Result<std::vector<PreviewBatches>> admitted_previews(
+                EntityPathPolicies&, std::string_view, const T&
+            ) {
+                return std::vector<PreviewBatches>();
+            }
+        };
+
+        template <>
+        struct Preview<archetypes::Image> {
+            static Result<std::vector<PreviewBatches>> admitted_previews(
+                EntityPathPolicies& policies, std::string_view entity_path,
+                const archetypes::Image& image
+            );
+        };
+
+        template <>
+        struct Preview<archetypes::DepthImage> {
+            static Result<std::vector<PreviewBatches>> admitted_previews(
+                EntityPathPolicies& policies, std::string_view entity_path,
+                const archetypes::DepthImage& depth_image
+            );
+        };
+
+        template <>
+        struct Preview<archetypes::Points3D> {
+            static Result<std::vector<PreviewBatches>> admitted_previews(
+                EntityPathPolicies& policies, std::string_view entity_path,
+                const archetypes::Points3D& points
+            );
+        };
+
+        template <>
+        struct Preview<archetypes::Scalar> {
+            static Result<std::vector<PreviewBatches>> admitted_previews(
+                EntityPathPolicies& policies, std::string_view entity_path,
+                const archetypes::Scalar& scalar
+            );
+        };
+
+        /// Computes the previews of component batches logged with
+        /// `RecordingStream::log_temporal_batch`.
+        ///
+        /// Only types specialized below have previews.
+        ///
+        /// Internal, not part of the public API.
+        template <typename T>
+        struct TemporalPreview {
+            /// Returns the previews of `component_batch` whose entity paths pass the entity path
+            /// filter and rate limits, which counts as a log call to them.
+            static Result<std::vector<TemporalPreviewBatches>> admitted_previews(
+                EntityPathPolicies&, std::string_view, const TimeColumn&, const T&
+            ) {
+                return std::vector<TemporalPreviewBatches>();
+            }
+        };
+
+        template <>
+        struct TemporalPreview<Collection<components::Scalar>> {
+            static Result<std::vector<TemporalPreviewBatches>> admitted_previews(
+                EntityPathPolicies& policies, std::string_view entity_path,
+                const TimeColumn& time_column, const Collection<components::Scalar>& scalars
+            );
+        };
+    } // namespace detail
+} // namespace rerun
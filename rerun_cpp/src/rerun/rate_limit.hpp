@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace rerun {
+    /// Which log calls are kept when a rate limit suppresses logging to an entity.
+    ///
+    /// \see RecordingStream::set_rate_limit
+    enum class RateLimitMode {
+        /// Keep the first log call of every rate limit period.
+        KeepFirst,
+
+        /// Keep the last log call of every rate limit period.
+        ///
+        /// Whether a call is the last one of its period is predicted from the average interval
+        /// between log calls, which is exact for sources logging at a regular rate.
+        /// If a period passes without any logged call, the next call is kept regardless.
+        KeepLatest,
+    };
+
+    /// Statistics of a single rate limit of a `RecordingStream`.
+    ///
+    /// \see RecordingStream::rate_limit_stats
+    struct RateLimitStats {
+        /// Entity path pattern the rate limit applies to.
+        std::string entity_path_pattern;
+
+        /// Maximum number of log calls per second and entity.
+        double max_rate_hz;
+
+        /// Which calls are kept.
+        RateLimitMode mode;
+
+        /// Number of log calls that passed the rate limit.
+        uint64_t num_logged;
+
+        /// Number of log calls that were dropped by the rate limit.
+        uint64_t num_suppressed;
+    };
+} // namespace rerun
@@ -1,14 +1,22 @@
 #include "recording_stream.hpp"
 #include "c/rerun.h"
+#include "components/clear_is_recursive.hpp"
 #include "components/instance_key.hpp"
 #include "config.hpp"
 #include "data_cell.hpp"
+#include "entity_path_policies.hpp"
 #include "sdk_info.hpp"
 #include "string_utils.hpp"
 
+#include <arrow/array/array_primitive.h>
 #include <arrow/buffer.h>
 
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
 #include <string> // to_string
+#include <utility>
 #include <vector>
 
 namespace rerun {
@@ -32,7 +40,8 @@ namespace rerun {
     RecordingStream::RecordingStream(
         std::string_view app_id, std::string_view recording_id, StoreKind store_kind
     )
-        : _store_kind(store_kind) {
+        : _store_kind(store_kind),
+          _entity_path_policies(std::make_unique<detail::EntityPathPolicies>()) {
         check_binary_and_header_version_match().handle();
 
         rr_store_info store_info;
@@ -53,13 +62,18 @@ namespace rerun {
     }
 
     RecordingStream::RecordingStream(RecordingStream&& other)
-        : _id(other._id), _store_kind(other._store_kind), _enabled(other._enabled) {
+        : _id(other._id),
+          _store_kind(other._store_kind),
+          _enabled(other._enabled),
+          _entity_path_policies(std::move(other._entity_path_policies)) {
         // Set to `RR_REC_STREAM_CURRENT_RECORDING` since it's a no-op on destruction.
         other._id = RR_REC_STREAM_CURRENT_RECORDING;
     }
 
     RecordingStream::RecordingStream(uint32_t id, StoreKind store_kind)
-        : _id(id), _store_kind(store_kind) {
+        : _id(id),
+          _store_kind(store_kind),
+          _entity_path_policies(std::make_unique<detail::EntityPathPolicies>()) {
         check_binary_and_header_version_match().handle();
 
         rr_error status = {};
@@ -103,6 +117,176 @@ namespace rerun {
         }
     }
 
+    void RecordingStream::set_entity_path_filter(EntityPathFilter filter) const {
+        if (_entity_path_policies) {
+            _entity_path_policies->set_filter(std::move(filter));
+        }
+    }
+
+    Error RecordingStream::try_set_entity_path_filter(std::string_view rules) const {
+        auto filter = EntityPathFilter::parse(rules);
+        RR_RETURN_NOT_OK(filter.error);
+        set_entity_path_filter(std::move(filter.value));
+        return Error::ok();
+    }
+
+    Error RecordingStream::try_set_rate_limit(
+        std::string_view entity_path_pattern, double max_rate_hz, RateLimitMode mode
+    ) const {
+        if (!std::isfinite(max_rate_hz) || max_rate_hz <= 0.0) {
+            return Error(
+                ErrorCode::InvalidRateLimit,
+                "Rate limit has to be a positive number of log calls per second, got " +
+                    std::to_string(max_rate_hz) + "."
+            );
+        }
+        auto pattern = EntityPathPattern::parse(entity_path_pattern);
+        RR_RETURN_NOT_OK(pattern.error);
+
+        if (_entity_path_policies) {
+            _entity_path_policies->set_rate_limit(
+                entity_path_pattern,
+                std::move(pattern.value),
+                max_rate_hz,
+                mode
+            );
+        }
+        return Error::ok();
+    }
+
+    void RecordingStream::clear_rate_limits() const {
+        if (_entity_path_policies) {
+            _entity_path_policies->clear_rate_limits();
+        }
+    }
+
+    std::vector<RateLimitStats> RecordingStream::rate_limit_stats() const {
+        if (_entity_path_policies) {
+            return _entity_path_policies->rate_limit_stats();
+        }
+        return {};
+    }
+
+    Error RecordingStream::try_enable_change_detection(std::string_view entity_path_pattern) const {
+        auto pattern = EntityPathPattern::parse(entity_path_pattern);
+        RR_RETURN_NOT_OK(pattern.error);
+
+        if (_entity_path_policies) {
+            _entity_path_policies->enable_change_detection(std::move(pattern.value));
+        }
+        return Error::ok();
+    }
+
+    void RecordingStream::disable_change_detection() const {
+        if (_entity_path_policies) {
+            _entity_path_policies->disable_change_detection();
+        }
+    }
+
+    Error RecordingStream::try_enable_previews(
+        std::string_view entity_path_pattern, size_t factor, image::DepthDownscaleMode depth_mode
+    ) const {
+        if (factor < 2) {
+            return Error(
+                ErrorCode::InvalidTensorDimension,
+                "Previews need a downscale factor of at least 2, got " + std::to_string(factor) +
+                    "."
+            );
+        }
+        auto pattern = EntityPathPattern::parse(entity_path_pattern);
+        RR_RETURN_NOT_OK(pattern.error);
+
+        if (_entity_path_policies) {
+            _entity_path_policies->enable_previews(std::move(pattern.value), factor, depth_mode);
+        }
+        return Error::ok();
+    }
+
+    Error RecordingStream::try_enable_point_cloud_previews(
+        std::string_view entity_path_pattern, float voxel_size
+    ) const {
+        if (!(voxel_size > 0.0f) || !std::isfinite(voxel_size)) {
+            return Error(
+                ErrorCode::InvalidPointCloud,
+                "Point cloud previews need a positive voxel size, got " +
+                    std::to_string(voxel_size) + "."
+            );
+        }
+        auto pattern = EntityPathPattern::parse(entity_path_pattern);
+        RR_RETURN_NOT_OK(pattern.error);
+
+        if (_entity_path_policies) {
+            _entity_path_policies->enable_point_cloud_previews(
+                std::move(pattern.value),
+                voxel_size
+            );
+        }
+        return Error::ok();
+    }
+
+    Error RecordingStream::try_enable_scalar_previews(
+        std::string_view entity_path_pattern, size_t window_size
+    ) const {
+        if (window_size < 2) {
+            return Error(
+                ErrorCode::InvalidDownsamplingWindow,
+                "Scalar previews need a window of at least 2 log calls, got " +
+                    std::to_string(window_size) + "."
+            );
+        }
+        auto pattern = EntityPathPattern::parse(entity_path_pattern);
+        RR_RETURN_NOT_OK(pattern.error);
+
+        if (_entity_path_policies) {
+            _entity_path_policies->enable_scalar_previews(std::move(pattern.value), window_size);
+        }
+        return Error::ok();
+    }
+
+    void RecordingStream::disable_previews() const {
+        if (_entity_path_policies) {
+            _entity_path_policies->disable_previews();
+        }
+    }
+
+    Error RecordingStream::try_log_preview_batches(
+        bool timeless, Result<std::vector<detail::PreviewBatches>> previews
+    ) const {
+        RR_RETURN_NOT_OK(previews.error);
+        for (auto& preview : previews.value) {
+            // Not going through `try_log_admitted`, previews don't have previews.
+            RR_RETURN_NOT_OK(try_log_serialized_batches(
+                preview.entity_path,
+                timeless,
+                std::move(preview.batches)
+            ));
+        }
+        return Error::ok();
+    }
+
+    Error RecordingStream::try_log_temporal_preview_batches(
+        Result<std::vector<detail::TemporalPreviewBatches>> previews
+    ) const {
+        RR_RETURN_NOT_OK(previews.error);
+        for (auto& preview : previews.value) {
+            RR_RETURN_NOT_OK(try_log_serialized_temporal_batch(
+                preview.entity_path,
+                preview.time_column,
+                std::move(preview.batches)
+            ));
+        }
+        return Error::ok();
+    }
+
+    bool RecordingStream::is_entity_path_included(std::string_view entity_path) const {
+        // Moved-from streams don't have any policies.
+        return _entity_path_policies == nullptr || _entity_path_policies->is_included(entity_path);
+    }
+
+    bool RecordingStream::is_entity_path_admitted(std::string_view entity_path) const {
+        return _entity_path_policies == nullptr || _entity_path_policies->admit(entity_path);
+    }
+
     Error RecordingStream::connect(std::string_view tcp_addr, float flush_timeout_sec) const {
         rr_error status = {};
         rr_recording_stream_connect(
@@ -114,6 +298,20 @@ namespace rerun {
         return status;
     }
 
+    Error RecordingStream::connect_shm(
+        std::string_view path, uint64_t capacity, float flush_timeout_sec
+    ) const {
+        rr_error status = {};
+        rr_recording_stream_connect_shm(
+            _id,
+            detail::to_rr_string(path),
+            capacity,
+            flush_timeout_sec,
+            &status
+        );
+        return status;
+    }
+
     Error RecordingStream::spawn(const SpawnOptions& options, float flush_timeout_sec) const {
         rr_spawn_options rerun_c_options = {};
         options.fill_rerun_c_struct(rerun_c_options);
@@ -134,6 +332,66 @@ namespace rerun {
         return status;
     }
 
+    Error RecordingStream::memory() const {
+        rr_error status = {};
+        rr_recording_stream_memory(_id, &status);
+        return status;
+    }
+
+    Result<SinkChunk> RecordingStream::drain() const {
+        rr_sink_chunk chunk = {};
+        rr_error status = {};
+        rr_recording_stream_drain_memory(_id, &chunk, &status);
+        RR_RETURN_NOT_OK(status);
+        return SinkChunk::from_c_ffi_struct(chunk);
+    }
+
+    using SinkCallback = std::function<void(SinkChunk)>;
+
+    static void sink_callback_trampoline(void* user_data, rr_sink_chunk* c_chunk) {
+        // Exceptions must not unwind into the Rust code calling this.
+        try {
+            auto chunk = SinkChunk::from_c_ffi_struct(*c_chunk);
+            if (chunk.is_err()) {
+                chunk.error.handle();
+                return;
+            }
+            (*static_cast<SinkCallback*>(user_data))(std::move(chunk.value));
+        } catch (const std::exception& e) {
+            Error(
+                ErrorCode::RecordingStreamRuntimeFailure,
+                std::string("Sink callback threw an exception: ") + e.what()
+            )
+                .handle();
+        } catch (...) {
+            Error(ErrorCode::RecordingStreamRuntimeFailure, "Sink callback threw an exception")
+                .handle();
+        }
+    }
+
+    static void free_sink_callback(void* user_data) {
+        delete static_cast<SinkCallback*>(user_data);
+    }
+
+    Error RecordingStream::set_sink(SinkCallback callback, const SinkOptions& options) const {
+        if (!callback) {
+            return Error(ErrorCode::UnexpectedNullArgument, "callback is empty");
+        }
+
+        rr_sink_options rerun_c_options = {};
+        options.fill_rerun_c_struct(rerun_c_options);
+        rr_error status = {};
+        rr_recording_stream_set_callback_sink(
+            _id,
+            &rerun_c_options,
+            &sink_callback_trampoline,
+            new SinkCallback(std::move(callback)),
+            &free_sink_callback,
+            &status
+        );
+        return status;
+    }
+
     void RecordingStream::flush_blocking() const {
         rr_recording_stream_flush_blocking(_id);
     }
@@ -190,9 +448,15 @@ namespace rerun {
 
     Error RecordingStream::try_log_serialized_batches(
         std::string_view entity_path, bool timeless, std::vector<DataCell> batches
+    ) const {
+        return try_log_changed_serialized_batches(entity_path, timeless, std::move(batches)).error;
+    }
+
+    Result<bool> RecordingStream::try_log_changed_serialized_batches(
+        std::string_view entity_path, bool timeless, std::vector<DataCell> batches
     ) const {
         if (!is_enabled()) {
-            return Error::ok();
+            return false;
         }
         size_t num_instances_max = 0;
         for (const auto& batch : batches) {
@@ -210,6 +474,31 @@ namespace rerun {
             }
         }
 
+        // Change detection has to run after deciding what to splat since splatting depends on all
+        // batches, not just the changed ones.
+        bool skip_instanced = false;
+        if (_entity_path_policies) {
+            static const auto clear_component_type =
+                DataCell::from_loggable(components::ClearIsRecursive(false)).value.component_type;
+            for (const auto& batch : batches) {
+                if (batch.component_type == clear_component_type && batch.array != nullptr &&
+                    batch.array->length() > 0) {
+                    const bool recursive =
+                        std::static_pointer_cast<arrow::BooleanArray>(batch.array)->Value(0);
+                    _entity_path_policies->reset_change_detection(entity_path, recursive);
+                    break;
+                }
+            }
+
+            const bool removed_any = _entity_path_policies->remove_unchanged_batches(
+                entity_path,
+                timeless,
+                instanced,
+                splatted
+            );
+            skip_instanced = removed_any && instanced.empty();
+        }
+
         bool inject_time = !timeless;
 
         if (!splatted.empty()) {
@@ -223,13 +512,17 @@ namespace rerun {
             }
         }
 
-        return try_log_data_row(
+        if (skip_instanced) {
+            return !splatted.empty();
+        }
+        RR_RETURN_NOT_OK(try_log_data_row(
             entity_path,
             num_instances_max,
             instanced.size(),
             instanced.data(),
             inject_time
-        );
+        ));
+        return true;
     }
 
     Error RecordingStream::try_log_data_row(
@@ -257,6 +550,77 @@ namespace rerun {
         return status;
     }
 
+    Error RecordingStream::try_log_serialized_temporal_batch(
+        std::string_view entity_path, const TimeColumn& time_column, std::vector<DataCell> batches
+    ) const {
+        if (!is_enabled() || time_column.times.empty()) {
+            return Error::ok();
+        }
+        const size_t num_times = time_column.times.size();
+        // The C API counts both in 32 bits.
+        constexpr size_t max_count = std::numeric_limits<uint32_t>::max();
+        if (num_times > max_count || batches.size() > max_count) {
+            return Error(
+                ErrorCode::InvalidTemporalBatch,
+                "Temporal batches can hold at most " + std::to_string(max_count) +
+                    " time points and component batches, got " + std::to_string(num_times) +
+                    " time points and " + std::to_string(batches.size()) + " component batches."
+            );
+        }
+        for (const auto& batch : batches) {
+            if (batch.num_instances != num_times && batch.num_instances != 1) {
+                return Error(
+                    ErrorCode::InvalidTemporalBatch,
+                    "Component batches of a temporal batch have to hold one instance per time "
+                    "point or a single one, got " +
+                        std::to_string(batch.num_instances) + " instances for " +
+                        std::to_string(num_times) + " time points."
+                );
+            }
+        }
+
+        // Map to C API:
+        std::vector<rr_data_cell> c_data_cells(batches.size());
+        for (size_t i = 0; i < batches.size(); i++) {
+            RR_RETURN_NOT_OK(batches[i].to_c_ffi_struct(c_data_cells[i]));
+        }
+
+        rr_time_column c_time_column;
+        c_time_column.timeline_name = detail::to_rr_string(time_column.timeline_name);
+        c_time_column.time_type = time_column.time_type == TimeType::Sequence
+                                      ? RR_TIME_TYPE_SEQUENCE
+                                      : RR_TIME_TYPE_TIME;
+        c_time_column.times = time_column.times.data();
+        c_time_column.num_times = static_cast<uint32_t>(num_times);
+
+        rr_error status = {};
+        rr_recording_stream_log_temporal_batch(
+            _id,
+            detail::to_rr_string(entity_path),
+            c_time_column,
+            static_cast<uint32_t>(c_data_cells.size()),
+            c_data_cells.data(),
+            &status
+        );
+
+        return status;
+    }
+
+    Error RecordingStream::try_prepare_serialized_batches(std::vector<DataCell> batches) const {
+        if (!is_enabled()) {
+            return Error::ok();
+        }
+
+        for (const auto& batch : batches) {
+            // Every log call exports its cells to the C API, run this path once as well.
+            rr_data_cell c_cell;
+            RR_RETURN_NOT_OK(batch.to_c_ffi_struct(c_cell));
+            c_cell.array.release(&c_cell.array);
+        }
+
+        return Error::ok();
+    }
+
     Error RecordingStream::try_log_file_from_path(
         const std::filesystem::path& filepath, std::string_view entity_path_prefix, bool timeless
     ) const {
@@ -3,17 +3,30 @@
 #include <chrono>
 #include <cstdint> // uint32_t etc.
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string_view>
 #include <vector>
 
 #include "as_components.hpp"
+#include "callback_sink.hpp"
+#include "config.hpp"
+#include "entity_path_filter.hpp"
 #include "error.hpp"
+#include "image_downscale.hpp"
+#include "previews.hpp"
+#include "rate_limit.hpp"
 #include "spawn_options.hpp"
+#include "time_column.hpp"
 
 namespace rerun {
     struct DataCell;
 
+    namespace detail {
+        class EntityPathPolicies;
+    }
+
     enum class StoreKind {
         Recording,
         Blueprint,
@@ -93,10 +106,283 @@ namespace rerun {
         ///
         /// All log functions early out if a recording stream is disabled.
         /// Naturally, logging functions that take unserialized data will skip the serialization step as well.
+        ///
+        /// To remove logging code at compile time instead, see `log_lazy` and `RERUN_LOG`.
         bool is_enabled() const {
             return _enabled;
         }
 
+        /// Returns whether data logged to the given entity path is going to be recorded.
+        ///
+        /// This is the case if the recording stream is enabled and the entity path passes the
+        /// stream's entity path filter.
+        ///
+        /// \see set_entity_path_filter
+        bool is_enabled(std::string_view entity_path) const {
+            return is_enabled() && is_entity_path_included(entity_path);
+        }
+
+        /// @}
+
+        // -----------------------------------------------------------------------------------------
+        /// \name Filtering entity paths
+        /// \details Entity path filters switch logging of entity subtrees on and off at runtime.
+        /// @{
+
+        /// Sets the entity path filter of this stream, replacing any previous one.
+        ///
+        /// All `log` variants check the filter before serializing any data, so logging to a
+        /// filtered out entity path only costs a lookup in a per-stream cache of entity paths.
+        /// The low-level `try_log_serialized_batches` and `try_log_data_row` are not filtered.
+        ///
+        /// Pass a default constructed `EntityPathFilter` to log all entity paths again.
+        ///
+        /// The initial filter is read from the `RERUN_ENTITY_PATH_FILTER` environment variable,
+        /// e.g. `RERUN_ENTITY_PATH_FILTER="-world/debug/**"`.
+        ///
+        /// \see EntityPathFilter, is_enabled
+        void set_entity_path_filter(EntityPathFilter filter) const;
+
+        /// Parses the given rules and sets them as entity path filter of this stream.
+        ///
+        /// See `EntityPathFilter` for the syntax of the rules.
+        /// Failures are handled with `Error::handle`, in which case the filter is left unchanged.
+        void set_entity_path_filter(std::string_view rules) const {
+            try_set_entity_path_filter(rules).handle();
+        }
+
+        /// Parses the given rules and sets them as entity path filter of this stream.
+        ///
+        /// See `EntityPathFilter` for the syntax of the rules.
+        /// \returns An error if the rules can't be parsed, in which case the filter is unchanged.
+        Error try_set_entity_path_filter(std::string_view rules) const;
+
+        /// @}
+
+        // -----------------------------------------------------------------------------------------
+        /// \name Rate limiting
+        /// \details Rate limits drop log calls to entities that log more often than needed.
+        /// @{
+
+        /// Limits how often each entity matching the given pattern is logged to.
+        ///
+        /// Every entity path matching the pattern is limited individually to at most one log call
+        /// per `1 / max_rate_hz` seconds of wall clock time, further calls are dropped:
+        /// ```
+        /// rec.set_rate_limit("sensors/imu/**", 20.0);
+        /// ```
+        /// The limit is checked before any serialization takes place, so a dropped call costs
+        /// about as much as a filtered out one, see `set_entity_path_filter`.
+        /// Like entity path filters, rate limits apply to all `log` variants but not to
+        /// `try_log_serialized_batches` and `try_log_data_row`.
+        ///
+        /// If several rate limits match an entity path, the one set last applies.
+        /// Setting a rate limit for a pattern that already has one replaces it.
+        ///
+        /// Failures are handled with `Error::handle`.
+        ///
+        /// \param entity_path_pattern An `EntityPathPattern`, e.g. `sensors/imu/**`.
+        /// \param max_rate_hz Maximum number of log calls per second and entity.
+        /// \param mode Which log calls are kept.
+        ///
+        /// \see try_set_rate_limit, clear_rate_limits, rate_limit_stats
+        void set_rate_limit(
+            std::string_view entity_path_pattern, double max_rate_hz,
+            RateLimitMode mode = RateLimitMode::KeepLatest
+        ) const {
+            try_set_rate_limit(entity_path_pattern, max_rate_hz, mode).handle();
+        }
+
+        /// Limits how often each entity matching the given pattern is logged to.
+        ///
+        /// See `set_rate_limit` for more information.
+        /// \returns An error if the pattern is malformed or `max_rate_hz` is not positive.
+        Error try_set_rate_limit(
+            std::string_view entity_path_pattern, double max_rate_hz,
+            RateLimitMode mode = RateLimitMode::KeepLatest
+        ) const;
+
+        /// Removes all rate limits.
+        void clear_rate_limits() const;
+
+        /// Returns how many log calls each rate limit let through and how many it suppressed.
+        std::vector<RateLimitStats> rate_limit_stats() const;
+
+        /// @}
+
+        // -----------------------------------------------------------------------------------------
+        /// \name Change detection
+        /// \details Change detection skips re-logging component batches that didn't change.
+        /// @{
+
+        /// Enables change detection for all entities matching the given pattern.
+        ///
+        /// Every serialized component batch logged to these entities is compared to what was last
+        /// logged for the same component of the same entity. Batches with identical values are
+        /// left out of the logged rows, just as if only the changed components had been logged.
+        /// This saves bandwidth and work for mostly static data like colors, labels, camera
+        /// intrinsics or annotation contexts that are logged again every frame:
+        /// ```
+        /// rec.enable_change_detection("world/**");
+        /// ```
+        ///
+        /// Note that the viewer then only has a single row for unchanged data, i.e. it no longer
+        /// shows up at every logged time. Logging a `Clear` archetype to an entity resets change
+        /// detection of that entity, and of all its descendants if the clear is recursive.
+        ///
+        /// Batches are compared by a hash of their values, so only the hashes of the last logged
+        /// batches are kept.
+        ///
+        /// Unlike entity path filters and rate limits, change detection also applies to
+        /// `try_log_serialized_batches`. It doesn't apply to `try_log_data_row`.
+        ///
+        /// Failures are handled with `Error::handle`.
+        ///
+        /// \param entity_path_pattern An `EntityPathPattern`, e.g. `world/**`.
+        ///
+        /// \see try_enable_change_detection, disable_change_detection
+        void enable_change_detection(std::string_view entity_path_pattern) const {
+            try_enable_change_detection(entity_path_pattern).handle();
+        }
+
+        /// Enables change detection for all entities matching the given pattern.
+        ///
+        /// See `enable_change_detection` for more information.
+        /// \returns An error if the pattern is malformed.
+        Error try_enable_change_detection(std::string_view entity_path_pattern) const;
+
+        /// Disables change detection for all entities.
+        void disable_change_detection() const;
+
+        /// @}
+
+        // -----------------------------------------------------------------------------------------
+        /// \name Previews
+        /// \details Previews log a downscaled copy of images, point clouds and scalar series next
+        /// to the full resolution ones.
+        /// @{
+
+        /// Enables previews for all entities matching the given pattern.
+        ///
+        /// Every `Image` and `DepthImage` logged to these entities is additionally downscaled by
+        /// `factor` and logged to the same path under `preview/`, e.g. logging to `cameras/front`
+        /// also logs its preview to `preview/cameras/front`:
+        /// ```
+        /// rec.enable_previews("cameras/**", 4);
+        /// ```
+        /// This gives a lightweight copy of every camera stream for live monitoring. Preview
+        /// entities go through the entity path filter and rate limits like any other entity, so
+        /// they can for instance be logged at a lower rate than the full resolution images.
+        ///
+        /// Images are downscaled by averaging, depth images as given by `depth_mode`, see
+        /// `Image::downscaled` and `DepthImage::downscaled`. Downscaling happens on the thread
+        /// that logs the image. Images that can't be downscaled, like JPEG or NV12 images, are
+        /// logged without a preview.
+        /// Images that change detection skips as unchanged aren't logged with a preview either,
+        /// see `enable_change_detection`.
+        ///
+        /// If several previews match an entity path, the one enabled last applies.
+        ///
+        /// Failures are handled with `Error::handle`.
+        ///
+        /// \param entity_path_pattern An `EntityPathPattern`, e.g. `cameras/**`.
+        /// \param factor Integer factor by which width and height are downscaled, at least 2.
+        /// \param depth_mode How depth images pick the depth of each downscaled pixel.
+        ///
+        /// \see try_enable_previews, disable_previews
+        void enable_previews(
+            std::string_view entity_path_pattern, size_t factor,
+            image::DepthDownscaleMode depth_mode = image::DepthDownscaleMode::Nearest
+        ) const {
+            try_enable_previews(entity_path_pattern, factor, depth_mode).handle();
+        }
+
+        /// Enables previews for all entities matching the given pattern.
+        ///
+        /// See `enable_previews` for more information.
+        /// \returns An error if the pattern is malformed or the factor is less than 2.
+        Error try_enable_previews(
+            std::string_view entity_path_pattern, size_t factor,
+            image::DepthDownscaleMode depth_mode = image::DepthDownscaleMode::Nearest
+        ) const;
+
+        /// Enables point cloud previews for all entities matching the given pattern.
+        ///
+        /// Every `Points3D` logged to these entities is additionally downsampled to at most one
+        /// point per voxel and logged to the same path under `preview/`, e.g. logging to
+        /// `lidar/top` also logs its preview to `preview/lidar/top`:
+        /// ```
+        /// rec.enable_point_cloud_previews("lidar/**", 0.1f);
+        /// ```
+        /// Like image previews, preview entities go through the entity path filter and rate
+        /// limits like any other entity.
+        ///
+        /// Point clouds are downsampled with `Points3D::voxel_downsampled`, on the thread that
+        /// logs them.
+        ///
+        /// If several point cloud previews match an entity path, the one enabled last applies.
+        ///
+        /// Failures are handled with `Error::handle`.
+        ///
+        /// \param entity_path_pattern An `EntityPathPattern`, e.g. `lidar/**`.
+        /// \param voxel_size Edge length of the voxels, must be positive.
+        ///
+        /// \see try_enable_point_cloud_previews, disable_previews
+        void enable_point_cloud_previews(
+            std::string_view entity_path_pattern, float voxel_size
+        ) const {
+            try_enable_point_cloud_previews(entity_path_pattern, voxel_size).handle();
+        }
+
+        /// Enables point cloud previews for all entities matching the given pattern.
+        ///
+        /// See `enable_point_cloud_previews` for more information.
+        /// \returns An error if the pattern is malformed or the voxel size isn't positive.
+        Error try_enable_point_cloud_previews(
+            std::string_view entity_path_pattern, float voxel_size
+        ) const;
+
+        /// Enables scalar previews for all entities matching the given pattern.
+        ///
+        /// The scalars logged to each of these entities are split into windows of `window_size`
+        /// scalars. Whenever a window is complete, its smallest and largest scalar are logged to
+        /// the same path under `preview/`, as `min` and `max` child entities. E.g. logging to
+        /// `sensors/current` at 20 kHz also logs a 200 Hz min/max envelope to
+        /// `preview/sensors/current/min` and `preview/sensors/current/max`:
+        /// ```
+        /// rec.enable_scalar_previews("sensors/**", 100);
+        /// ```
+        /// Unlike decimation, the envelope keeps all spikes of the full rate series.
+        /// Both scalars are logged with the time of the scalar that completed the window.
+        ///
+        /// This applies to `Scalar`s passed to `log` as well as to `Collection<Scalar>`s passed
+        /// to `log_temporal_batch`, e.g. by a `SeriesChannel`.
+        ///
+        /// If several scalar previews match an entity path, the one enabled last applies.
+        ///
+        /// Failures are handled with `Error::handle`.
+        ///
+        /// \param entity_path_pattern An `EntityPathPattern`, e.g. `sensors/**`.
+        /// \param window_size Number of scalars per window, at least 2.
+        ///
+        /// \see try_enable_scalar_previews, disable_previews, series::min_max_indices
+        void enable_scalar_previews(
+            std::string_view entity_path_pattern, size_t window_size
+        ) const {
+            try_enable_scalar_previews(entity_path_pattern, window_size).handle();
+        }
+
+        /// Enables scalar previews for all entities matching the given pattern.
+        ///
+        /// See `enable_scalar_previews` for more information.
+        /// \returns An error if the pattern is malformed or the window size is less than 2.
+        Error try_enable_scalar_previews(
+            std::string_view entity_path_pattern, size_t window_size
+        ) const;
+
+        /// Disables image, point cloud and scalar previews for all entities.
+        void disable_previews() const;
+
         /// @}
 
         // -----------------------------------------------------------------------------------------
@@ -143,6 +429,31 @@ namespace rerun {
         Error connect(std::string_view tcp_addr = "127.0.0.1:9876", float flush_timeout_sec = 2.0)
             const;
 
+        /// Stream all log-data to a shared memory ring buffer, usually in `/dev/shm`, for a
+        /// reader on the same host.
+        ///
+        /// Avoids the copies and system calls of the TCP connection when the reader runs on the
+        /// same host. Several processes can connect to the same ring buffer, the reader receives
+        /// the log-data of all of them. Only supported on Unix.
+        ///
+        /// Experimental: the viewer can't read shared memory ring buffers yet, only custom
+        /// readers built on the Rust SDK's `ShmRingReader` can.
+        ///
+        /// capacity:
+        /// Size of the ring buffer in bytes, if it doesn't exist yet.
+        ///
+        /// flush_timeout_sec:
+        /// The minimum time the SDK will wait for the reader during a flush before potentially
+        /// dropping data. Passing a negative value indicates no timeout, and can cause a call to
+        /// `flush` to block indefinitely.
+        /// Log-data that doesn't fit into a full ring buffer is dropped after a few milliseconds.
+        ///
+        /// This function returns immediately.
+        Error connect_shm(
+            std::string_view path = "/dev/shm/rerun", uint64_t capacity = 64 * 1024 * 1024,
+            float flush_timeout_sec = 2.0
+        ) const;
+
         /// Spawns a new Rerun Viewer process from an executable available in PATH, then connects to it
         /// over TCP.
         ///
@@ -188,6 +499,49 @@ namespace rerun {
         // [1]: https://learn.microsoft.com/en-us/cpp/c-runtime-library/stdin-stdout-stderr?view=msvc-170
         Error to_stdout() const;
 
+        /// Stream all log-data to memory, to be taken with `drain`.
+        ///
+        /// Useful to keep short recordings in memory and ship them on demand, or to measure
+        /// serialization and encoding without any I/O involved. The log-data stays in memory
+        /// until drained or the recording stream is destroyed.
+        ///
+        /// This function returns immediately.
+        Error memory() const;
+
+        /// Takes the log-data collected since `memory` or the last `drain`, encoded as a complete
+        /// `.rrd` file.
+        ///
+        /// Flushes the recording stream first. The returned chunk owns the encoded bytes, see
+        /// `SinkChunk::data` and `SinkChunk::size`.
+        /// Fails if the stream isn't set to a memory sink, also once another sink replaced it.
+        Result<SinkChunk> drain() const;
+
+        /// Pass all log-data to a callback, e.g. to forward it over a custom transport.
+        ///
+        /// The callback receives the chunks in order, from a background thread or from the thread
+        /// flushing the recording stream, but never concurrently. It owns each chunk, which it
+        /// can move elsewhere to forward the data without copying it. The callback must not log
+        /// to or flush this recording stream itself.
+        ///
+        /// Calls are serialized by a lock that flushes also take, so a `flush_blocking` from
+        /// another thread blocks for as long as a slow callback runs.
+        /// Exceptions thrown by the callback are caught and handled with `Error::handle`, the
+        /// chunk is dropped in that case.
+        /// ```
+        /// rec.set_sink([&transport](rerun::SinkChunk chunk) {
+        ///     transport.send(std::move(chunk));
+        /// }, {rerun::SinkFormat::Rrd, 256 * 1024});
+        /// ```
+        /// See `rerun::SinkOptions` for how log data is collected into chunks.
+        ///
+        /// The callback is destroyed once the sink is replaced or the recording stream is
+        /// destroyed.
+        ///
+        /// This function returns immediately.
+        Error set_sink(
+            std::function<void(SinkChunk)> callback, const SinkOptions& options = {}
+        ) const;
+
         /// Initiates a flush the batching pipeline and waits for it to propagate.
         ///
         /// See `RecordingStream` docs for ordering semantics and multithreading guarantees.
@@ -364,6 +718,52 @@ namespace rerun {
             try_log_with_timeless(entity_path, true, archetypes_or_collectiones...).handle();
         }
 
+        /// Logs the archetype or component batch returned by the given callable.
+        ///
+        /// Unlike `log`, the data is only constructed if the stream is enabled:
+        /// ```
+        /// rec.log_lazy("my/points", [&] { return rerun::Points3D(compute_positions()); });
+        /// ```
+        /// If the stream is disabled, the entity path is filtered out or the call is dropped by a
+        /// rate limit, `make_data` is never invoked. If the SDK is compiled with
+        /// `RERUN_ENABLED` set to `0`, the entire call is removed by the compiler.
+        ///
+        /// Any failures that may occur during serialization are handled with `Error::handle`.
+        ///
+        /// \param entity_path Path to the entity in the space hierarchy.
+        /// \param make_data Callable without arguments returning any type for which the
+        /// `AsComponents<T>` trait is implemented.
+        ///
+        /// @see log, log_timeless_lazy, RERUN_LOG
+        template <typename F>
+        void log_lazy(std::string_view entity_path, F&& make_data) const {
+            // Only in templates instantiated by user code, such that the SDK library and user code
+            // can be compiled with different values of `RERUN_ENABLED`.
+            if constexpr (RERUN_ENABLED) {
+                if (admit_log_call(entity_path)) {
+                    try_log_admitted(entity_path, false, std::forward<F>(make_data)()).handle();
+                }
+            }
+        }
+
+        /// Logs the archetype or component batch returned by the given callable as timeless data.
+        ///
+        /// See `log_lazy` and `log_timeless` for more information.
+        ///
+        /// \param entity_path Path to the entity in the space hierarchy.
+        /// \param make_data Callable without arguments returning any type for which the
+        /// `AsComponents<T>` trait is implemented.
+        ///
+        /// @see log_timeless, log_lazy, RERUN_LOG_TIMELESS
+        template <typename F>
+        void log_timeless_lazy(std::string_view entity_path, F&& make_data) const {
+            if constexpr (RERUN_ENABLED) {
+                if (admit_log_call(entity_path)) {
+                    try_log_admitted(entity_path, true, std::forward<F>(make_data)()).handle();
+                }
+            }
+        }
+
         /// Logs one or more archetype and/or component batches.
         ///
         /// See `log` for more information.
@@ -440,41 +840,120 @@ namespace rerun {
         template <typename... Ts>
         Error try_log_with_timeless(
             std::string_view entity_path, bool timeless, const Ts&... archetypes_or_collectiones
+        ) const {
+            if (!admit_log_call(entity_path)) {
+                return Error::ok();
+            }
+            return try_log_admitted(entity_path, timeless, archetypes_or_collectiones...);
+        }
+
+        /// Logs many rows of component batches to an entity at once, one for each time point.
+        ///
+        /// Each component batch holds either one instance per time point, where instance `i`
+        /// belongs to row `i`, or a single instance shared by all rows:
+        /// ```
+        /// rec.log_temporal_batch(
+        ///     "sensors/temperature",
+        ///     rerun::TimeColumn::from_seconds("sim_time", times.data(), times.size()),
+        ///     rerun::Collection<rerun::components::Scalar>(temperatures),
+        ///     rerun::Scalar::IndicatorComponent()
+        /// );
+        /// ```
+        /// This is much cheaper than one `log` call per row, since all rows are serialized and
+        /// passed to the SDK at once, e.g. for the samples of high-rate time series.
+        /// All rows also get the time of the calling thread on all other timelines, as set by
+        /// `set_time_sequence` or `set_time`, as well as `log_time` and `log_tick`.
+        ///
+        /// Entity path filters and rate limits apply to the whole batch, which counts as a
+        /// single log call. Change detection doesn't apply, scalar previews apply to
+        /// `Collection<components::Scalar>` batches, see `enable_scalar_previews`.
+        /// Failures are handled with `Error::handle`.
+        ///
+        /// \param entity_path Path to the entity in the space hierarchy.
+        /// \param time_column Timeline and time point of each row.
+        /// \param component_batches Any type for which the `AsComponents<T>` trait is implemented.
+        ///
+        /// @see try_log_temporal_batch, SeriesChannel
+        template <typename... Ts>
+        void log_temporal_batch(
+            std::string_view entity_path, const TimeColumn& time_column,
+            const Ts&... component_batches
         ) const {
             if (!is_enabled()) {
+                return;
+            }
+            try_log_temporal_batch(entity_path, time_column, component_batches...).handle();
+        }
+
+        /// Logs many rows of component batches to an entity at once, one for each time point.
+        ///
+        /// See `log_temporal_batch` for more information.
+        /// \returns An error if an error occurs during serialization or logging, or if a batch
+        /// holds neither one instance per time point nor a single one.
+        ///
+        /// @see log_temporal_batch
+        template <typename... Ts>
+        Error try_log_temporal_batch(
+            std::string_view entity_path, const TimeColumn& time_column,
+            const Ts&... component_batches
+        ) const {
+            if (!admit_log_call(entity_path)) {
                 return Error::ok();
             }
-            std::vector<DataCell> serialized_batches;
-            Error err;
-            (
-                [&] {
-                    if (err.is_err()) {
-                        return;
-                    }
+            auto serialized_batches = serialize_batches(component_batches...);
+            RR_RETURN_NOT_OK(serialized_batches.error);
 
-                    const Result<std::vector<DataCell>> serialization_result =
-                        AsComponents<Ts>().serialize(archetypes_or_collectiones);
-                    if (serialization_result.is_err()) {
-                        err = serialization_result.error;
-                        return;
-                    }
+            RR_RETURN_NOT_OK(try_log_serialized_temporal_batch(
+                entity_path,
+                time_column,
+                std::move(serialized_batches.value)
+            ));
+            return try_log_temporal_previews(entity_path, time_column, component_batches...);
+        }
 
-                    if (serialized_batches.empty()) {
-                        // Fast path for the first batch (which is usually the only one!)
-                        serialized_batches = std::move(serialization_result.value);
-                    } else {
-                        serialized_batches.insert(
-                            serialized_batches.end(),
-                            std::make_move_iterator(serialization_result.value.begin()),
-                            std::make_move_iterator(serialization_result.value.end())
-                        );
-                    }
-                }(),
-                ...
-            );
-            RR_RETURN_NOT_OK(err);
+        /// Checks whether a log call to the given entity path should be carried out.
+        ///
+        /// Unlike `is_enabled` this also applies entity path filters and rate limits, and counts
+        /// as a log call for the latter. Together with `try_log_admitted` this allows deciding
+        /// whether to log before building the data, which is what `RERUN_LOG` does:
+        /// ```
+        /// if (rec.admit_log_call("camera/image")) {
+        ///     rec.try_log_admitted("camera/image", false, make_image()).handle();
+        /// }
+        /// ```
+        bool admit_log_call(std::string_view entity_path) const {
+            return is_enabled() && is_entity_path_admitted(entity_path);
+        }
+
+        /// Logs data whose log call `admit_log_call` let through, returning an error on failure.
+        ///
+        /// Does the same as `try_log` or `try_log_timeless` without checking entity path filters
+        /// and rate limits again, so that the log call isn't counted twice.
+        /// Change detection and previews still apply.
+        ///
+        /// \param entity_path Path to the entity in the space hierarchy.
+        /// \param timeless If true, the logged components will be timeless.
+        /// \param archetypes_or_collectiones Any type for which the `AsComponents<T>` trait is implemented.
+        ///
+        /// @see admit_log_call
+        template <typename... Ts>
+        Error try_log_admitted(
+            std::string_view entity_path, bool timeless, const Ts&... archetypes_or_collectiones
+        ) const {
+            auto serialized_batches = serialize_batches(archetypes_or_collectiones...);
+            RR_RETURN_NOT_OK(serialized_batches.error);
 
-            return try_log_serialized_batches(entity_path, timeless, std::move(serialized_batches));
+            const auto logged = try_log_changed_serialized_batches(
+                entity_path,
+                timeless,
+                std::move(serialized_batches.value)
+            );
+            RR_RETURN_NOT_OK(logged.error);
+            // Unchanged data has an unchanged preview.
+            if (!logged.value) {
+                return Error::ok();
+            }
+            return try_log_previews(entity_path, timeless, archetypes_or_collectiones...);
         }
 
         /// Logs several serialized batches batches, returning an error on failure.
@@ -482,6 +961,9 @@ namespace rerun {
         /// This is a more low-level API than `log`/`log_timeless\ and requires you to already serialize the data
         /// ahead of time.
         ///
+        /// Entity path filters and rate limits don't apply, but change detection does, see
+        /// `enable_change_detection`.
+        ///
         /// \param entity_path Path to the entity in the space hierarchy.
         /// \param timeless If true, the logged components will be timeless.
         /// Otherwise, the data will be timestamped automatically with `log_time` and `log_tick`.
@@ -512,6 +994,22 @@ namespace rerun {
             const DataCell* data_cells, bool inject_time
         ) const;
 
+        /// Logs serialized batches as many rows, one for each time point.
+        ///
+        /// This is the low-level API of `try_log_temporal_batch` and requires you to already
+        /// serialize the data ahead of time. Entity path filters and rate limits don't apply.
+        ///
+        /// \param entity_path Path to the entity in the space hierarchy.
+        /// \param time_column Timeline and time point of each row.
+        /// \param batches The serialized batches to log, each holding either one instance per
+        /// time point or a single instance shared by all rows.
+        ///
+        /// \see `try_log_temporal_batch`
+        Error try_log_serialized_temporal_batch(
+            std::string_view entity_path, const TimeColumn& time_column,
+            std::vector<DataCell> batches
+        ) const;
+
         /// Logs the file at the given `path` using all `DataLoader`s available.
         ///
         /// A single `path` might be handled by more than one loader.
@@ -605,11 +1103,263 @@ namespace rerun {
 
         /// @}
 
+        // -----------------------------------------------------------------------------------------
+        /// \name Warming up
+        /// \details Moves one-time costs of logging out of the first log call.
+        /// @{
+
+        /// Performs the one-time work needed before the given types can be logged.
+        ///
+        /// The first time a type is logged, its component types are registered with the SDK,
+        /// their Arrow datatypes are built and serialization runs for the very first time.
+        /// Calling this during startup takes these costs out of the first logged frame.
+        ///
+        /// Archetypes are warmed up by serializing a default constructed instance which covers
+        /// all their required components. Use `prepare` with representative data to also cover
+        /// optional components. Individual components can be warmed up via `rerun::Collection`:
+        /// ```
+        /// rec.warmup<rerun::Points3D, rerun::Image, rerun::Collection<rerun::Color>>();
+        /// ```
+        ///
+        /// Does nothing if the stream is disabled.
+        /// Failures are handled with `Error::handle`.
+        ///
+        /// @see try_warmup, prepare
+        template <typename... Ts>
+        void warmup() const {
+            try_warmup<Ts...>().handle();
+        }
+
+        /// Performs the one-time work needed before the given types can be logged, returning an error.
+        ///
+        /// See `warmup` for more information.
+        ///
+        /// @see warmup, try_prepare
+        template <typename... Ts>
+        Error try_warmup() const {
+            if (!is_enabled()) {
+                return Error::ok();
+            }
+            return serialize_batches(Ts()...).error;
+        }
+
+        /// Runs everything `log` would do with the given data, except for actually logging it.
+        ///
+        /// In addition to what `warmup` does, this covers all components that are set on the
+        /// passed archetypes and the export of the serialized data to the C API.
+        /// Pass data that is representative for what is going to be logged later on, e.g. the
+        /// first frame of a sensor.
+        ///
+        /// Does nothing if the stream is disabled.
+        /// Failures are handled with `Error::handle`.
+        ///
+        /// \param archetypes_or_collectiones Any type for which the `AsComponents<T>` trait is implemented.
+        ///
+        /// @see try_prepare, warmup
+        template <typename... Ts>
+        void prepare(const Ts&... archetypes_or_collectiones) const {
+            try_prepare(archetypes_or_collectiones...).handle();
+        }
+
+        /// Runs everything `log` would do with the given data, except for actually logging it.
+        ///
+        /// See `prepare` for more information.
+        ///
+        /// \param archetypes_or_collectiones Any type for which the `AsComponents<T>` trait is implemented.
+        /// \returns An error if an error occurs during serialization.
+        ///
+        /// @see prepare, try_warmup
+        template <typename... Ts>
+        Error try_prepare(const Ts&... archetypes_or_collectiones) const {
+            if (!is_enabled()) {
+                return Error::ok();
+            }
+            auto serialized_batches = serialize_batches(archetypes_or_collectiones...);
+            RR_RETURN_NOT_OK(serialized_batches.error);
+
+            return try_prepare_serialized_batches(std::move(serialized_batches.value));
+        }
+
+        /// Runs everything `try_log_serialized_batches` would do except for actually logging.
+        ///
+        /// \param batches The serialized batches to prepare logging for.
+        ///
+        /// \see `try_prepare`
+        Error try_prepare_serialized_batches(std::vector<DataCell> batches) const;
+
+        /// @}
+
       private:
+        /// Serializes all passed archetypes and/or component batches into a single list of data cells.
+        template <typename... Ts>
+        static Result<std::vector<DataCell>> serialize_batches(
+            const Ts&... archetypes_or_collectiones
+        ) {
+            std::vector<DataCell> serialized_batches;
+            Error err;
+            (
+                [&] {
+                    if (err.is_err()) {
+                        return;
+                    }
+
+                    Result<std::vector<DataCell>> serialization_result =
+                        AsComponents<Ts>().serialize(archetypes_or_collectiones);
+                    if (serialization_result.is_err()) {
+                        err = serialization_result.error;
+                        return;
+                    }
+
+                    if (serialized_batches.empty()) {
+                        // Fast path for the first batch (which is usually the only one!)
+                        serialized_batches = std::move(serialization_result.value);
+                    } else {
+                        serialized_batches.insert(
+                            serialized_batches.end(),
+                            std::make_move_iterator(serialization_result.value.begin()),
+                            std::make_move_iterator(serialization_result.value.end())
+                        );
+                    }
+                }(),
+                ...
+            );
+            RR_RETURN_NOT_OK(err);
+
+            return serialized_batches;
+        }
+
+        /// Logs the previews of all passed archetypes and component batches, see
+        /// `detail::Preview`.
+        template <typename... Ts>
+        Error try_log_previews(
+            std::string_view entity_path, bool timeless, const Ts&... archetypes_or_collectiones
+        ) const {
+            // Moved-from streams don't have any policies.
+            if (_entity_path_policies == nullptr) {
+                return Error::ok();
+            }
+            Error err;
+            (
+                [&] {
+                    if (err.is_ok()) {
+                        err = try_log_preview_batches(
+                            timeless,
+                            detail::Preview<Ts>::admitted_previews(
+                                *_entity_path_policies,
+                                entity_path,
+                                archetypes_or_collectiones
+                            )
+                        );
+                    }
+                }(),
+                ...
+            );
+            return err;
+        }
+
+        Error try_log_preview_batches(
+            bool timeless, Result<std::vector<detail::PreviewBatches>> previews
+        ) const;
+
+        /// Logs the previews of all passed component batches, see `detail::TemporalPreview`.
+        template <typename... Ts>
+        Error try_log_temporal_previews(
+            std::string_view entity_path, const TimeColumn& time_column,
+            const Ts&... component_batches
+        ) const {
+            if (_entity_path_policies == nullptr) {
+                return Error::ok();
+            }
+            Error err;
+            (
+                [&] {
+                    if (err.is_ok()) {
+                        err = try_log_temporal_preview_batches(
+                            detail::TemporalPreview<Ts>::admitted_previews(
+                                *_entity_path_policies,
+                                entity_path,
+                                time_column,
+                                component_batches
+                            )
+                        );
+                    }
+                }(),
+                ...
+            );
+            return err;
+        }
+
+        Error try_log_temporal_preview_batches(
+            Result<std::vector<detail::TemporalPreviewBatches>> previews
+        ) const;
+
+        /// Does the same as `try_log_serialized_batches`.
+        ///
+        /// \returns Whether anything was logged, i.e. false if change detection removed all
+        /// batches as unchanged.
+        Result<bool> try_log_changed_serialized_batches(
+            std::string_view entity_path, bool timeless, std::vector<DataCell> batches
+        ) const;
+
         RecordingStream(uint32_t id, StoreKind store_kind);
 
+        bool is_entity_path_included(std::string_view entity_path) const;
+
+        bool is_entity_path_admitted(std::string_view entity_path) const;
+
         uint32_t _id;
         StoreKind _store_kind;
         bool _enabled;
+        std::unique_ptr<detail::EntityPathPolicies> _entity_path_policies;
     };
 } // namespace rerun
+
+#if RERUN_ENABLED
+
+/// Logs to the given `RecordingStream`, evaluating the arguments only if the stream is enabled.
+///
+/// `RERUN_LOG(rec, "my/points", rerun::Points3D(compute_positions()));` behaves like
+/// `rec.log("my/points", rerun::Points3D(compute_positions()));`, except that no argument
+/// (including `compute_positions()`) is evaluated if `rec` is disabled, the entity path is
+/// filtered out or the call is dropped by a rate limit.
+/// If the SDK is compiled with `RERUN_ENABLED` set to `0`, the macro expands to nothing that
+/// is evaluated at runtime, while the arguments are still type checked.
+#define RERUN_LOG(rec, entity_path, ...)                                                       \
+    do {                                                                                       \
+        const rerun::RecordingStream& _rerun_stream_ = (rec);                                  \
+        const auto& _rerun_entity_path_ = (entity_path);                                       \
+        if (_rerun_stream_.admit_log_call(_rerun_entity_path_)) {                              \
+            _rerun_stream_.try_log_admitted(_rerun_entity_path_, false, __VA_ARGS__).handle(); \
+        }                                                                                      \
+    } while (false)
+
+/// Logs timeless data to the given `RecordingStream`, evaluating the arguments only if the stream
+/// is enabled.
+///
+/// See `RERUN_LOG` for more information.
+#define RERUN_LOG_TIMELESS(rec, entity_path, ...)                                             \
+    do {                                                                                      \
+        const rerun::RecordingStream& _rerun_stream_ = (rec);                                 \
+        const auto& _rerun_entity_path_ = (entity_path);                                      \
+        if (_rerun_stream_.admit_log_call(_rerun_entity_path_)) {                             \
+            _rerun_stream_.try_log_admitted(_rerun_entity_path_, true, __VA_ARGS__).handle(); \
+        }                                                                                     \
+    } while (false)
+
+#else
+
+#define RERUN_LOG(rec, entity_path, ...)           \
+    do {                                           \
+        if (false) {                               \
+            (rec).log((entity_path), __VA_ARGS__); \
+        }                                          \
+    } while (false)
+
+#define RERUN_LOG_TIMELESS(rec, entity_path, ...)           \
+    do {                                                    \
+        if (false) {                                        \
+            (rec).log_timeless((entity_path), __VA_ARGS__); \
+        }                                                   \
+    } while (false)
+
+#endif
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "as_components.hpp"
+#include "collection.hpp"
+#include "data_cell.hpp"
+#include "result.hpp"
+
+namespace rerun {
+    /// A batch of components that has already been serialized to Arrow.
+    ///
+    /// Logging data serializes it every time it is logged. If the same large data is logged
+    /// several times, e.g. a mesh or a texture to many entities or an annotation context at many
+    /// times, serialize it only once and log the serialized batch instead:
+    /// ```
+    /// const auto mesh = rerun::SerializedComponentBatch::serialize(rerun::Mesh3D(positions))
+    ///                       .value_or_throw();
+    /// for (const auto& entity_path : entity_paths) {
+    ///     rec.log(entity_path, mesh);
+    /// }
+    /// ```
+    ///
+    /// The serialized Arrow array is immutable and shared between all copies of the batch and
+    /// all log calls, handing it to the SDK only increments its reference count.
+    class SerializedComponentBatch {
+      public:
+        /// Creates an empty batch without any data.
+        SerializedComponentBatch() : _cell{} {}
+
+        /// Wraps an already serialized data cell.
+        explicit SerializedComponentBatch(DataCell cell) : _cell(std::move(cell)) {}
+
+        /// Serializes a collection of components.
+        ///
+        /// Automatically registers the component type the first time this type is encountered.
+        template <typename TComponent>
+        static Result<SerializedComponentBatch> from_loggable(
+            const Collection<TComponent>& components
+        ) {
+            auto cell = DataCell::from_loggable<TComponent>(components);
+            RR_RETURN_NOT_OK(cell.error);
+            return SerializedComponentBatch(std::move(cell.value));
+        }
+
+        /// Serializes anything that can be logged, i.e. any type for which the `AsComponents<T>`
+        /// trait is implemented, into one batch per component.
+        ///
+        /// The result can be logged just like the original data.
+        template <typename T>
+        static Result<std::vector<SerializedComponentBatch>> serialize(
+            const T& archetype_or_collection
+        ) {
+            auto cells = AsComponents<T>().serialize(archetype_or_collection);
+            RR_RETURN_NOT_OK(cells.error);
+
+            std::vector<SerializedComponentBatch> batches;
+            batches.reserve(cells.value.size());
+            for (auto& cell : cells.value) {
+                batches.emplace_back(std::move(cell));
+            }
+            return batches;
+        }
+
+        /// The serialized data cell.
+        const DataCell& data_cell() const {
+            return _cell;
+        }
+
+        /// Number of component instances in this batch.
+        size_t num_instances() const {
+            return _cell.num_instances;
+        }
+
+      private:
+        DataCell _cell;
+    };
+
+    /// \cond private
+
+    /// `AsComponents` for a single pre-serialized component batch.
+    template <>
+    struct AsComponents<SerializedComponentBatch> {
+        static Result<std::vector<DataCell>> serialize(const SerializedComponentBatch& batch) {
+            return Result<std::vector<DataCell>>({batch.data_cell()});
+        }
+    };
+
+    /// `AsComponents` for several pre-serialized component batches, e.g. a serialized archetype.
+    template <>
+    struct AsComponents<std::vector<SerializedComponentBatch>> {
+        static Result<std::vector<DataCell>> serialize(
+            const std::vector<SerializedComponentBatch>& batches
+        ) {
+            std::vector<DataCell> cells;
+            cells.reserve(batches.size());
+            for (const auto& batch : batches) {
+                cells.push_back(batch.data_cell());
+            }
+            return cells;
+        }
+    };
+
+    /// \endcond
+} // namespace rerun
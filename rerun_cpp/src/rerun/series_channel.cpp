@@ -0,0 +1,51 @@
+#include "series_channel.hpp"
+
+#include <utility>
+
+#include "archetypes/scalar.hpp"
+#include "recording_stream.hpp"
+
+namespace rerun {
+    SeriesChannel::SeriesChannel(
+        const RecordingStream& rec, std::string entity_path, std::string timeline_name,
+        TimeType time_type, size_t max_batch_size, std::chrono::nanoseconds max_delay
+    )
+        : _rec(&rec),
+          _entity_path(std::move(entity_path)),
+          _timeline_name(std::move(timeline_name)),
+          _time_type(time_type),
+          _max_batch_size(max_batch_size),
+          _max_delay(max_delay) {
+        _times.reserve(_max_batch_size);
+        _values.reserve(_max_batch_size);
+    }
+
+    SeriesChannel::~SeriesChannel() {
+        flush();
+    }
+
+    Error SeriesChannel::try_flush() {
+        if (_times.empty()) {
+            return Error::ok();
+        }
+
+        // The batch takes ownership of the buffers, which are then replaced by new ones.
+        TimeColumn time_column(
+            _timeline_name,
+            _time_type,
+            Collection<int64_t>::take_ownership(std::move(_times))
+        );
+        auto values = Collection<components::Scalar>::take_ownership(std::move(_values));
+        _times = std::vector<int64_t>();
+        _values = std::vector<components::Scalar>();
+        _times.reserve(_max_batch_size);
+        _values.reserve(_max_batch_size);
+
+        return _rec->try_log_temporal_batch(
+            _entity_path,
+            time_column,
+            values,
+            archetypes::Scalar::IndicatorComponent()
+        );
+    }
+} // namespace rerun
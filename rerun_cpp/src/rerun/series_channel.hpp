@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "components/scalar.hpp"
+#include "error.hpp"
+#include "time_column.hpp"
+
+namespace rerun {
+    class RecordingStream;
+
+    /// Accumulates the samples of a scalar time series and logs them in batches with
+    /// `RecordingStream::log_temporal_batch`.
+    ///
+    /// Logging each sample with `RecordingStream::log` costs a full row with its own
+    /// serialization and call into the SDK, which limits high-rate sensors. A channel instead
+    /// buffers the samples and logs all of them at once when either `max_batch_size` samples
+    /// are buffered or the oldest buffered sample was added more than `max_delay` ago.
+    /// ```
+    /// rerun::SeriesChannel imu_x(rec, "imu/acc/x", "sensor_time");
+    /// for (const auto& sample : imu_samples) {
+    ///     imu_x.add(sample.timestamp, sample.acceleration.x);
+    /// }
+    /// ```
+    /// The deadline is only checked when adding samples, call `flush` when samples may stop
+    /// arriving for longer. The destructor flushes all remaining samples.
+    ///
+    /// The recording stream has to outlive the channel. Not thread-safe, use one channel per
+    /// series and thread.
+    class SeriesChannel {
+      public:
+        /// \param rec The recording stream to log to.
+        /// \param entity_path Entity of the series.
+        /// \param timeline_name Timeline of the time points passed to `add`.
+        /// \param time_type Whether the time points are sequence numbers or nanoseconds.
+        /// \param max_batch_size Maximum number of buffered samples.
+        /// \param max_delay Maximum time a sample stays buffered, as long as samples arrive.
+        SeriesChannel(
+            const RecordingStream& rec, std::string entity_path, std::string timeline_name,
+            TimeType time_type = TimeType::Time, size_t max_batch_size = 4096,
+            std::chrono::nanoseconds max_delay = std::chrono::milliseconds(100)
+        );
+
+        SeriesChannel(const SeriesChannel&) = delete;
+        SeriesChannel& operator=(const SeriesChannel&) = delete;
+        SeriesChannel(SeriesChannel&&) = default;
+
+        /// Flushes all remaining samples.
+        ~SeriesChannel();
+
+        /// Adds a sample at the given sequence number or nanoseconds, depending on the time type.
+        void add(int64_t time, double value) {
+            if (_times.empty()) {
+                _oldest_sample_time = std::chrono::steady_clock::now();
+            }
+            _times.push_back(time);
+            _values.emplace_back(value);
+            if (_times.size() >= _max_batch_size ||
+                std::chrono::steady_clock::now() - _oldest_sample_time >= _max_delay) {
+                flush();
+            }
+        }
+
+        /// Adds a sample at the given time since the Unix epoch.
+        ///
+        /// Requires the time type `TimeType::Time`.
+        template <typename TRep, typename TPeriod>
+        void add(std::chrono::duration<TRep, TPeriod> time, double value) {
+            if constexpr (std::is_floating_point<TRep>::value) {
+                using seconds_double = std::chrono::duration<double>;
+                const double seconds = std::chrono::duration_cast<seconds_double>(time).count();
+                add(static_cast<int64_t>(std::llround(seconds * 1e9)), value);
+            } else {
+                add(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(), value);
+            }
+        }
+
+        /// Logs all buffered samples.
+        ///
+        /// Failures are handled with `Error::handle`.
+        void flush() {
+            try_flush().handle();
+        }
+
+        /// Logs all buffered samples.
+        ///
+        /// The samples are dropped even if logging fails.
+        Error try_flush();
+
+        /// Number of buffered samples.
+        size_t num_buffered() const {
+            return _times.size();
+        }
+
+      private:
+        const RecordingStream* _rec;
+        std::string _entity_path;
+        std::string _timeline_name;
+        TimeType _time_type;
+        size_t _max_batch_size;
+        std::chrono::nanoseconds _max_delay;
+
+        std::vector<int64_t> _times;
+        std::vector<components::Scalar> _values;
+        std::chrono::steady_clock::time_point _oldest_sample_time;
+    };
+} // namespace rerun
@@ -0,0 +1,125 @@
+#include "series_downsampling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace rerun::series {
+    size_t min_max_indices(
+        const double* values, size_t num_values, size_t bucket_size, size_t* indices
+    ) {
+        bucket_size = std::max<size_t>(bucket_size, 1);
+
+        size_t num_kept = 0;
+        for (size_t begin = 0; begin < num_values; begin += bucket_size) {
+            const size_t end = std::min(begin + bucket_size, num_values);
+
+            // NaN fails all comparisons and is skipped.
+            double min = std::numeric_limits<double>::infinity();
+            double max = -std::numeric_limits<double>::infinity();
+            for (size_t i = begin; i < end; ++i) {
+                min = values[i] < min ? values[i] : min;
+                max = values[i] > max ? values[i] : max;
+            }
+            if (min > max) {
+                continue;
+            }
+
+            const size_t min_index =
+                static_cast<size_t>(std::find(values + begin, values + end, min) - values);
+            const size_t max_index =
+                static_cast<size_t>(std::find(values + begin, values + end, max) - values);
+            indices[num_kept++] = std::min(min_index, max_index);
+            if (min_index != max_index) {
+                indices[num_kept++] = std::max(min_index, max_index);
+            }
+        }
+        return num_kept;
+    }
+
+    size_t lttb_indices(
+        const double* times, const double* values, size_t num_values, size_t num_kept,
+        size_t* indices
+    ) {
+        if (num_kept >= num_values || num_kept < 3) {
+            std::iota(indices, indices + num_values, size_t{0});
+            return num_values;
+        }
+
+        // The first and last sample are buckets of their own.
+        const double bucket_size =
+            static_cast<double>(num_values - 2) / static_cast<double>(num_kept - 2);
+        const auto bucket_begin = [&](size_t bucket) {
+            return std::min(
+                static_cast<size_t>(std::floor(static_cast<double>(bucket) * bucket_size)) + 1,
+                num_values
+            );
+        };
+
+        size_t previous = 0;
+        indices[0] = 0;
+        for (size_t bucket = 0; bucket + 2 < num_kept; ++bucket) {
+            // Average of the next bucket, which is only the last sample for the last bucket.
+            const size_t next_begin = bucket_begin(bucket + 1);
+            const size_t next_end = std::max(bucket_begin(bucket + 2), next_begin + 1);
+            double average_time = 0.0;
+            double average_value = 0.0;
+            for (size_t i = next_begin; i < next_end; ++i) {
+                average_time += times[i];
+                average_value += values[i];
+            }
+            average_time /= static_cast<double>(next_end - next_begin);
+            average_value /= static_cast<double>(next_end - next_begin);
+
+            // Keep the sample spanning the largest triangle with the previously kept sample and
+            // the average of the next bucket.
+            const size_t begin = bucket_begin(bucket);
+            const size_t end = next_begin;
+            double max_area = -1.0;
+            size_t kept = begin;
+            for (size_t i = begin; i < end; ++i) {
+                const double area = std::abs(
+                    (times[previous] - average_time) * (values[i] - values[previous]) -
+                    (times[previous] - times[i]) * (average_value - values[previous])
+                );
+                if (area > max_area) {
+                    max_area = area;
+                    kept = i;
+                }
+            }
+
+            indices[bucket + 1] = kept;
+            previous = kept;
+        }
+        indices[num_kept - 1] = num_values - 1;
+        return num_kept;
+    }
+
+    std::optional<MinMax> MinMaxWindow::add(double value) {
+        if (!std::isnan(value)) {
+            if (!_has_value || value < _min) {
+                _min = value;
+                _min_index = _num_values;
+            }
+            if (!_has_value || value > _max) {
+                _max = value;
+                _max_index = _num_values;
+            }
+            _has_value = true;
+        }
+
+        ++_num_values;
+        if (_num_values < _window_size) {
+            return std::nullopt;
+        }
+
+        std::optional<MinMax> min_max;
+        if (_has_value) {
+            min_max = _min_index <= _max_index ? MinMax{_min, _max} : MinMax{_max, _min};
+        }
+        _num_values = 0;
+        _has_value = false;
+        return min_max;
+    }
+} // namespace rerun::series
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+namespace rerun {
+    /// Downsampling of high-rate scalar series, e.g. for live plots of sensors sampled at
+    /// several kHz.
+    ///
+    /// The block functions return the indices of the samples to keep, so that they work with
+    /// any type of timestamps.
+    namespace series {
+        /// Keeps the smallest and the largest sample of each bucket of `bucket_size` samples.
+        ///
+        /// Unlike averaging or decimation this preserves spikes, so that the plot of the
+        /// downsampled series has the same envelope as the full series.
+        /// Kept samples are in their original order. NaN samples are never kept.
+        ///
+        /// \param indices Has to hold `2 * ceil(num_values / bucket_size)` indices.
+        /// \returns The number of kept samples.
+        size_t min_max_indices(
+            const double* values, size_t num_values, size_t bucket_size, size_t* indices
+        );
+
+        /// Picks `num_kept` samples with the Largest-Triangle-Three-Buckets algorithm.
+        ///
+        /// Visually the best fit for line plots of a given number of points, but unlike
+        /// `min_max_indices` it may skip spikes. The first and last sample are always kept.
+        /// Keeps all samples if there are at most `num_kept`, or if `num_kept` is less than 3.
+        ///
+        /// \param times Time of each sample, in any unit, increasing.
+        /// \param indices Has to hold `min(num_kept, num_values)` indices, or `num_values`
+        /// indices if `num_kept` is less than 3.
+        /// \returns The number of kept samples.
+        size_t lttb_indices(
+            const double* times, const double* values, size_t num_values, size_t num_kept,
+            size_t* indices
+        );
+
+        /// Smallest and largest value of a window, in the order they were added.
+        struct MinMax {
+            double first;
+            double second;
+        };
+
+        /// Streaming min/max downsampling of a scalar series, in constant time per sample.
+        ///
+        /// \see min_max_indices
+        class MinMaxWindow {
+          public:
+            explicit MinMaxWindow(size_t window_size) : _window_size(window_size) {}
+
+            /// Adds a sample.
+            ///
+            /// NaN samples are ignored, but count towards the window size.
+            /// \returns The smallest and largest sample of the window when the sample completes
+            /// it, nothing otherwise.
+            std::optional<MinMax> add(double value);
+
+          private:
+            size_t _window_size;
+            size_t _num_values = 0;
+            bool _has_value = false;
+            size_t _min_index = 0;
+            size_t _max_index = 0;
+            double _min = 0.0;
+            double _max = 0.0;
+        };
+    } // namespace series
+} // namespace rerun
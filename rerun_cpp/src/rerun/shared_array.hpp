@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace rerun {
+    namespace detail {
+        /// Allocates an array of `num_elements` default initialized elements, e.g. to be filled
+        /// and then passed on to `Collection::share`.
+        ///
+        /// Unlike `std::vector`, trivial element types are left uninitialized.
+        template <typename TElement>
+        std::shared_ptr<TElement> allocate_shared_array(size_t num_elements) {
+            return std::shared_ptr<TElement>(
+                new TElement[num_elements],
+                std::default_delete<TElement[]>()
+            );
+        }
+    } // namespace detail
+} // namespace rerun
@@ -0,0 +1,155 @@
+#include "tensor_conversion.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+#include "shared_array.hpp"
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace rerun::tensor {
+    static_assert(sizeof(half) == sizeof(uint16_t));
+
+    static inline uint32_t float_bits(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    static inline float bits_float(uint32_t bits) {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    static inline uint16_t f32_to_f16_bits(float value) {
+        constexpr uint32_t F32_INFINITY = 255u << 23;
+        constexpr uint32_t F16_OVERFLOW = (127u + 16u) << 23;
+        constexpr uint32_t F16_MIN_NORMAL = (127u - 14u) << 23;
+        // Adding this pushes the mantissa of a half denormal to the lowest bits of the float,
+        // letting the FPU do the rounding.
+        constexpr uint32_t DENORMAL_MAGIC = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+        uint32_t bits = float_bits(value);
+        const uint32_t sign = bits & 0x80000000u;
+        bits ^= sign;
+
+        uint32_t result;
+        if (bits >= F16_OVERFLOW) {
+            result = bits > F32_INFINITY ? 0x7E00u : 0x7C00u;
+        } else if (bits < F16_MIN_NORMAL) {
+            result = float_bits(bits_float(bits) + bits_float(DENORMAL_MAGIC)) - DENORMAL_MAGIC;
+        } else {
+            // Rebias the exponent and round to nearest even.
+            const uint32_t mantissa_odd = (bits >> 13) & 1u;
+            bits -= (127u - 15u) << 23;
+            bits += 0xFFFu + mantissa_odd;
+            result = bits >> 13;
+        }
+        return static_cast<uint16_t>(result | (sign >> 16));
+    }
+
+    static inline float f16_bits_to_f32(uint16_t value) {
+        const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+        const uint32_t exponent = (value >> 10) & 0x1Fu;
+        const uint32_t mantissa = value & 0x3FFu;
+
+        if (exponent == 0) {
+            const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+            return bits_float(float_bits(magnitude) | sign);
+        } else if (exponent == 0x1F) {
+            return bits_float(sign | 0x7F800000u | (mantissa << 13));
+        } else {
+            return bits_float(sign | ((exponent + 127u - 15u) << 23) | (mantissa << 13));
+        }
+    }
+
+    size_t element_count(const Collection<datatypes::TensorDimension>& shape) {
+        size_t count = shape.empty() ? 0 : 1;
+        for (const auto& dim : shape) {
+            count *= dim.size;
+        }
+        return count;
+    }
+
+    void f32_to_f16(const float* src, half* dst, size_t num_elements) {
+        size_t i = 0;
+#if defined(__F16C__)
+        for (; i + 8 <= num_elements; i += 8) {
+            const __m128i converted =
+                _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), converted);
+        }
+#endif
+        for (; i < num_elements; ++i) {
+            dst[i].f16 = f32_to_f16_bits(src[i]);
+        }
+    }
+
+    void f16_to_f32(const half* src, float* dst, size_t num_elements) {
+        size_t i = 0;
+#if defined(__F16C__)
+        for (; i + 8 <= num_elements; i += 8) {
+            const __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(halves));
+        }
+#endif
+        for (; i < num_elements; ++i) {
+            dst[i] = f16_bits_to_f32(src[i].f16);
+        }
+    }
+
+    void f64_to_f32(const double* src, float* dst, size_t num_elements) {
+        for (size_t i = 0; i < num_elements; ++i) {
+            dst[i] = static_cast<float>(src[i]);
+        }
+    }
+
+    void meters_to_u16(const float* meters, uint16_t* depth, size_t num_elements, float meter) {
+        for (size_t i = 0; i < num_elements; ++i) {
+            const float scaled = meters[i] * meter + 0.5f;
+            // Written so that NaN fails the comparison.
+            depth[i] = scaled >= 1.0f ? static_cast<uint16_t>(std::min(scaled, 65535.0f)) : 0;
+        }
+    }
+
+    float u16_depth_meter(const float* meters, size_t num_elements) {
+        float max_depth = 0.0f;
+        for (size_t i = 0; i < num_elements; ++i) {
+            if (std::isfinite(meters[i])) {
+                max_depth = std::max(max_depth, meters[i]);
+            }
+        }
+        return max_depth > 0.0f ? 65535.0f / max_depth : 1000.0f;
+    }
+
+    datatypes::TensorBuffer f16_buffer(const float* src, size_t num_elements) {
+        auto elements = detail::allocate_shared_array<half>(num_elements);
+        f32_to_f16(src, elements.get(), num_elements);
+        return datatypes::TensorBuffer::f16(
+            Collection<half>::share(std::move(elements), num_elements)
+        );
+    }
+
+    datatypes::TensorBuffer f32_buffer(const double* src, size_t num_elements) {
+        auto elements = detail::allocate_shared_array<float>(num_elements);
+        f64_to_f32(src, elements.get(), num_elements);
+        return datatypes::TensorBuffer::f32(
+            Collection<float>::share(std::move(elements), num_elements)
+        );
+    }
+
+    datatypes::TensorBuffer u16_depth_buffer(
+        const float* meters, size_t num_elements, float meter
+    ) {
+        auto elements = detail::allocate_shared_array<uint16_t>(num_elements);
+        meters_to_u16(meters, elements.get(), num_elements, meter);
+        return datatypes::TensorBuffer::u16(
+            Collection<uint16_t>::share(std::move(elements), num_elements)
+        );
+    }
+} // namespace rerun::tensor
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "collection.hpp"
+#include "datatypes/tensor_buffer.hpp"
+#include "datatypes/tensor_dimension.hpp"
+#include "half.hpp"
+
+namespace rerun {
+    /// Conversions of tensor elements to smaller types, e.g. to halve the size of float32
+    /// feature maps or depth images before logging.
+    ///
+    /// The `*_to_*` kernels work on raw element buffers.
+    /// The `*_buffer` functions convert straight into a newly allocated, reference counted
+    /// `rerun::datatypes::TensorBuffer`.
+    namespace tensor {
+        /// Number of elements of a tensor with the given shape.
+        size_t element_count(const Collection<datatypes::TensorDimension>& shape);
+
+        /// Converts 32-bit floats to 16-bit half floats, rounding to nearest even.
+        ///
+        /// Values outside of the half range become infinity, NaNs stay NaNs.
+        /// Uses the F16C instructions if the SDK is compiled with them enabled (e.g. `-mf16c`).
+        void f32_to_f16(const float* src, half* dst, size_t num_elements);
+
+        /// Converts 16-bit half floats to 32-bit floats.
+        void f16_to_f32(const half* src, float* dst, size_t num_elements);
+
+        /// Converts 64-bit floats to 32-bit floats.
+        void f64_to_f32(const double* src, float* dst, size_t num_elements);
+
+        /// Quantizes depth in meters to 16-bit depth with the given number of units per meter.
+        ///
+        /// Negative, zero and NaN depths become 0, which the viewer treats as "no depth".
+        /// Depths beyond the range of 16 bits saturate.
+        void meters_to_u16(const float* meters, uint16_t* depth, size_t num_elements, float meter);
+
+        /// Returns the largest number of units per meter for which `meters_to_u16` doesn't
+        /// saturate, i.e. the finest resolution that covers the farthest finite depth.
+        ///
+        /// Returns 1000 (millimeters) if there is no positive finite depth.
+        float u16_depth_meter(const float* meters, size_t num_elements);
+
+        /// Creates a half float tensor buffer from 32-bit floats.
+        datatypes::TensorBuffer f16_buffer(const float* src, size_t num_elements);
+
+        /// Creates a 32-bit float tensor buffer from 64-bit floats.
+        datatypes::TensorBuffer f32_buffer(const double* src, size_t num_elements);
+
+        /// Creates a 16-bit depth tensor buffer from depths in meters.
+        ///
+        /// \see meters_to_u16
+        datatypes::TensorBuffer u16_depth_buffer(
+            const float* meters, size_t num_elements, float meter
+        );
+    } // namespace tensor
+} // namespace rerun
@@ -0,0 +1,215 @@
+#include "tiled_image_logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "archetypes/clear.hpp"
+#include "archetypes/image.hpp"
+#include "archetypes/segmentation_image.hpp"
+#include "archetypes/transform3d.hpp"
+#include "recording_stream.hpp"
+#include "shared_array.hpp"
+
+namespace rerun {
+    /// Calls `func` with the elements of a tensor buffer of any integer or float type.
+    ///
+    /// \returns false for encoded buffers like JPEG.
+    template <typename F>
+    static bool visit_elements(const datatypes::TensorBuffer& buffer, F&& func) {
+        if (const auto* u8 = buffer.get_u8()) {
+            func(*u8);
+        } else if (const auto* u16 = buffer.get_u16()) {
+            func(*u16);
+        } else if (const auto* u32 = buffer.get_u32()) {
+            func(*u32);
+        } else if (const auto* u64 = buffer.get_u64()) {
+            func(*u64);
+        } else if (const auto* i8 = buffer.get_i8()) {
+            func(*i8);
+        } else if (const auto* i16 = buffer.get_i16()) {
+            func(*i16);
+        } else if (const auto* i32 = buffer.get_i32()) {
+            func(*i32);
+        } else if (const auto* i64 = buffer.get_i64()) {
+            func(*i64);
+        } else if (const auto* f16 = buffer.get_f16()) {
+            func(*f16);
+        } else if (const auto* f32 = buffer.get_f32()) {
+            func(*f32);
+        } else if (const auto* f64 = buffer.get_f64()) {
+            func(*f64);
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    Error TiledImageLogger::try_log(const RecordingStream& rec, const archetypes::Image& image) {
+        return try_log_tiles(rec, image);
+    }
+
+    Error TiledImageLogger::try_log(
+        const RecordingStream& rec, const archetypes::SegmentationImage& image
+    ) {
+        return try_log_tiles(rec, image);
+    }
+
+    template <typename TArchetype>
+    Error TiledImageLogger::try_log_tiles(const RecordingStream& rec, const TArchetype& image) {
+        const auto& tensor = image.data.data;
+        if (tensor.shape.size() != 2 && tensor.shape.size() != 3) {
+            return Error(
+                ErrorCode::InvalidTensorDimension,
+                "Image shape is expected to be either rank 2 or 3."
+            );
+        }
+        if (_tile_size == 0) {
+            return Error(ErrorCode::InvalidTensorDimension, "Tile size must be positive.");
+        }
+        const size_t num_channels = tensor.shape.size() == 3 ? tensor.shape[2].size : 1;
+
+        Error err;
+        const bool has_elements = visit_elements(tensor.buffer, [&](const auto& elements) {
+            const size_t expected = tensor.shape[0].size * tensor.shape[1].size * num_channels;
+            if (elements.size() != expected) {
+                err = Error(
+                    ErrorCode::InvalidTensorDimension,
+                    "Image shape doesn't match the number of pixels, expected " +
+                        std::to_string(expected) + " elements, got " +
+                        std::to_string(elements.size()) + "."
+                );
+                return;
+            }
+            err = try_log_tiles(rec, image, elements.data(), num_channels);
+        });
+        if (!has_elements) {
+            return Error(
+                ErrorCode::InvalidTensorDimension,
+                "Only images with integer or float pixels can be logged as tiles."
+            );
+        }
+        if (err.is_err()) {
+            // Keeps the size, such that the tiles of the previous frame are still cleared.
+            _previous.clear();
+        }
+        return err;
+    }
+
+    template <typename TArchetype, typename TElement>
+    Error TiledImageLogger::try_log_tiles(
+        const RecordingStream& rec, const TArchetype& image, const TElement* pixels,
+        size_t num_channels
+    ) {
+        const auto& shape = image.data.data.shape;
+        const size_t height = shape[0].size;
+        const size_t width = shape[1].size;
+        const size_t pixel_size = num_channels * sizeof(TElement);
+        const size_t row_size = width * pixel_size;
+        const auto* bytes = reinterpret_cast<const uint8_t*>(pixels);
+
+        const size_t num_tiles_x = (width + _tile_size - 1) / _tile_size;
+        const size_t num_tiles_y = (height + _tile_size - 1) / _tile_size;
+        const auto tile_width = [&](size_t tile_x) {
+            return std::min(_tile_size, width - tile_x * _tile_size);
+        };
+        const auto tile_height = [&](size_t tile_y) {
+            return std::min(_tile_size, height - tile_y * _tile_size);
+        };
+
+        const auto tag = image.data.data.buffer.get_union_tag();
+        const bool is_new_image = _previous.size() != row_size * height || _width != width ||
+                                  _height != height || _num_channels != num_channels ||
+                                  _tag != tag;
+        std::vector<bool> dirty(num_tiles_x * num_tiles_y, is_new_image);
+
+        if (is_new_image) {
+            // Tiles outside of the new image would keep showing the previous frame.
+            const size_t num_previous_tiles_x = (_width + _tile_size - 1) / _tile_size;
+            const size_t num_previous_tiles_y = (_height + _tile_size - 1) / _tile_size;
+            for (size_t tile_y = 0; tile_y < num_previous_tiles_y; ++tile_y) {
+                for (size_t tile_x = 0; tile_x < num_previous_tiles_x; ++tile_x) {
+                    if (tile_x >= num_tiles_x || tile_y >= num_tiles_y) {
+                        RR_RETURN_NOT_OK(
+                            rec.try_log(tile_path(tile_x, tile_y), archetypes::Clear::FLAT)
+                        );
+                    }
+                }
+            }
+
+            _previous.assign(bytes, bytes + row_size * height);
+            _width = width;
+            _height = height;
+            _num_channels = num_channels;
+            _tag = tag;
+        } else {
+            for (size_t y = 0; y < height; ++y) {
+                const size_t row_offset = y * row_size;
+                for (size_t tile_x = 0; tile_x < num_tiles_x; ++tile_x) {
+                    const size_t tile = y / _tile_size * num_tiles_x + tile_x;
+                    if (dirty[tile]) {
+                        continue;
+                    }
+                    const size_t offset = row_offset + tile_x * _tile_size * pixel_size;
+                    dirty[tile] = std::memcmp(
+                                      bytes + offset,
+                                      _previous.data() + offset,
+                                      tile_width(tile_x) * pixel_size
+                                  ) != 0;
+                }
+            }
+        }
+
+        for (size_t tile_y = 0; tile_y < num_tiles_y; ++tile_y) {
+            for (size_t tile_x = 0; tile_x < num_tiles_x; ++tile_x) {
+                if (!dirty[tile_y * num_tiles_x + tile_x]) {
+                    continue;
+                }
+
+                const size_t x0 = tile_x * _tile_size;
+                const size_t y0 = tile_y * _tile_size;
+                const size_t tile_row_size = tile_width(tile_x) * pixel_size;
+                const size_t num_tile_elements =
+                    tile_height(tile_y) * tile_width(tile_x) * num_channels;
+
+                auto tile_pixels = detail::allocate_shared_array<TElement>(num_tile_elements);
+                auto* tile_bytes = reinterpret_cast<uint8_t*>(tile_pixels.get());
+                for (size_t y = 0; y < tile_height(tile_y); ++y) {
+                    const size_t offset = (y0 + y) * row_size + x0 * pixel_size;
+                    std::memcpy(tile_bytes + y * tile_row_size, bytes + offset, tile_row_size);
+                    if (!is_new_image) {
+                        std::memcpy(_previous.data() + offset, bytes + offset, tile_row_size);
+                    }
+                }
+
+                auto tile_shape = Collection<datatypes::TensorDimension>::build(
+                    shape.size(),
+                    [&](auto& new_shape) {
+                        new_shape.insert(new_shape.end(), shape.begin(), shape.end());
+                        new_shape[0].size = tile_height(tile_y);
+                        new_shape[1].size = tile_width(tile_x);
+                    }
+                );
+                TArchetype tile(datatypes::TensorData(
+                    std::move(tile_shape),
+                    Collection<TElement>::share(std::move(tile_pixels), num_tile_elements)
+                ));
+                tile.draw_order = image.draw_order;
+
+                if (is_new_image) {
+                    RR_RETURN_NOT_OK(rec.try_log_timeless(
+                        tile_path(tile_x, tile_y),
+                        archetypes::Transform3D(datatypes::Vec3D(
+                            static_cast<float>(x0),
+                            static_cast<float>(y0),
+                            0.0f
+                        ))
+                    ));
+                }
+                RR_RETURN_NOT_OK(rec.try_log(tile_path(tile_x, tile_y), tile));
+            }
+        }
+
+        return Error::ok();
+    }
+} // namespace rerun
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "datatypes/tensor_buffer.hpp"
+#include "error.hpp"
+
+namespace rerun {
+    class RecordingStream;
+
+    namespace archetypes {
+        struct Image;
+        struct SegmentationImage;
+    } // namespace archetypes
+
+    /// Logs large, mostly static images, e.g. occupancy maps, as tiles, of which only the ones
+    /// that changed since the previous frame are logged.
+    ///
+    /// Each tile is logged to a child entity `<entity_path>/tile_<x>_<y>`, where `x` and `y` are
+    /// the column and row of the tile. A timeless `Transform3D` moves each tile to its position
+    /// within the image.
+    /// ```
+    /// rerun::TiledImageLogger occupancy("map", 256);
+    /// while (mapping) {
+    ///     rec.set_time_seconds("time", now());
+    ///     occupancy.log(rec, rerun::SegmentationImage({4096, 4096}, grid.data()));
+    /// }
+    /// ```
+    /// The logged data then scales with the number of changed tiles rather than with the image
+    /// size. Finding them takes one `memcmp` per row of each tile, which the C library
+    /// implements with the widest vector instructions available, and stops comparing a tile at
+    /// its first difference.
+    ///
+    /// Keeps a copy of the previous frame. Not thread-safe.
+    class TiledImageLogger {
+      public:
+        /// \param entity_path Parent entity of the tiles.
+        /// \param tile_size Width and height of the tiles in pixels. Tiles at the right and bottom
+        /// edge are smaller if the image size isn't a multiple of it.
+        explicit TiledImageLogger(std::string entity_path, size_t tile_size = 256)
+            : _entity_path(std::move(entity_path)), _tile_size(tile_size) {}
+
+        /// Logs all tiles of the image that changed since the previous call.
+        ///
+        /// The first call, and any call that changes the image size or pixel type, logs all tiles.
+        /// If the image size changes, the tiles outside of the new image are cleared.
+        /// Failures are handled with `Error::handle`.
+        void log(const RecordingStream& rec, const archetypes::Image& image) {
+            try_log(rec, image).handle();
+        }
+
+        /// \copydoc log
+        void log(const RecordingStream& rec, const archetypes::SegmentationImage& image) {
+            try_log(rec, image).handle();
+        }
+
+        /// Logs all tiles of the image that changed since the previous call.
+        ///
+        /// See `log` for more information.
+        /// \returns An error if the image can't be tiled or logging fails. All tiles are logged
+        /// again on the next call in that case.
+        Error try_log(const RecordingStream& rec, const archetypes::Image& image);
+
+        /// \copydoc try_log
+        Error try_log(const RecordingStream& rec, const archetypes::SegmentationImage& image);
+
+        /// Makes the next call log all tiles, e.g. after switching to another recording stream.
+        ///
+        /// Also forgets the tiles of the previous frame, which aren't cleared if the image size
+        /// changes.
+        void reset() {
+            _previous.clear();
+            _width = 0;
+            _height = 0;
+        }
+
+      private:
+        template <typename TArchetype>
+        Error try_log_tiles(const RecordingStream& rec, const TArchetype& image);
+
+        template <typename TArchetype, typename TElement>
+        Error try_log_tiles(
+            const RecordingStream& rec, const TArchetype& image, const TElement* pixels,
+            size_t num_channels
+        );
+
+        std::string tile_path(size_t tile_x, size_t tile_y) const {
+            return _entity_path + "/tile_" + std::to_string(tile_x) + "_" + std::to_string(tile_y);
+        }
+
+        std::string _entity_path;
+        size_t _tile_size;
+
+        /// Previous frame, empty before the first frame.
+        std::vector<uint8_t> _previous;
+        size_t _width = 0;
+        size_t _height = 0;
+        size_t _num_channels = 0;
+        datatypes::detail::TensorBufferTag _tag = datatypes::detail::TensorBufferTag::None;
+    };
+} // namespace rerun
@@ -0,0 +1,16 @@
+#include "time_column.hpp"
+
+#include <cmath>
+
+namespace rerun {
+    TimeColumn TimeColumn::from_seconds(
+        std::string timeline_name, const double* seconds, size_t num_seconds
+    ) {
+        auto nanoseconds = Collection<int64_t>::build(num_seconds, [&](auto& times) {
+            for (size_t i = 0; i < num_seconds; ++i) {
+                times.push_back(static_cast<int64_t>(std::round(seconds[i] * 1e9)));
+            }
+        });
+        return from_nanoseconds(std::move(timeline_name), std::move(nanoseconds));
+    }
+} // namespace rerun
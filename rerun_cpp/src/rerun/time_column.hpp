@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "collection.hpp"
+
+namespace rerun {
+    /// Type of the time points of a timeline.
+    enum class TimeType {
+        /// Sequence numbers, e.g. frame numbers.
+        Sequence,
+
+        /// Nanoseconds since the Unix epoch.
+        Time,
+    };
+
+    /// Time points of a batch of rows on a single timeline.
+    ///
+    /// \see RecordingStream::log_temporal_batch
+    struct TimeColumn {
+        /// The name of the timeline, e.g. `sim_time`.
+        std::string timeline_name;
+
+        /// Whether the time points are sequence numbers or nanoseconds.
+        TimeType time_type;
+
+        /// One time point per row.
+        Collection<int64_t> times;
+
+      public:
+        TimeColumn(std::string timeline_name_, TimeType time_type_, Collection<int64_t> times_)
+            : timeline_name(std::move(timeline_name_)),
+              time_type(time_type_),
+              times(std::move(times_)) {}
+
+        /// Time column of sequence numbers, e.g. frame numbers.
+        static TimeColumn from_sequence_points(
+            std::string timeline_name, Collection<int64_t> sequence_points
+        ) {
+            return TimeColumn(
+                std::move(timeline_name),
+                TimeType::Sequence,
+                std::move(sequence_points)
+            );
+        }
+
+        /// Time column of nanoseconds since the Unix epoch.
+        static TimeColumn from_nanoseconds(
+            std::string timeline_name, Collection<int64_t> nanoseconds
+        ) {
+            return TimeColumn(std::move(timeline_name), TimeType::Time, std::move(nanoseconds));
+        }
+
+        /// Time column of seconds since the Unix epoch, which are converted to nanoseconds.
+        static TimeColumn from_seconds(
+            std::string timeline_name, const double* seconds, size_t num_seconds
+        );
+    };
+} // namespace rerun
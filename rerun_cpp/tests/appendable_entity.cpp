@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <rerun.hpp>
+
+#include <vector>
+
+#define TEST_TAG "[appendable_entity]"
+
+/// Number of log calls to the chunks since the last call.
+static size_t num_chunk_logs(const rerun::RecordingStream& stream, size_t& num_previous_logs) {
+    const auto stats = stream.rate_limit_stats();
+    REQUIRE(stats.size() == 1);
+    const size_t num_logs = stats[0].num_logged + stats[0].num_suppressed;
+    const size_t num_new_logs = num_logs - num_previous_logs;
+    num_previous_logs = num_logs;
+    return num_new_logs;
+}
+
+SCENARIO("AppendableEntity logs only new and edited chunks", TEST_TAG) {
+    using Geometry = rerun::AppendableEntity::Geometry;
+
+    GIVEN("a point cloud with chunks of 4 points") {
+        rerun::RecordingStream stream("test");
+        // The rate limit stats count the log calls to the chunks.
+        stream.set_rate_limit("map/**", 0.001);
+        size_t num_logs = 0;
+
+        rerun::AppendableEntity map("map", Geometry::Points, 4);
+        std::vector<rerun::Vec3D> points(10, rerun::Vec3D{1.0f, 2.0f, 3.0f});
+        map.append(points.data(), points.size());
+
+        THEN("the first call logs all chunks") {
+            CHECK(map.try_log(stream).is_ok());
+            CHECK(num_chunk_logs(stream, num_logs) == 3);
+
+            AND_THEN("logging again without changes logs nothing") {
+                CHECK(map.try_log(stream).is_ok());
+                CHECK(num_chunk_logs(stream, num_logs) == 0);
+            }
+            AND_THEN("appending a point logs only the last chunk") {
+                map.append(rerun::Vec3D{4.0f, 5.0f, 6.0f});
+                CHECK(map.try_log(stream).is_ok());
+                CHECK(num_chunk_logs(stream, num_logs) == 1);
+
+                AND_THEN("filling the last chunk and starting a new one logs both") {
+                    map.append(points.data(), 2);
+                    CHECK(map.try_log(stream).is_ok());
+                    CHECK(num_chunk_logs(stream, num_logs) == 2);
+                }
+            }
+            AND_THEN("replacing points logs only their chunks") {
+                const std::vector<rerun::Vec3D> corrected(2, rerun::Vec3D{0.0f, 0.0f, 0.0f});
+                CHECK(map.try_replace(3, corrected.data(), corrected.size()).is_ok());
+                CHECK(map.positions()[4].x() == 0.0f);
+                CHECK(map.try_log(stream).is_ok());
+                CHECK(num_chunk_logs(stream, num_logs) == 2);
+            }
+            AND_THEN("resetting logs all chunks again") {
+                map.reset();
+                CHECK(map.try_log(stream).is_ok());
+                CHECK(num_chunk_logs(stream, num_logs) == 3);
+            }
+        }
+        THEN("replacing points that weren't appended fails") {
+            CHECK(
+                map.try_replace(8, points.data(), 3).code ==
+                rerun::ErrorCode::InvalidAppendableEntity
+            );
+        }
+    }
+
+    GIVEN("a trajectory with chunks of 4 points") {
+        rerun::RecordingStream stream("test");
+        stream.set_rate_limit("trajectory/**", 0.001);
+        size_t num_logs = 0;
+
+        rerun::AppendableEntity trajectory("trajectory", Geometry::LineStrip, 4);
+        const std::vector<rerun::Vec3D> points(8, rerun::Vec3D{1.0f, 2.0f, 3.0f});
+        trajectory.append(points.data(), points.size());
+        CHECK(trajectory.try_log(stream).is_ok());
+        CHECK(num_chunk_logs(stream, num_logs) == 2);
+
+        THEN("replacing the last point of a chunk also logs the next chunk") {
+            CHECK(trajectory.try_replace(3, points.data(), 1).is_ok());
+            CHECK(trajectory.try_log(stream).is_ok());
+            CHECK(num_chunk_logs(stream, num_logs) == 2);
+        }
+        THEN("replacing the first point of a chunk logs only that chunk") {
+            CHECK(trajectory.try_replace(4, points.data(), 1).is_ok());
+            CHECK(trajectory.try_log(stream).is_ok());
+            CHECK(num_chunk_logs(stream, num_logs) == 1);
+        }
+    }
+
+    GIVEN("a chunk size of zero") {
+        rerun::RecordingStream stream("test");
+        rerun::AppendableEntity map("map", Geometry::Points, 0);
+        map.append(rerun::Vec3D{1.0f, 2.0f, 3.0f});
+
+        THEN("logging fails") {
+            CHECK(map.try_log(stream).code == rerun::ErrorCode::InvalidAppendableEntity);
+        }
+    }
+}
@@ -0,0 +1,150 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <rerun.hpp>
+
+#include <arrow/record_batch.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "error_check.hpp"
+
+#define TEST_TAG "[callback_sink]"
+
+SCENARIO("RecordingStream can pass its log data to a callback", TEST_TAG) {
+    GIVEN("a recording stream") {
+        // Declared first, so the callbacks never outlive it.
+        std::vector<rerun::SinkChunk> chunks;
+        std::mutex mutex;
+        std::condition_variable chunk_received;
+        size_t num_chunks = 0;
+        rerun::RecordingStream stream("test");
+
+        WHEN("setting an empty callback") {
+            THEN("it fails") {
+                CHECK(stream.set_sink(nullptr).code == rerun::ErrorCode::UnexpectedNullArgument);
+            }
+        }
+        WHEN("setting an .rrd callback and logging") {
+            rerun::SinkOptions options;
+            options.format = rerun::SinkFormat::Rrd;
+            options.min_chunk_bytes = 1024 * 1024;
+            options.max_chunk_delay_sec = 3600.0f;
+            const auto status = stream.set_sink(
+                [&](rerun::SinkChunk chunk) { chunks.push_back(std::move(chunk)); },
+                options
+            );
+            REQUIRE(status.is_ok());
+            check_logged_error([&] {
+                stream.log("points", rerun::Points3D({{1.0f, 2.0f, 3.0f}}));
+                stream.log("points", rerun::Points3D({{4.0f, 5.0f, 6.0f}}));
+            });
+            stream.flush_blocking();
+
+            THEN("the callback receives all of it in one chunk") {
+                REQUIRE(chunks.size() == 1);
+                REQUIRE(chunks[0].size() > 4);
+                CHECK(std::memcmp(chunks[0].data(), "RRF2", 4) == 0);
+                CHECK(chunks[0].record_batch() == nullptr);
+
+                AND_THEN("the chunks outlive the sink") {
+                    REQUIRE(stream.set_sink([](rerun::SinkChunk) {}).is_ok());
+                    CHECK(chunks[0].data() != nullptr);
+
+                    chunks[0].release();
+                    CHECK(chunks[0].data() == nullptr);
+                    CHECK(chunks[0].size() == 0);
+                }
+            }
+        }
+        WHEN("setting an .rrd callback that passes on every message") {
+            rerun::SinkOptions options;
+            options.format = rerun::SinkFormat::Rrd;
+            options.min_chunk_bytes = 0;
+            const auto status = stream.set_sink(
+                [&](rerun::SinkChunk chunk) { chunks.push_back(std::move(chunk)); },
+                options
+            );
+            REQUIRE(status.is_ok());
+            check_logged_error([&] {
+                stream.log("points", rerun::Points3D({{1.0f, 2.0f, 3.0f}}));
+                stream.log("points", rerun::Points3D({{4.0f, 5.0f, 6.0f}}));
+            });
+            stream.flush_blocking();
+
+            THEN("only the first chunk starts with the file header") {
+                REQUIRE(chunks.size() >= 2);
+                for (size_t i = 0; i < chunks.size(); ++i) {
+                    REQUIRE(chunks[i].size() > 4);
+                    CHECK((std::memcmp(chunks[i].data(), "RRF2", 4) == 0) == (i == 0));
+                }
+            }
+        }
+        WHEN("setting an .rrd callback with a short delay and logging once") {
+            rerun::SinkOptions options;
+            options.format = rerun::SinkFormat::Rrd;
+            options.min_chunk_bytes = 1024 * 1024;
+            options.max_chunk_delay_sec = 0.01f;
+            const auto status = stream.set_sink(
+                [&](rerun::SinkChunk) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ++num_chunks;
+                    chunk_received.notify_all();
+                },
+                options
+            );
+            REQUIRE(status.is_ok());
+            check_logged_error([&] {
+                stream.log("points", rerun::Points3D({{1.0f, 2.0f, 3.0f}}));
+            });
+
+            THEN("the callback receives it without further messages or a flush") {
+                std::unique_lock<std::mutex> lock(mutex);
+                CHECK(chunk_received.wait_for(lock, std::chrono::seconds(10), [&] {
+                    return num_chunks > 0;
+                }));
+            }
+        }
+        WHEN("setting an Arrow callback and logging") {
+            rerun::SinkOptions options;
+            options.format = rerun::SinkFormat::Arrow;
+            const auto status = stream.set_sink(
+                [&](rerun::SinkChunk chunk) { chunks.push_back(std::move(chunk)); },
+                options
+            );
+            REQUIRE(status.is_ok());
+            check_logged_error([&] {
+                stream.log("points", rerun::Points3D({{1.0f, 2.0f, 3.0f}}));
+            });
+            stream.flush_blocking();
+
+            THEN("the callback receives the logged table") {
+                REQUIRE_FALSE(chunks.empty());
+                REQUIRE(chunks.back().record_batch() != nullptr);
+                CHECK(chunks.back().record_batch()->num_rows() == 1);
+                CHECK(chunks.back().data() == nullptr);
+            }
+        }
+        WHEN("setting a callback that throws") {
+            const auto status = stream.set_sink([](rerun::SinkChunk) {
+                throw std::runtime_error("callback failed");
+            });
+            REQUIRE(status.is_ok());
+
+            THEN("flushing reports the exception") {
+                check_logged_error(
+                    [&] {
+                        stream.log("points", rerun::Points3D({{1.0f, 2.0f, 3.0f}}));
+                        stream.flush_blocking();
+                    },
+                    rerun::ErrorCode::RecordingStreamRuntimeFailure
+                );
+            }
+        }
+    }
+}
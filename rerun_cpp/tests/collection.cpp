@@ -413,6 +413,24 @@ namespace rerun {
     };
 } // namespace rerun
 
+SCENARIO("Collection creation via the shared vector adapter", TEST_TAG) {
+    GIVEN("a shared immutable vector of elements") {
+        auto data = std::make_shared<const std::vector<Element>>(
+            std::vector<Element> EXPECTED_ELEMENT_LIST
+        );
+
+        THEN("a collection created from it shares the data") {
+            CheckElementMoveAndCopyCount check; // No move or copy.
+
+            const rerun::Collection<Element> collection(data);
+            check_for_expected_list(collection);
+            CHECK(collection.get_ownership() == rerun::CollectionOwnership::Shared);
+            CHECK(collection.data() == data->data());
+            CHECK(data.use_count() == 2);
+        }
+    }
+}
+
 SCENARIO("Collection creation via a custom adapter for a datalayout compatible type", TEST_TAG) {
     GIVEN("A custom vec2 container with a defined adapter") {
         MyVec2Container container;
@@ -508,6 +526,37 @@ SCENARIO("Move construction/assignment of collections", TEST_TAG) {
             CHECK(borrowed.get_ownership() == rerun::CollectionOwnership::Borrowed);
         }
     }
+    GIVEN("A shared collection") {
+        auto shared = rerun::Collection<Position2D>::share(std::vector(components));
+
+        THEN("then moving to a new batch moves the data and clears the source") {
+            auto target(std::move(shared));
+            CHECK(target.size() == 2);
+            CHECK(target.get_ownership() == rerun::CollectionOwnership::Shared);
+            CHECK(shared.size() == 0);
+            CHECK(shared.empty());
+
+            CHECK(shared.get_ownership() == rerun::CollectionOwnership::Borrowed);
+        }
+        THEN("moving it to an owned collection swaps their data") {
+            auto target = rerun::Collection<Position2D>::take_ownership(std::vector(components));
+
+            target = std::move(shared);
+            CHECK(target.size() == 2);
+            CHECK(target.get_ownership() == rerun::CollectionOwnership::Shared);
+            CHECK(shared.size() == 2);
+            CHECK(shared.get_ownership() == rerun::CollectionOwnership::VectorOwned);
+        }
+        THEN("moving it to an borrowed collection swaps their data") {
+            auto target = rerun::Collection<Position2D>::borrow(components.data(), 2);
+
+            target = std::move(shared);
+            CHECK(target.size() == 2);
+            CHECK(target.get_ownership() == rerun::CollectionOwnership::Shared);
+            CHECK(shared.size() == 2);
+            CHECK(shared.get_ownership() == rerun::CollectionOwnership::Borrowed);
+        }
+    }
 
     // Uncomment to check if the error message for missing adapter is sane:
     //std::vector<std::string> strings = {"a", "b", "c"};
@@ -623,6 +672,42 @@ SCENARIO("Copy/move construction/assignment of collections", TEST_TAG) {
             check_for_expected_list(collection2);
         }
     }
+
+    GIVEN("a collection with shared data") {
+        auto collection =
+            rerun::Collection<Element>::share(std::vector<Element> EXPECTED_ELEMENT_LIST);
+        const Element* old_data_ptr = collection.data();
+
+        THEN("it can be move constructed") {
+            CheckElementMoveAndCopyCount check; // No move or copy.
+
+            rerun::Collection<Element> collection2(std::move(collection));
+            check_for_expected_list(collection2);
+            CHECK(collection2.data() == old_data_ptr);
+        }
+        THEN("it can be copy constructed without copying the data") {
+            CheckElementMoveAndCopyCount check; // No move or copy.
+
+            rerun::Collection<Element> collection2(collection);
+            check_for_expected_list(collection2);
+            CHECK(collection2.data() == old_data_ptr);
+            CHECK(collection2.get_ownership() == rerun::CollectionOwnership::Shared);
+        }
+        THEN("it can be copy assigned without copying the data") {
+            CheckElementMoveAndCopyCount check; // No move or copy.
+
+            rerun::Collection<Element> collection2;
+
+            collection2 = collection;
+            check_for_expected_list(collection2);
+            CHECK(collection2.data() == old_data_ptr);
+        }
+        THEN("the data outlives the original collection") {
+            rerun::Collection<Element> collection2(collection);
+            collection = rerun::Collection<Element>();
+            check_for_expected_list(collection2);
+        }
+    }
 }
 
 SCENARIO("Conversion to vector using `to_vector`", TEST_TAG) {
@@ -651,3 +736,80 @@ SCENARIO("Conversion to vector using `to_vector`", TEST_TAG) {
         }
     }
 }
+
+#if RERUN_HAS_MEMORY_RESOURCE
+// Memory resource that counts its allocations.
+struct CountingMemoryResource : std::pmr::memory_resource {
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++num_allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    int num_allocations = 0;
+};
+
+SCENARIO("Collections allocate from the current collection memory resource", TEST_TAG) {
+    CountingMemoryResource resource;
+
+    GIVEN("an active collection memory resource scope") {
+        rerun::CollectionMemoryResourceScope scope(&resource);
+
+        THEN("converting elements allocates from the memory resource") {
+            std::vector<ConvertibleElement> data EXPECTED_ELEMENT_LIST;
+            const rerun::Collection<Element> collection(data);
+
+            check_for_expected_list(collection);
+            CHECK(collection.get_ownership() == rerun::CollectionOwnership::Shared);
+            CHECK(resource.num_allocations > 0);
+        }
+        THEN("an initializer list allocates from the memory resource") {
+            const rerun::Collection<Element> collection EXPECTED_ELEMENT_LIST;
+
+            check_for_expected_list(collection);
+            CHECK(resource.num_allocations > 0);
+        }
+        THEN("the previous memory resource is restored when the scope ends") {
+            {
+                rerun::CollectionMemoryResourceScope inner_scope(nullptr);
+                CHECK(rerun::get_collection_memory_resource() == nullptr);
+            }
+            CHECK(rerun::get_collection_memory_resource() == &resource);
+        }
+    }
+
+    GIVEN("a temporary std::pmr::vector of elements") {
+        std::pmr::vector<Element> data(&resource);
+        data.emplace_back(1337);
+        data.emplace_back(42);
+        const Element* data_ptr = data.data();
+
+        THEN("the collection takes ownership without copying the data") {
+            CheckElementMoveAndCopyCount check; // No move or copy.
+
+            const rerun::Collection<Element> collection(std::move(data));
+            check_for_expected_list(collection);
+            CHECK(collection.data() == data_ptr);
+            CHECK(collection.get_ownership() == rerun::CollectionOwnership::Shared);
+        }
+    }
+
+    GIVEN("no active collection memory resource scope") {
+        THEN("converting elements allocates via std::vector") {
+            std::vector<ConvertibleElement> data EXPECTED_ELEMENT_LIST;
+            const rerun::Collection<Element> collection(data);
+
+            check_for_expected_list(collection);
+            CHECK(collection.get_ownership() == rerun::CollectionOwnership::VectorOwned);
+            CHECK(resource.num_allocations == 0);
+        }
+    }
+}
+#endif
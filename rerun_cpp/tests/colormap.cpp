@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <rerun/colormap.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#define TEST_TAG "[colormap]"
+
+SCENARIO("Colormaps match the viewer", TEST_TAG) {
+    const auto rgba = [](rerun::Colormap colormap, float t) {
+        return rerun::colormap::color(colormap, t).rgba.rgba;
+    };
+
+    THEN("grayscale maps the range to all gray levels") {
+        CHECK(rgba(rerun::Colormap::Grayscale, 0.0f) == 0x000000FFu);
+        CHECK(rgba(rerun::Colormap::Grayscale, 0.5f) == 0x808080FFu);
+        CHECK(rgba(rerun::Colormap::Grayscale, 1.0f) == 0xFFFFFFFFu);
+    }
+    THEN("the first colors are the ones of the viewer's polynomials") {
+        CHECK(rgba(rerun::Colormap::Turbo, 0.0f) == 0x22171BFFu);
+        CHECK(rgba(rerun::Colormap::Viridis, 0.0f) == 0x460155FFu);
+    }
+    THEN("values outside of the range are clamped") {
+        CHECK(rgba(rerun::Colormap::Turbo, -1.0f) == rgba(rerun::Colormap::Turbo, 0.0f));
+        CHECK(rgba(rerun::Colormap::Turbo, 2.0f) == rgba(rerun::Colormap::Turbo, 1.0f));
+    }
+}
+
+SCENARIO("Colorizing values", TEST_TAG) {
+    const auto gray = rerun::Colormap::Grayscale;
+
+    GIVEN("floats with a NaN") {
+        const std::vector<float> values = {
+            -1.0f,
+            std::numeric_limits<float>::quiet_NaN(),
+            3.0f,
+            1.0f,
+        };
+
+        THEN("the automatic range only covers finite values") {
+            const auto range = rerun::colormap::value_range(values.data(), values.size());
+            CHECK(range.min == -1.0f);
+            CHECK(range.max == 3.0f);
+        }
+        THEN("colorize normalizes to the value range and maps NaN to the first color") {
+            const auto colors = rerun::colormap::colorize(gray, values.data(), values.size());
+            REQUIRE(colors.size() == 4);
+            CHECK(colors[0].r() == 0);
+            CHECK(colors[1].r() == 0);
+            CHECK(colors[2].r() == 255);
+            CHECK(colors[3].r() == 128);
+        }
+        THEN("colorize uses an explicit range") {
+            const auto colors = rerun::colormap::colorize(
+                gray,
+                values.data(),
+                values.size(),
+                rerun::colormap::Range{0.0f, 1.0f}
+            );
+            CHECK(colors[2].r() == 255);
+            CHECK(colors[3].r() == 255);
+        }
+    }
+
+    GIVEN("16-bit depth") {
+        const std::vector<uint16_t> depth = {1000, 2000, 3000, 1000, 2000, 3000};
+
+        THEN("colorize_image creates an RGB image") {
+            const auto image = rerun::colormap::colorize_image(gray, depth.data(), 3, 2);
+            const auto& tensor = image.data.data;
+            REQUIRE(tensor.shape.size() == 3);
+            CHECK(tensor.shape[0].size == 2);
+            CHECK(tensor.shape[1].size == 3);
+            CHECK(tensor.shape[2].size == 3);
+
+            const auto* rgb = tensor.buffer.get_u8();
+            REQUIRE(rgb != nullptr);
+            const std::vector<uint8_t> row = {0, 0, 0, 128, 128, 128, 255, 255, 255};
+            for (size_t i = 0; i < rgb->size(); ++i) {
+                CHECK((*rgb)[i] == row[i % row.size()]);
+            }
+        }
+    }
+
+    GIVEN("a constant value") {
+        const std::vector<float> values = {5.0f, 5.0f};
+
+        THEN("all values get the first color") {
+            const auto colors = rerun::colormap::colorize(gray, values.data(), values.size());
+            CHECK(colors[0].r() == 0);
+            CHECK(colors[1].r() == 0);
+        }
+    }
+}
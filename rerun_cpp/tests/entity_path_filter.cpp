@@ -0,0 +1,59 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <rerun.hpp>
+
+#define TEST_TAG "[entity_path_filter]"
+
+SCENARIO("EntityPathFilter decides which entity paths are included", TEST_TAG) {
+    GIVEN("an empty filter") {
+        rerun::EntityPathFilter filter;
+
+        THEN("all entity paths are included") {
+            CHECK(filter.empty());
+            CHECK(filter.is_included("/"));
+            CHECK(filter.is_included("world/points"));
+        }
+    }
+
+    GIVEN("a filter excluding a subtree with an exception") {
+        auto filter = rerun::EntityPathFilter::parse("- world/debug/**\n+ world/debug/important");
+        REQUIRE(filter.is_ok());
+
+        THEN("the excluded subtree including its root is excluded") {
+            CHECK_FALSE(filter.value.is_included("world/debug"));
+            CHECK_FALSE(filter.value.is_included("/world/debug/points/"));
+        }
+        THEN("the later include rule takes precedence") {
+            CHECK(filter.value.is_included("world/debug/important"));
+            CHECK_FALSE(filter.value.is_included("world/debug/important/child"));
+        }
+        THEN("paths not matched by any rule are included") {
+            CHECK(filter.value.is_included("world"));
+            CHECK(filter.value.is_included("world/debugging"));
+        }
+    }
+
+    GIVEN("a filter excluding everything but single part wildcard matches") {
+        auto filter = rerun::EntityPathFilter::parse("-**, +cameras/*/image");
+        REQUIRE(filter.is_ok());
+
+        THEN("only matching paths are included") {
+            CHECK(filter.value.is_included("cameras/left/image"));
+            CHECK_FALSE(filter.value.is_included("cameras/left"));
+            CHECK_FALSE(filter.value.is_included("cameras/left/image/depth"));
+            CHECK_FALSE(filter.value.is_included("world"));
+        }
+    }
+
+    GIVEN("malformed rules") {
+        auto rules = GENERATE("world/**/points", "world/point*", "+", " - ");
+
+        THEN("parsing fails with InvalidEntityPathFilter") {
+            CHECK(
+                rerun::EntityPathFilter::parse(rules).error.code ==
+                rerun::ErrorCode::InvalidEntityPathFilter
+            );
+        }
+    }
+}
@@ -0,0 +1,145 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <rerun/image_conversion.hpp>
+
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+#define TEST_TAG "[image_conversion]"
+
+// Decodes limited range BT.601 YUV the same way the viewer does.
+static std::array<int, 3> yuv_to_rgb(uint8_t y, uint8_t u, uint8_t v) {
+    const float yf = (static_cast<float>(y) - 16.0f) / 219.0f;
+    const float uf = (static_cast<float>(u) - 128.0f) / 224.0f;
+    const float vf = (static_cast<float>(v) - 128.0f) / 224.0f;
+    return {
+        static_cast<int>((yf + 1.402f * vf) * 255.0f + 0.5f),
+        static_cast<int>((yf - 0.344f * uf - 0.714f * vf) * 255.0f + 0.5f),
+        static_cast<int>((yf + 1.772f * uf) * 255.0f + 0.5f),
+    };
+}
+
+static bool is_close(const std::array<int, 3>& decoded, const uint8_t* rgb) {
+    for (size_t c = 0; c < 3; ++c) {
+        if (std::abs(decoded[c] - static_cast<int>(rgb[c])) > 3) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SCENARIO("Swizzling BGR(A) to RGB(A)", TEST_TAG) {
+    GIVEN("BGR pixels") {
+        const std::vector<uint8_t> bgr = {1, 2, 3, 4, 5, 6};
+
+        THEN("bgr_to_rgb swaps red and blue") {
+            std::vector<uint8_t> rgb(bgr.size());
+            rerun::image::bgr_to_rgb(bgr.data(), rgb.data(), 2);
+            CHECK(rgb == std::vector<uint8_t>{3, 2, 1, 6, 5, 4});
+        }
+        THEN("bgr_to_rgb works in place") {
+            auto rgb = bgr;
+            rerun::image::bgr_to_rgb(rgb.data(), rgb.data(), 2);
+            CHECK(rgb == std::vector<uint8_t>{3, 2, 1, 6, 5, 4});
+        }
+        THEN("bgr_image creates an RGB image") {
+            const auto image = rerun::image::bgr_image(bgr.data(), 2, 1);
+            const auto& tensor = image.data.data;
+            CHECK(tensor.shape.size() == 3);
+            CHECK(tensor.shape[0].size == 1);
+            CHECK(tensor.shape[1].size == 2);
+            CHECK(tensor.shape[2].size == 3);
+            CHECK(tensor.buffer.get_union_tag() == rerun::datatypes::detail::TensorBufferTag::U8);
+        }
+    }
+
+    GIVEN("BGRA pixels") {
+        const std::vector<uint8_t> bgra = {1, 2, 3, 4, 5, 6, 7, 8};
+
+        THEN("bgra_to_rgba swaps red and blue and keeps alpha") {
+            std::vector<uint8_t> rgba(bgra.size());
+            rerun::image::bgra_to_rgba(bgra.data(), rgba.data(), 2);
+            CHECK(rgba == std::vector<uint8_t>{3, 2, 1, 4, 7, 6, 5, 8});
+        }
+    }
+}
+
+SCENARIO("Converting RGB to YUV formats", TEST_TAG) {
+    GIVEN("a 4x2 RGB image with uniformly colored 2x2 blocks") {
+        const uint8_t colors[2][3] = {{200, 30, 90}, {10, 220, 128}};
+        std::vector<uint8_t> rgb;
+        for (size_t y = 0; y < 2; ++y) {
+            for (size_t x = 0; x < 4; ++x) {
+                rgb.insert(rgb.end(), colors[x / 2], colors[x / 2] + 3);
+            }
+        }
+
+        THEN("NV12 decodes to the original colors") {
+            std::vector<uint8_t> nv12(4 * 2 * 3 / 2);
+            rerun::image::rgb_to_nv12(rgb.data(), 4, 2, nv12.data());
+
+            const uint8_t* uv = nv12.data() + 4 * 2;
+            for (size_t x = 0; x < 4; ++x) {
+                const auto decoded = yuv_to_rgb(nv12[x], uv[x / 2 * 2], uv[x / 2 * 2 + 1]);
+                CHECK(is_close(decoded, colors[x / 2]));
+            }
+        }
+        THEN("YUY2 decodes to the original colors") {
+            std::vector<uint8_t> yuy2(4 * 2 * 2);
+            rerun::image::rgb_to_yuy2(rgb.data(), 4, 2, yuy2.data());
+
+            for (size_t x = 0; x < 4; ++x) {
+                const uint8_t* pair = yuy2.data() + x / 2 * 4;
+                const auto decoded = yuv_to_rgb(pair[x % 2 * 2], pair[1], pair[3]);
+                CHECK(is_close(decoded, colors[x / 2]));
+            }
+        }
+        THEN("nv12_image has the stacked plane shape the viewer expects") {
+            const auto image = rerun::image::nv12_image(rgb.data(), 4, 2);
+            const auto& tensor = image.data.data;
+            CHECK(tensor.shape.size() == 2);
+            CHECK(tensor.shape[0].size == 3);
+            CHECK(tensor.shape[1].size == 4);
+            CHECK(tensor.buffer.get_union_tag() == rerun::datatypes::detail::TensorBufferTag::NV12);
+        }
+        THEN("yuy2_image has two bytes per pixel along the width") {
+            const auto image = rerun::image::yuy2_image(rgb.data(), 4, 2);
+            const auto& tensor = image.data.data;
+            CHECK(tensor.shape.size() == 2);
+            CHECK(tensor.shape[0].size == 2);
+            CHECK(tensor.shape[1].size == 8);
+            CHECK(tensor.buffer.get_union_tag() == rerun::datatypes::detail::TensorBufferTag::YUY2);
+        }
+    }
+}
+
+SCENARIO("Demosaicing Bayer images", TEST_TAG) {
+    GIVEN("a uniformly colored 4x4 RGGB image") {
+        const uint8_t color[3] = {200, 100, 50};
+        std::vector<uint8_t> raw(4 * 4);
+        for (size_t y = 0; y < 4; ++y) {
+            for (size_t x = 0; x < 4; ++x) {
+                const size_t channel = (y % 2) + (x % 2);
+                raw[y * 4 + x] = color[channel];
+            }
+        }
+
+        THEN("every demosaiced pixel has the original color") {
+            std::vector<uint8_t> rgb(4 * 4 * 3);
+            rerun::image::bayer_to_rgb(
+                raw.data(),
+                4,
+                4,
+                rerun::image::BayerPattern::RGGB,
+                rgb.data()
+            );
+
+            for (size_t i = 0; i < 4 * 4; ++i) {
+                CHECK(rgb[i * 3 + 0] == color[0]);
+                CHECK(rgb[i * 3 + 1] == color[1]);
+                CHECK(rgb[i * 3 + 2] == color[2]);
+            }
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <rerun/archetypes/depth_image.hpp>
+#include <rerun/archetypes/image.hpp>
+#include <rerun/image_downscale.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#define TEST_TAG "[image_downscale]"
+
+SCENARIO("Downscaling images by averaging", TEST_TAG) {
+    GIVEN("a 3x3 RGB image, not a multiple of the factor") {
+        // Red increases with x, green with y, blue is constant.
+        std::vector<uint8_t> rgb;
+        for (uint8_t y = 0; y < 30; y += 10) {
+            for (uint8_t x = 0; x < 30; x += 10) {
+                rgb.insert(rgb.end(), {x, y, 7});
+            }
+        }
+
+        THEN("downscaling by 2 averages full and partial blocks") {
+            std::vector<uint8_t> downscaled(2 * 2 * 3);
+            rerun::image::downscale(rgb.data(), 3, 3, 3, 2, downscaled.data());
+            CHECK(downscaled == std::vector<uint8_t>{5, 5, 7, 20, 5, 7, 5, 20, 7, 20, 20, 7});
+        }
+        THEN("Image::downscaled keeps dimension names and updates the shape") {
+            const auto image = rerun::archetypes::Image({3, 3, 3}, rgb.data()).downscaled(2);
+            const auto& tensor = image.data.data;
+            REQUIRE(tensor.shape.size() == 3);
+            CHECK(tensor.shape[0].size == 2);
+            CHECK(tensor.shape[1].size == 2);
+            CHECK(tensor.shape[2].size == 3);
+            CHECK(tensor.shape[0].name == "height");
+            CHECK(tensor.buffer.get_union_tag() == rerun::datatypes::detail::TensorBufferTag::U8);
+        }
+    }
+
+    GIVEN("a 4x2 float image with one channel") {
+        const std::vector<float> pixels = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f};
+
+        THEN("downscaling by 4 averages all pixels of each block") {
+            std::vector<float> downscaled(1);
+            rerun::image::downscale(pixels.data(), 4, 2, 1, 4, downscaled.data());
+            CHECK(downscaled[0] == 3.5f);
+        }
+        THEN("downscaling by 0 fails") {
+            const auto tensor = rerun::datatypes::TensorData({2, 4}, pixels.data());
+            CHECK(rerun::image::downscale_image_data(tensor, 0).is_err());
+        }
+    }
+}
+
+SCENARIO("Downscaling depth images", TEST_TAG) {
+    GIVEN("a 2x2 depth image with an invalid pixel") {
+        const std::vector<uint16_t> depth = {0, 300, 200, 100};
+
+        THEN("the min mode picks the closest valid depth") {
+            uint16_t downscaled = 0;
+            rerun::image::downscale_depth(
+                depth.data(),
+                2,
+                2,
+                2,
+                rerun::image::DepthDownscaleMode::Min,
+                &downscaled
+            );
+            CHECK(downscaled == 100);
+        }
+        THEN("the max mode picks the farthest valid depth") {
+            uint16_t downscaled = 0;
+            rerun::image::downscale_depth(
+                depth.data(),
+                2,
+                2,
+                2,
+                rerun::image::DepthDownscaleMode::Max,
+                &downscaled
+            );
+            CHECK(downscaled == 300);
+        }
+        THEN("the nearest mode picks the center pixel without mixing depths") {
+            uint16_t downscaled = 0;
+            rerun::image::downscale_depth(
+                depth.data(),
+                2,
+                2,
+                2,
+                rerun::image::DepthDownscaleMode::Nearest,
+                &downscaled
+            );
+            CHECK(downscaled == 100);
+        }
+        THEN("DepthImage::downscaled keeps the meter") {
+            const auto image = rerun::archetypes::DepthImage({2, 2}, depth.data())
+                                   .with_meter(1000.0f)
+                                   .downscaled(2);
+            CHECK(image.data.data.shape[0].size == 1);
+            CHECK(image.data.data.shape[1].size == 1);
+            REQUIRE(image.meter.has_value());
+            CHECK(image.meter.value().value == 1000.0f);
+        }
+    }
+
+    GIVEN("a float depth image without any valid depth") {
+        const std::vector<float> depth = {std::numeric_limits<float>::quiet_NaN(), -1.0f};
+
+        THEN("the min mode produces zero") {
+            float downscaled = 1.0f;
+            rerun::image::downscale_depth(
+                depth.data(),
+                2,
+                1,
+                2,
+                rerun::image::DepthDownscaleMode::Min,
+                &downscaled
+            );
+            CHECK(downscaled == 0.0f);
+        }
+    }
+}
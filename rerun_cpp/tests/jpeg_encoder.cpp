@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <rerun/jpeg_encoder.hpp>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#define TEST_TAG "[jpeg_encoder]"
+
+/// Baseline start of frame marker.
+static const std::array<uint8_t, 2> SOF0 = {0xFF, 0xC0};
+
+SCENARIO("Encoding images as JPEG", TEST_TAG) {
+    GIVEN("a 19x11 RGB gradient, not a multiple of the block size") {
+        const size_t width = 19;
+        const size_t height = 11;
+        std::vector<uint8_t> rgb;
+        for (size_t y = 0; y < height; ++y) {
+            for (size_t x = 0; x < width; ++x) {
+                rgb.push_back(static_cast<uint8_t>(x * 13));
+                rgb.push_back(static_cast<uint8_t>(y * 23));
+                rgb.push_back(128);
+            }
+        }
+
+        THEN("encode_jpeg produces a complete JPEG stream") {
+            const auto jpeg = rerun::image::encode_jpeg(rgb.data(), width, height, 3);
+            REQUIRE(jpeg.is_ok());
+            REQUIRE(jpeg.value.size() > 4);
+            CHECK(jpeg.value[0] == 0xFF);
+            CHECK(jpeg.value[1] == 0xD8);
+            CHECK(jpeg.value[jpeg.value.size() - 2] == 0xFF);
+            CHECK(jpeg.value[jpeg.value.size() - 1] == 0xD9);
+        }
+        THEN("lower quality produces smaller output") {
+            const auto high = rerun::image::encode_jpeg(rgb.data(), width, height, 3, 95);
+            const auto low = rerun::image::encode_jpeg(rgb.data(), width, height, 3, 10);
+            REQUIRE(high.is_ok());
+            REQUIRE(low.is_ok());
+            CHECK(low.value.size() < high.value.size());
+        }
+        THEN("jpeg_image creates a JPEG tensor with an RGB shape") {
+            const auto image = rerun::image::jpeg_image(rgb.data(), width, height, 3);
+            const auto& tensor = image.data.data;
+            CHECK(tensor.shape.size() == 3);
+            CHECK(tensor.shape[0].size == height);
+            CHECK(tensor.shape[1].size == width);
+            CHECK(tensor.shape[2].size == 3);
+            CHECK(tensor.buffer.get_union_tag() == rerun::datatypes::detail::TensorBufferTag::JPEG);
+        }
+        THEN("Image::encode_jpeg replaces the pixels with their encoding") {
+            const auto image =
+                rerun::archetypes::Image({height, width, 3}, rgb.data()).encode_jpeg();
+            const auto& tensor = image.data.data;
+            CHECK(tensor.shape.size() == 3);
+            CHECK(tensor.shape[0].size == height);
+            CHECK(tensor.shape[1].size == width);
+            CHECK(tensor.buffer.get_union_tag() == rerun::datatypes::detail::TensorBufferTag::JPEG);
+        }
+    }
+
+    GIVEN("a 10x9 grayscale gradient") {
+        const size_t width = 10;
+        const size_t height = 9;
+        std::vector<uint8_t> gray;
+        for (size_t y = 0; y < height; ++y) {
+            for (size_t x = 0; x < width; ++x) {
+                gray.push_back(static_cast<uint8_t>(x * 20 + y));
+            }
+        }
+
+        THEN("encode_jpeg writes a single component frame") {
+            const auto jpeg = rerun::image::encode_jpeg(gray.data(), width, height, 1);
+            REQUIRE(jpeg.is_ok());
+            const auto& bytes = jpeg.value;
+            const auto frame = std::search(bytes.begin(), bytes.end(), SOF0.begin(), SOF0.end());
+            REQUIRE(bytes.end() - frame > 10);
+            CHECK(frame[3] == 8 + 3);
+            CHECK(frame[9] == 1);
+            CHECK(bytes[bytes.size() - 2] == 0xFF);
+            CHECK(bytes[bytes.size() - 1] == 0xD9);
+        }
+        THEN("jpeg_image creates a JPEG tensor with a single channel") {
+            const auto image = rerun::image::jpeg_image(gray.data(), width, height, 1);
+            const auto& tensor = image.data.data;
+            REQUIRE(tensor.shape.size() == 3);
+            CHECK(tensor.shape[2].size == 1);
+        }
+    }
+
+    GIVEN("pixels with an unsupported number of channels") {
+        const std::vector<uint8_t> pixels(4 * 4 * 2);
+
+        THEN("encode_jpeg returns an error") {
+            const auto jpeg = rerun::image::encode_jpeg(pixels.data(), 4, 4, 2);
+            CHECK(jpeg.is_err());
+            CHECK(jpeg.error.code == rerun::ErrorCode::InvalidTensorDimension);
+        }
+    }
+
+    GIVEN("an image with 16-bit pixels") {
+        const std::vector<uint16_t> pixels(4 * 4);
+
+        THEN("Image::encode_jpeg leaves it unchanged") {
+            const auto image = rerun::archetypes::Image({4, 4}, pixels.data()).encode_jpeg();
+            const auto& tensor = image.data.data;
+            CHECK(tensor.buffer.get_union_tag() == rerun::datatypes::detail::TensorBufferTag::U16);
+        }
+    }
+}
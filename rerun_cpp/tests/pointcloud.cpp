@@ -0,0 +1,108 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <rerun/archetypes/points3d.hpp>
+#include <rerun/pointcloud.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#define TEST_TAG "[pointcloud]"
+
+SCENARIO("Voxel downsampling point clouds", TEST_TAG) {
+    GIVEN("points in two voxels, one of them with a negative coordinate") {
+        const std::vector<rerun::components::Position3D> positions = {
+            {0.1f, 0.1f, 0.1f},
+            {-0.5f, 0.5f, 0.5f},
+            {0.3f, 0.5f, 0.7f},
+            {-0.7f, 0.1f, 0.1f},
+        };
+        const std::vector<rerun::components::Color> colors = {
+            rerun::components::Color(0, 0, 0),
+            rerun::components::Color(10, 20, 30),
+            rerun::components::Color(100, 200, 250),
+            rerun::components::Color(20, 40, 60),
+        };
+
+        THEN("each voxel gets the centroid and the average color of its points") {
+            const auto downsampled = rerun::pointcloud::voxel_downsample(positions, colors, 1.0f);
+            REQUIRE(downsampled.is_ok());
+            const auto& points = downsampled.value.positions;
+            REQUIRE(points.size() == 2);
+            REQUIRE(downsampled.value.colors.size() == 2);
+
+            // Points are ordered by voxel.
+            CHECK(std::abs(points[0].x() + 0.6f) < 1e-6f);
+            CHECK(std::abs(points[0].y() - 0.3f) < 1e-6f);
+            CHECK(std::abs(points[1].x() - 0.2f) < 1e-6f);
+            CHECK(std::abs(points[1].z() - 0.4f) < 1e-6f);
+            CHECK(downsampled.value.colors[0].r() == 15);
+            CHECK(downsampled.value.colors[0].b() == 45);
+            CHECK(downsampled.value.colors[1].g() == 100);
+            CHECK(downsampled.value.colors[1].b() == 125);
+        }
+        THEN("small voxels keep all points") {
+            const auto downsampled = rerun::pointcloud::voxel_downsample(positions, 0.01f);
+            REQUIRE(downsampled.is_ok());
+            CHECK(downsampled.value.positions.size() == 4);
+            CHECK(downsampled.value.colors.empty());
+        }
+        THEN("Points3D::voxel_downsampled keeps the colors and a single radius") {
+            const auto points =
+                rerun::archetypes::Points3D(positions).with_colors(colors).with_radii({0.1f});
+            const auto downsampled = points.voxel_downsampled(1.0f);
+            CHECK(downsampled.positions.size() == 2);
+            REQUIRE(downsampled.colors.has_value());
+            CHECK(downsampled.colors->size() == 2);
+            REQUIRE(downsampled.radii.has_value());
+            CHECK(downsampled.radii->size() == 1);
+        }
+        THEN("a non-positive voxel size fails") {
+            CHECK(rerun::pointcloud::voxel_downsample(positions, 0.0f).is_err());
+        }
+        THEN("a mismatching number of colors fails") {
+            const std::vector<rerun::components::Color> two_colors(2);
+            CHECK(rerun::pointcloud::voxel_downsample(positions, two_colors, 1.0f).is_err());
+        }
+    }
+
+    GIVEN("points spread over more than 65536 voxels per axis and a NaN point") {
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const std::vector<rerun::components::Position3D> positions = {
+            {100000.0f, 1.0f, 0.0f},
+            {nan, 0.0f, 0.0f},
+            {0.0f, 1.0f, 0.0f},
+            {100000.0f, 0.0f, 0.0f},
+        };
+
+        THEN("points are sorted by voxel and the NaN point is dropped") {
+            const auto downsampled = rerun::pointcloud::voxel_downsample(positions, 1.0f);
+            REQUIRE(downsampled.is_ok());
+            const auto& points = downsampled.value.positions;
+            REQUIRE(points.size() == 3);
+            CHECK(points[0].x() == 100000.0f);
+            CHECK(points[0].y() == 0.0f);
+            CHECK(points[1].x() == 0.0f);
+            CHECK(points[2].x() == 100000.0f);
+            CHECK(points[2].y() == 1.0f);
+        }
+    }
+
+    GIVEN("points in two voxels and a point at negative infinity") {
+        const float inf = std::numeric_limits<float>::infinity();
+        const std::vector<rerun::components::Position3D> positions = {
+            {0.5f, 0.5f, 0.5f},
+            {-inf, 0.0f, 0.0f},
+            {2.5f, 0.5f, 0.5f},
+        };
+
+        THEN("the infinite point is dropped without merging the other voxels") {
+            const auto downsampled = rerun::pointcloud::voxel_downsample(positions, 1.0f);
+            REQUIRE(downsampled.is_ok());
+            const auto& points = downsampled.value.positions;
+            REQUIRE(points.size() == 2);
+            CHECK(points[0].x() == 0.5f);
+            CHECK(points[1].x() == 2.5f);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <rerun/archetypes/line_strips2d.hpp>
+#include <rerun/archetypes/line_strips3d.hpp>
+#include <rerun/polyline_simplification.hpp>
+
+#include <vector>
+
+#define TEST_TAG "[polyline_simplification]"
+
+using rerun::polyline::SimplificationMethod;
+
+SCENARIO("Simplifying single line strips", TEST_TAG) {
+    GIVEN("a nearly straight 2D line strip with one corner") {
+        const std::vector<rerun::datatypes::Vec2D> points = {
+            {0.0f, 0.0f},
+            {1.0f, 0.01f},
+            {2.0f, -0.01f},
+            {3.0f, 0.0f},
+            {3.0f, 1.0f},
+            {3.01f, 2.0f},
+            {3.0f, 3.0f},
+        };
+        std::vector<rerun::datatypes::Vec2D> simplified(points.size());
+
+        THEN("Ramer-Douglas-Peucker keeps the end points and the corner") {
+            const size_t num_kept = rerun::polyline::simplify(
+                points.data(),
+                points.size(),
+                0.1f,
+                SimplificationMethod::RamerDouglasPeucker,
+                simplified.data()
+            );
+            REQUIRE(num_kept == 3);
+            CHECK(simplified[0].x() == 0.0f);
+            CHECK(simplified[1].x() == 3.0f);
+            CHECK(simplified[1].y() == 0.0f);
+            CHECK(simplified[2].y() == 3.0f);
+        }
+        THEN("Visvalingam keeps the end points and the corner") {
+            const size_t num_kept = rerun::polyline::simplify(
+                points.data(),
+                points.size(),
+                0.5f,
+                SimplificationMethod::Visvalingam,
+                simplified.data()
+            );
+            REQUIRE(num_kept == 3);
+            CHECK(simplified[1].x() == 3.0f);
+            CHECK(simplified[1].y() == 0.0f);
+        }
+        THEN("a tolerance below the deviations keeps all points") {
+            const size_t num_kept = rerun::polyline::simplify(
+                points.data(),
+                points.size(),
+                0.001f,
+                SimplificationMethod::RamerDouglasPeucker,
+                simplified.data()
+            );
+            CHECK(num_kept == points.size());
+        }
+    }
+
+    GIVEN("a 3D line strip with two points") {
+        const std::vector<rerun::datatypes::Vec3D> points = {
+            {0.0f, 0.0f, 0.0f},
+            {1.0f, 1.0f, 1.0f},
+        };
+        std::vector<rerun::datatypes::Vec3D> simplified(points.size());
+
+        THEN("both points are kept") {
+            CHECK(
+                rerun::polyline::simplify(
+                    points.data(),
+                    points.size(),
+                    10.0f,
+                    SimplificationMethod::Visvalingam,
+                    simplified.data()
+                ) == 2
+            );
+        }
+    }
+}
+
+SCENARIO("Simplifying line strip archetypes", TEST_TAG) {
+    GIVEN("two collinear 3D line strips with colors") {
+        const rerun::Collection<rerun::datatypes::Vec3D> strip1 = {
+            {0.0f, 0.0f, 0.0f},
+            {1.0f, 1.0f, 1.0f},
+            {2.0f, 2.0f, 2.0f},
+        };
+        const rerun::Collection<rerun::datatypes::Vec3D> strip2 = {
+            {0.0f, 0.0f, 1.0f},
+            {0.0f, 0.0f, 2.0f},
+            {0.0f, 0.0f, 3.0f},
+            {0.0f, 0.0f, 4.0f},
+        };
+
+        THEN("only the end points of each strip remain and colors are kept") {
+            const std::vector<rerun::components::Color> colors = {
+                rerun::components::Color(255, 0, 0),
+                rerun::components::Color(0, 255, 0),
+            };
+            const auto strips = rerun::archetypes::LineStrips3D({strip1, strip2})
+                                    .with_colors(colors)
+                                    .simplify(0.01f);
+            REQUIRE(strips.strips.size() == 2);
+            CHECK(strips.strips[0].points.size() == 2);
+            REQUIRE(strips.strips[1].points.size() == 2);
+            CHECK(strips.strips[1].points[1].z() == 4.0f);
+            REQUIRE(strips.colors.has_value());
+            CHECK(strips.colors->size() == 2);
+        }
+    }
+
+    GIVEN("an empty batch of 2D line strips") {
+        THEN("simplifying gives an empty batch") {
+            const rerun::Collection<rerun::components::LineStrip2D> no_strips;
+            const auto strips = rerun::archetypes::LineStrips2D(no_strips).simplify(
+                1.0f,
+                SimplificationMethod::Visvalingam
+            );
+            CHECK(strips.strips.empty());
+        }
+    }
+}
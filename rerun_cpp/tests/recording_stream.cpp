@@ -1,4 +1,6 @@
 #include <array>
+#include <cmath>
+#include <cstring>
 #include <filesystem>
 #include <optional>
 #include <vector>
@@ -281,6 +283,56 @@ SCENARIO("RecordingStream can be used for logging archetypes and components", TE
     }
 }
 
+SCENARIO("RecordingStream can log pre-serialized component batches", TEST_TAG) {
+    GIVEN("a new RecordingStream and a serialized archetype") {
+        rerun::RecordingStream stream("test");
+        auto points = rerun::SerializedComponentBatch::serialize(
+            rerun::Points2D({rerun::Vec2D{1.0, 2.0}, rerun::Vec2D{4.0, 5.0}})
+                .with_colors(rerun::Color(0xFF0000FF))
+        );
+        REQUIRE(points.is_ok());
+
+        THEN("it can be logged repeatedly to different entities and alongside other data") {
+            check_logged_error([&] {
+                for (int i = 0; i < 3; ++i) {
+                    stream.log("points" + std::to_string(i), points.value);
+                    stream.log_timeless("points", points.value, std::array{rerun::Text("label")});
+                }
+            });
+        }
+        THEN("its arrays are shared rather than copied when logging") {
+            using Batches = std::vector<rerun::SerializedComponentBatch>;
+            const auto serialized = rerun::AsComponents<Batches>().serialize(points.value);
+            REQUIRE(serialized.is_ok());
+            REQUIRE(serialized.value.size() == points.value.size());
+            for (size_t i = 0; i < points.value.size(); ++i) {
+                CHECK(serialized.value[i].array == points.value[i].data_cell().array);
+            }
+        }
+    }
+    GIVEN("a single serialized component batch") {
+        rerun::RecordingStream stream("test");
+        auto colors = rerun::SerializedComponentBatch::from_loggable<rerun::Color>(
+            std::vector{rerun::Color(0xFF0000FF), rerun::Color(0x00FF00FF)}
+        );
+        REQUIRE(colors.is_ok());
+        CHECK(colors.value.num_instances() == 2);
+
+        THEN("it can be logged together with regular components") {
+            check_logged_error([&] {
+                stream.log(
+                    "points",
+                    colors.value,
+                    std::vector{
+                        rerun::Position2D(rerun::Vec2D{0.0, 0.0}),
+                        rerun::Position2D(rerun::Vec2D{1.0, 3.0}),
+                    }
+                );
+            });
+        }
+    }
+}
+
 SCENARIO("RecordingStream can log to file", TEST_TAG) {
     const char* test_path = "build/test_output";
     fs::create_directories(test_path);
@@ -426,6 +478,192 @@ void test_logging_to_connection(const char* address, const rerun::RecordingStrea
     }
 }
 
+SCENARIO("RecordingStream can log to memory", TEST_TAG) {
+    GIVEN("a new RecordingStream") {
+        rerun::RecordingStream stream("test");
+
+        THEN("draining without a memory sink fails") {
+            CHECK(stream.drain().error.code == rerun::ErrorCode::RecordingStreamMemoryFailure);
+        }
+
+        AND_GIVEN("a memory sink") {
+            REQUIRE(stream.memory().is_ok());
+
+            WHEN("logging a few points and draining") {
+                check_logged_error([&] {
+                    stream.log("points", rerun::Points3D({{1.0f, 2.0f, 3.0f}}));
+                });
+                auto first = stream.drain();
+
+                THEN("an .rrd file with the points is returned") {
+                    REQUIRE(first.is_ok());
+                    REQUIRE(first.value.size() > 4);
+                    CHECK(std::memcmp(first.value.data(), "RRF2", 4) == 0);
+
+                    AND_THEN("draining more points returns only those") {
+                        std::vector<rerun::Position3D> positions;
+                        for (int i = 0; i < 1000; ++i) {
+                            const float x = std::sin(static_cast<float>(i));
+                            positions.emplace_back(x, 2.0f * x, 3.0f * x);
+                        }
+                        check_logged_error([&] {
+                            stream.log("points", rerun::Points3D(positions));
+                        });
+                        auto second = stream.drain();
+                        REQUIRE(second.is_ok());
+                        CHECK(second.value.size() > first.value.size());
+
+                        AND_THEN("draining again returns an empty .rrd file") {
+                            auto third = stream.drain();
+                            REQUIRE(third.is_ok());
+                            CHECK(third.value.size() < first.value.size());
+                        }
+                    }
+                }
+            }
+            WHEN("replacing the memory sink with another sink") {
+                REQUIRE(stream.set_sink([](rerun::SinkChunk) {}).is_ok());
+
+                THEN("draining fails") {
+                    CHECK(
+                        stream.drain().error.code ==
+                        rerun::ErrorCode::RecordingStreamMemoryFailure
+                    );
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("RecordingStream can skip re-logging unchanged data", TEST_TAG) {
+    const char* test_path = "build/test_output";
+    fs::create_directories(test_path);
+
+    std::string test_rrd_all = std::string(test_path) + "test-change-detection-all.rrd";
+    std::string test_rrd_changed = std::string(test_path) + "test-change-detection-changed.rrd";
+
+    GIVEN("a stream with and a stream without change detection saving to files") {
+        auto stream_all = std::make_unique<rerun::RecordingStream>("test");
+        auto stream_changed = std::make_unique<rerun::RecordingStream>("test");
+        REQUIRE(stream_all->save(test_rrd_all).is_ok());
+        REQUIRE(stream_changed->save(test_rrd_changed).is_ok());
+        check_logged_error([&] { stream_changed->enable_change_detection("world/**"); });
+
+        WHEN("logging the same data repeatedly to both") {
+            const auto points = rerun::Points2D({rerun::Vec2D{1.0, 2.0}, rerun::Vec2D{4.0, 5.0}})
+                                    .with_colors(rerun::Color(0xFF0000FF));
+            check_logged_error([&] {
+                for (int64_t frame = 0; frame < 20; ++frame) {
+                    stream_all->set_time_sequence("frame", frame);
+                    stream_changed->set_time_sequence("frame", frame);
+                    stream_all->log("world/points", points);
+                    stream_changed->log("world/points", points);
+                }
+            });
+
+            THEN("after destruction, the stream with change detection produced a smaller file") {
+                stream_all.reset();
+                stream_changed.reset();
+                CHECK(fs::file_size(test_rrd_changed) < fs::file_size(test_rrd_all));
+            }
+        }
+    }
+    GIVEN("a stream with change detection passing its tables to a callback") {
+        // Declared first, so the callback never outlives it.
+        int64_t num_rows = 0;
+        rerun::RecordingStream stream("test");
+        check_logged_error([&] { stream.enable_change_detection("world/**"); });
+        rerun::SinkOptions options;
+        options.format = rerun::SinkFormat::Arrow;
+        const auto status = stream.set_sink(
+            [&](rerun::SinkChunk chunk) { num_rows += chunk.record_batch()->num_rows(); },
+            options
+        );
+        REQUIRE(status.is_ok());
+
+        const auto points = rerun::Points3D({{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}});
+        check_logged_error([&] {
+            stream.log("world/a", points);
+            stream.log("world/b", points);
+        });
+        stream.flush_blocking();
+        num_rows = 0;
+
+        WHEN("clearing one entity and logging the same data to another") {
+            check_logged_error([&] {
+                stream.log("world/a", rerun::Clear::FLAT);
+                stream.log("world/b", points);
+            });
+            stream.flush_blocking();
+
+            THEN("only the clear is logged") {
+                CHECK(num_rows == 1);
+            }
+        }
+        WHEN("clearing the parent recursively and logging the same data to a child") {
+            check_logged_error([&] {
+                stream.log("world", rerun::Clear::RECURSIVE);
+                stream.log("world/b", points);
+            });
+            stream.flush_blocking();
+
+            THEN("the data is logged again") {
+                CHECK(num_rows > 1);
+            }
+        }
+        WHEN("changing other policies and logging the same data again") {
+            stream.set_rate_limit("other/**", 10.0);
+            check_logged_error([&] {
+                stream.enable_change_detection("other/**");
+                stream.log("world/b", points);
+            });
+            stream.flush_blocking();
+
+            THEN("nothing is logged") {
+                CHECK(num_rows == 0);
+            }
+        }
+        WHEN("logging the same values from a slice of a larger array") {
+            const std::vector<rerun::components::Position3D> positions = {
+                {0.0f, 0.0f, 0.0f},
+                {1.0f, 2.0f, 3.0f},
+                {4.0f, 5.0f, 6.0f},
+            };
+            using PositionLoggable = rerun::Loggable<rerun::components::Position3D>;
+            auto full_array = PositionLoggable::to_arrow(positions.data(), positions.size());
+            auto tail_array = PositionLoggable::to_arrow(positions.data() + 1, 2);
+            REQUIRE(full_array.is_ok());
+            REQUIRE(tail_array.is_ok());
+
+            rerun::DataCell cell =
+                rerun::DataCell::from_loggable(rerun::components::Position3D()).value;
+            cell.num_instances = 2;
+            cell.array = tail_array.value;
+            REQUIRE(stream.try_log_serialized_batches("world/c", false, {cell}).is_ok());
+            stream.flush_blocking();
+            num_rows = 0;
+
+            cell.array = full_array.value->Slice(1, 2);
+            REQUIRE(stream.try_log_serialized_batches("world/c", false, {cell}).is_ok());
+            stream.flush_blocking();
+
+            THEN("they are detected as unchanged") {
+                CHECK(num_rows == 0);
+            }
+        }
+    }
+    GIVEN("a new RecordingStream") {
+        rerun::RecordingStream stream("test");
+
+        THEN("enabling change detection with a malformed pattern fails") {
+            CHECK(
+                stream.try_enable_change_detection("world/**/points").code ==
+                rerun::ErrorCode::InvalidEntityPathFilter
+            );
+        }
+    }
+}
+
 SCENARIO("RecordingStream can connect", TEST_TAG) {
     const char* address = "127.0.0.1:9876";
     GIVEN("a new RecordingStream") {
@@ -537,6 +775,391 @@ SCENARIO("Recording stream handles serialization failure during logging graceful
     }
 }
 
+SCENARIO("RecordingStream only constructs lazily logged data if enabled", TEST_TAG) {
+    GIVEN("a disabled RecordingStream") {
+        rerun::set_default_enabled(false);
+        rerun::RecordingStream stream("test");
+        rerun::set_default_enabled(true);
+        REQUIRE(!stream.is_enabled());
+
+        THEN("log_lazy doesn't invoke the callable") {
+            bool invoked = false;
+            stream.log_lazy("lazy", [&] {
+                invoked = true;
+                return rerun::Points2D({rerun::Vec2D{1.0, 2.0}});
+            });
+            CHECK(!invoked);
+        }
+        THEN("RERUN_LOG doesn't evaluate its arguments") {
+            bool evaluated = false;
+            auto make_points = [&] {
+                evaluated = true;
+                return rerun::Points2D({rerun::Vec2D{1.0, 2.0}});
+            };
+            RERUN_LOG(stream, "lazy", make_points());
+            RERUN_LOG_TIMELESS(stream, "lazy", make_points());
+            CHECK(!evaluated);
+        }
+    }
+    GIVEN("an enabled RecordingStream") {
+        rerun::RecordingStream stream("test");
+
+        THEN("log_lazy and log_timeless_lazy invoke the callable") {
+            int num_invocations = 0;
+            auto make_points = [&] {
+                ++num_invocations;
+                return rerun::Points2D({rerun::Vec2D{1.0, 2.0}});
+            };
+            check_logged_error([&] {
+                stream.log_lazy("lazy", make_points);
+                stream.log_timeless_lazy("lazy", make_points);
+            });
+            CHECK(num_invocations == 2);
+        }
+        THEN("RERUN_LOG evaluates its arguments") {
+            int num_evaluations = 0;
+            auto make_points = [&] {
+                ++num_evaluations;
+                return rerun::Points2D({rerun::Vec2D{1.0, 2.0}});
+            };
+            check_logged_error([&] {
+                RERUN_LOG(stream, "lazy", make_points());
+                RERUN_LOG_TIMELESS(stream, "lazy", make_points(), std::array{rerun::Text("hi")});
+            });
+            CHECK(num_evaluations == 2);
+        }
+    }
+}
+
+SCENARIO("RecordingStream skips entity paths excluded by its filter", TEST_TAG) {
+    GIVEN("a new RecordingStream with an entity path filter") {
+        rerun::RecordingStream stream("test");
+        stream.set_entity_path_filter("-world/debug/**");
+
+        THEN("excluded entity paths are reported as disabled") {
+            CHECK(stream.is_enabled("world/points"));
+            CHECK_FALSE(stream.is_enabled("world/debug/points"));
+        }
+        THEN("data for excluded entity paths is not constructed") {
+            bool invoked = false;
+            stream.log_lazy("world/debug/points", [&] {
+                invoked = true;
+                return rerun::Points2D({rerun::Vec2D{1.0, 2.0}});
+            });
+            CHECK_FALSE(invoked);
+        }
+        THEN("data for excluded entity paths is not serialized") {
+            auto& expected_error = rerun::Loggable<BadComponent>::error;
+            expected_error.code = rerun::ErrorCode::Unknown;
+            CHECK(stream.try_log("world/debug/bad", std::array{BadComponent()}).is_ok());
+            CHECK(stream.try_log("world/bad", std::array{BadComponent()}) == expected_error);
+        }
+        THEN("setting malformed rules fails and keeps the previous filter") {
+            CHECK(
+                stream.try_set_entity_path_filter("world/**/debug").code ==
+                rerun::ErrorCode::InvalidEntityPathFilter
+            );
+            CHECK_FALSE(stream.is_enabled("world/debug/points"));
+        }
+        THEN("resetting the filter enables all entity paths again") {
+            stream.set_entity_path_filter(rerun::EntityPathFilter());
+            CHECK(stream.is_enabled("world/debug/points"));
+        }
+    }
+}
+
+SCENARIO("RecordingStream drops log calls exceeding a rate limit", TEST_TAG) {
+    GIVEN("a new RecordingStream with a rate limit far below the logging rate") {
+        rerun::RecordingStream stream("test");
+        const auto mode =
+            GENERATE(rerun::RateLimitMode::KeepFirst, rerun::RateLimitMode::KeepLatest);
+        stream.set_rate_limit("sensors/**", 0.001, mode);
+
+        WHEN("logging repeatedly to a rate limited entity") {
+            int num_invocations = 0;
+            for (int i = 0; i < 10; ++i) {
+                stream.log_lazy("sensors/imu", [&] {
+                    ++num_invocations;
+                    return rerun::Points2D({rerun::Vec2D{1.0, 2.0}});
+                });
+            }
+
+            THEN("only the first call is carried out") {
+                CHECK(num_invocations == 1);
+            }
+            THEN("the suppressed calls are counted") {
+                const auto stats = stream.rate_limit_stats();
+                REQUIRE(stats.size() == 1);
+                CHECK(stats[0].entity_path_pattern == "sensors/**");
+                CHECK(stats[0].num_logged == 1);
+                CHECK(stats[0].num_suppressed == 9);
+            }
+        }
+        WHEN("changing other policies between log calls to a rate limited entity") {
+            int num_invocations = 0;
+            for (int i = 0; i < 10; ++i) {
+                stream.log_lazy("sensors/imu", [&] {
+                    ++num_invocations;
+                    return rerun::Points2D({rerun::Vec2D{1.0, 2.0}});
+                });
+                check_logged_error([&] { stream.enable_change_detection("world/**"); });
+            }
+
+            THEN("the rate limit still applies") {
+                CHECK(num_invocations == 1);
+            }
+        }
+        WHEN("logging repeatedly with a rate limit of a fraction of a log call per century") {
+            stream.set_rate_limit("sensors/**", 1.0e-12, mode);
+            int num_invocations = 0;
+            for (int i = 0; i < 10; ++i) {
+                stream.log_lazy("sensors/imu", [&] {
+                    ++num_invocations;
+                    return rerun::Points2D({rerun::Vec2D{1.0, 2.0}});
+                });
+            }
+
+            THEN("only the first call is carried out") {
+                CHECK(num_invocations == 1);
+            }
+        }
+        WHEN("logging repeatedly to an entity without a rate limit") {
+            int num_evaluations = 0;
+            auto make_points = [&] {
+                ++num_evaluations;
+                return rerun::Points2D({rerun::Vec2D{1.0, 2.0}});
+            };
+            for (int i = 0; i < 10; ++i) {
+                RERUN_LOG(stream, "camera", make_points());
+            }
+
+            THEN("all calls are carried out") {
+                CHECK(num_evaluations == 10);
+            }
+        }
+        WHEN("clearing the rate limits") {
+            stream.clear_rate_limits();
+
+            THEN("there are no more rate limit stats") {
+                CHECK(stream.rate_limit_stats().empty());
+            }
+        }
+        THEN("setting an invalid rate limit fails") {
+            CHECK(
+                stream.try_set_rate_limit("sensors/**", 0.0).code ==
+                rerun::ErrorCode::InvalidRateLimit
+            );
+            CHECK(
+                stream.try_set_rate_limit("sensors/**/imu", 20.0).code ==
+                rerun::ErrorCode::InvalidEntityPathFilter
+            );
+        }
+    }
+}
+
+SCENARIO("RecordingStream logs downscaled previews of images", TEST_TAG) {
+    GIVEN("a new RecordingStream with previews for cameras") {
+        rerun::RecordingStream stream("test");
+        stream.enable_previews("cameras/**", 2);
+        // The rate limit stats count the log calls to preview entities.
+        stream.set_rate_limit("preview/**", 0.001);
+
+        const std::vector<uint8_t> pixels(4 * 4 * 3, 128);
+        const std::vector<uint16_t> depth(4 * 4, 1000);
+
+        WHEN("logging images to cameras and other entities") {
+            check_logged_error([&] {
+                for (int i = 0; i < 3; ++i) {
+                    stream.log("cameras/front", rerun::Image({4, 4, 3}, pixels.data()));
+                    stream.log("cameras/depth", rerun::DepthImage({4, 4}, depth.data()));
+                    stream.log("cameras/points", rerun::Points2D({rerun::Vec2D{1.0, 2.0}}));
+                    stream.log("world/image", rerun::Image({4, 4, 3}, pixels.data()));
+                }
+            });
+
+            THEN("only the images logged to cameras have previews") {
+                const auto stats = stream.rate_limit_stats();
+                REQUIRE(stats.size() == 1);
+                CHECK(stats[0].num_logged + stats[0].num_suppressed == 6);
+            }
+        }
+        WHEN("logging JPEG and NV12 images to cameras") {
+            check_logged_error([&] {
+                stream.log("cameras/front", rerun::Image({4, 4, 3}, pixels.data()).encode_jpeg());
+                stream.log("cameras/front", rerun::image::nv12_image(pixels.data(), 4, 4));
+            });
+
+            THEN("they are logged without previews") {
+                const auto stats = stream.rate_limit_stats();
+                REQUIRE(stats.size() == 1);
+                CHECK(stats[0].num_logged + stats[0].num_suppressed == 0);
+            }
+        }
+        WHEN("logging the same image twice with change detection") {
+            stream.enable_change_detection("cameras/**");
+            check_logged_error([&] {
+                stream.log("cameras/front", rerun::Image({4, 4, 3}, pixels.data()));
+                stream.log("cameras/front", rerun::Image({4, 4, 3}, pixels.data()));
+            });
+
+            THEN("only the first one has a preview") {
+                const auto stats = stream.rate_limit_stats();
+                REQUIRE(stats.size() == 1);
+                CHECK(stats[0].num_logged + stats[0].num_suppressed == 1);
+            }
+        }
+        WHEN("logging depth images with previews of the closest depth") {
+            stream.enable_previews("cameras/**", 2, rerun::image::DepthDownscaleMode::Min);
+            check_logged_error([&] {
+                stream.log("cameras/depth", rerun::DepthImage({4, 4}, depth.data()));
+            });
+
+            THEN("they have previews") {
+                const auto stats = stream.rate_limit_stats();
+                REQUIRE(stats.size() == 1);
+                CHECK(stats[0].num_logged + stats[0].num_suppressed == 1);
+            }
+        }
+        WHEN("disabling previews") {
+            stream.disable_previews();
+            check_logged_error([&] {
+                stream.log("cameras/front", rerun::Image({4, 4, 3}, pixels.data()));
+            });
+
+            THEN("no previews are logged") {
+                const auto stats = stream.rate_limit_stats();
+                REQUIRE(stats.size() == 1);
+                CHECK(stats[0].num_logged + stats[0].num_suppressed == 0);
+            }
+        }
+        THEN("enabling previews without downscaling fails") {
+            CHECK(
+                stream.try_enable_previews("cameras/**", 1).code ==
+                rerun::ErrorCode::InvalidTensorDimension
+            );
+        }
+    }
+}
+
+SCENARIO("RecordingStream logs voxel downsampled previews of point clouds", TEST_TAG) {
+    GIVEN("a new RecordingStream with point cloud previews for lidars") {
+        rerun::RecordingStream stream("test");
+        stream.enable_point_cloud_previews("lidar/**", 0.5f);
+        // The rate limit stats count the log calls to preview entities.
+        stream.set_rate_limit("preview/**", 0.001);
+
+        const std::vector<rerun::Position3D> positions = {{0.0f, 0.0f, 0.0f}, {0.1f, 0.1f, 0.1f}};
+
+        WHEN("logging point clouds to lidars and other entities") {
+            check_logged_error([&] {
+                stream.log("lidar/top", rerun::Points3D(positions));
+                stream.log("world/points", rerun::Points3D(positions));
+            });
+
+            THEN("only the point clouds logged to lidars have previews") {
+                const auto stats = stream.rate_limit_stats();
+                REQUIRE(stats.size() == 1);
+                CHECK(stats[0].num_logged + stats[0].num_suppressed == 1);
+            }
+        }
+        THEN("enabling previews without a positive voxel size fails") {
+            CHECK(
+                stream.try_enable_point_cloud_previews("lidar/**", 0.0f).code ==
+                rerun::ErrorCode::InvalidPointCloud
+            );
+        }
+    }
+}
+
+SCENARIO("RecordingStream logs min/max previews of scalars", TEST_TAG) {
+    GIVEN("a new RecordingStream with scalar previews for sensors") {
+        rerun::RecordingStream stream("test");
+        stream.enable_scalar_previews("sensors/**", 10);
+        // The rate limit stats count the log calls to preview entities.
+        stream.set_rate_limit("preview/**", 0.001);
+
+        WHEN("logging scalars to sensors and other entities") {
+            check_logged_error([&] {
+                for (int i = 0; i < 25; ++i) {
+                    stream.log("sensors/current", rerun::Scalar(static_cast<double>(i)));
+                    stream.log("world/scalar", rerun::Scalar(static_cast<double>(i)));
+                }
+            });
+
+            THEN("each complete window of the sensor has a min and a max preview") {
+                const auto stats = stream.rate_limit_stats();
+                REQUIRE(stats.size() == 1);
+                CHECK(stats[0].num_logged + stats[0].num_suppressed == 4);
+            }
+        }
+        WHEN("changing other policies within a window") {
+            check_logged_error([&] {
+                for (int i = 0; i < 10; ++i) {
+                    stream.log("sensors/current", rerun::Scalar(static_cast<double>(i)));
+                    stream.enable_change_detection("world/**");
+                }
+            });
+
+            THEN("the window is completed") {
+                const auto stats = stream.rate_limit_stats();
+                REQUIRE(stats.size() == 1);
+                CHECK(stats[0].num_logged + stats[0].num_suppressed == 2);
+            }
+        }
+        WHEN("logging scalars to sensors with a series channel") {
+            check_logged_error([&] {
+                rerun::SeriesChannel channel(
+                    stream,
+                    "sensors/current",
+                    "sensor_time",
+                    rerun::TimeType::Sequence,
+                    4096,
+                    std::chrono::hours(1)
+                );
+                for (int64_t i = 0; i < 25; ++i) {
+                    channel.add(i, static_cast<double>(i));
+                }
+            });
+
+            THEN("the batch has a min and a max preview") {
+                const auto stats = stream.rate_limit_stats();
+                REQUIRE(stats.size() == 1);
+                CHECK(stats[0].num_logged + stats[0].num_suppressed == 2);
+            }
+        }
+        THEN("enabling previews with a window of a single scalar fails") {
+            CHECK(
+                stream.try_enable_scalar_previews("sensors/**", 1).code ==
+                rerun::ErrorCode::InvalidDownsamplingWindow
+            );
+        }
+    }
+}
+
+SCENARIO("RecordingStream can be warmed up before logging", TEST_TAG) {
+    GIVEN("a new RecordingStream") {
+        rerun::RecordingStream stream("test");
+
+        THEN("archetypes and component collections can be warmed up") {
+            check_logged_error([&] {
+                stream.warmup<rerun::Points2D, rerun::Collection<rerun::Color>>();
+            });
+            CHECK(stream.try_warmup<rerun::Points2D, rerun::Collection<rerun::Text>>().is_ok());
+        }
+        THEN("representative data can be prepared") {
+            const auto points = rerun::Points2D({rerun::Vec2D{1.0, 2.0}, rerun::Vec2D{4.0, 5.0}})
+                                    .with_colors(rerun::Color(0xFF0000FF));
+            check_logged_error([&] { stream.prepare(points); });
+            CHECK(stream.try_prepare(points, std::array{rerun::Text("hello")}).is_ok());
+        }
+        THEN("preparing data that fails serialization forwards the error") {
+            auto& expected_error = rerun::Loggable<BadComponent>::error;
+            expected_error.code = rerun::ErrorCode::Unknown;
+            CHECK(stream.try_prepare(std::array{BadComponent()}) == expected_error);
+        }
+    }
+}
+
 SCENARIO("RecordingStream can set time without errors", TEST_TAG) {
     rerun::RecordingStream stream("test");
 
@@ -567,3 +1190,46 @@ SCENARIO("RecordingStream can set time without errors", TEST_TAG) {
         check_logged_error([&] { stream.disable_timeline("exists"); });
     }
 }
+
+SCENARIO("RecordingStream logs temporal batches", TEST_TAG) {
+    GIVEN("a new RecordingStream") {
+        rerun::RecordingStream stream("test");
+        // The rate limit stats count the log calls.
+        stream.set_rate_limit("sensors/**", 0.001);
+
+        const std::vector<int64_t> frames = {1, 2, 3};
+        const auto time_column = rerun::TimeColumn::from_sequence_points("frame", frames);
+
+        THEN("batches with one instance per time point or a single one can be logged") {
+            const std::vector<rerun::components::Scalar> values = {1.0, 2.0, 3.0};
+            CHECK(stream
+                      .try_log_temporal_batch(
+                          "sensors/temperature",
+                          time_column,
+                          values,
+                          rerun::Scalar::IndicatorComponent()
+                      )
+                      .is_ok());
+
+            AND_THEN("the batch counts as a single log call") {
+                const auto stats = stream.rate_limit_stats();
+                REQUIRE(stats.size() == 1);
+                CHECK(stats[0].num_logged + stats[0].num_suppressed == 1);
+            }
+        }
+        THEN("batches with a different number of instances are rejected") {
+            const std::vector<rerun::components::Scalar> values = {1.0, 2.0};
+            CHECK(
+                stream.try_log_temporal_batch("sensors/temperature", time_column, values).code ==
+                rerun::ErrorCode::InvalidTemporalBatch
+            );
+        }
+        THEN("seconds are converted to nanoseconds") {
+            const std::vector<double> seconds = {0.5, 1.25};
+            const auto column = rerun::TimeColumn::from_seconds("time", seconds.data(), 2);
+            CHECK(column.time_type == rerun::TimeType::Time);
+            CHECK(column.times[0] == 500'000'000);
+            CHECK(column.times[1] == 1'250'000'000);
+        }
+    }
+}
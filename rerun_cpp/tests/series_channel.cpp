@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <rerun.hpp>
+
+#include <chrono>
+
+#include "error_check.hpp"
+
+#define TEST_TAG "[series_channel]"
+
+/// Number of log calls to the series since the last call.
+static size_t num_series_logs(const rerun::RecordingStream& stream, size_t& num_previous_logs) {
+    const auto stats = stream.rate_limit_stats();
+    REQUIRE(stats.size() == 1);
+    const size_t num_logs = stats[0].num_logged + stats[0].num_suppressed;
+    const size_t num_new_logs = num_logs - num_previous_logs;
+    num_previous_logs = num_logs;
+    return num_new_logs;
+}
+
+SCENARIO("SeriesChannel logs samples in batches", TEST_TAG) {
+    GIVEN("a channel with batches of 4 samples") {
+        rerun::RecordingStream stream("test");
+        // The rate limit stats count the log calls to the series.
+        stream.set_rate_limit("sensors/**", 0.001);
+        size_t num_logs = 0;
+
+        check_logged_error([&] {
+            rerun::SeriesChannel channel(
+                stream,
+                "sensors/current",
+                "frame",
+                rerun::TimeType::Sequence,
+                4,
+                std::chrono::hours(1)
+            );
+
+            WHEN("adding fewer samples than the batch size") {
+                for (int64_t frame = 0; frame < 3; ++frame) {
+                    channel.add(frame, 0.5 * static_cast<double>(frame));
+                }
+
+                THEN("they are buffered") {
+                    CHECK(channel.num_buffered() == 3);
+                    CHECK(num_series_logs(stream, num_logs) == 0);
+
+                    AND_THEN("flushing logs them at once") {
+                        channel.flush();
+                        CHECK(channel.num_buffered() == 0);
+                        CHECK(num_series_logs(stream, num_logs) == 1);
+                    }
+                }
+            }
+            WHEN("adding more samples than the batch size") {
+                for (int64_t frame = 0; frame < 10; ++frame) {
+                    channel.add(frame, 0.5 * static_cast<double>(frame));
+                }
+
+                THEN("full batches are logged") {
+                    CHECK(channel.num_buffered() == 2);
+                    CHECK(num_series_logs(stream, num_logs) == 2);
+                }
+            }
+        });
+    }
+
+    GIVEN("a channel without delay") {
+        rerun::RecordingStream stream("test");
+        stream.set_rate_limit("sensors/**", 0.001);
+        size_t num_logs = 0;
+
+        check_logged_error([&] {
+            rerun::SeriesChannel channel(
+                stream,
+                "sensors/current",
+                "sensor_time",
+                rerun::TimeType::Time,
+                4096,
+                std::chrono::nanoseconds(0)
+            );
+
+            THEN("each sample is logged right away") {
+                channel.add(std::chrono::duration<double>(1.5), 1.0);
+                channel.add(std::chrono::milliseconds(1600), 2.0);
+                CHECK(channel.num_buffered() == 0);
+                CHECK(num_series_logs(stream, num_logs) == 2);
+            }
+        });
+    }
+}
@@ -0,0 +1,81 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <rerun/series_downsampling.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#define TEST_TAG "[series_downsampling]"
+
+SCENARIO("Min/max downsampling of scalar series", TEST_TAG) {
+    GIVEN("a series with a spike and a NaN") {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        const std::vector<double> values = {1.0, 5.0, 2.0, 3.0, -1.0, nan, 9.0, 0.5, 0.5};
+
+        THEN("each bucket keeps its min and max in their original order") {
+            std::vector<size_t> indices(6);
+            const size_t num_kept =
+                rerun::series::min_max_indices(values.data(), values.size(), 4, indices.data());
+            CHECK(num_kept == 5);
+            indices.resize(num_kept);
+            CHECK(indices == std::vector<size_t>{0, 1, 4, 6, 8});
+        }
+        THEN("the streaming window gives the same values") {
+            rerun::series::MinMaxWindow window(4);
+            std::vector<double> kept;
+            for (const double value : values) {
+                if (const auto min_max = window.add(value)) {
+                    kept.push_back(min_max->first);
+                    kept.push_back(min_max->second);
+                }
+            }
+            CHECK(kept == std::vector<double>{1.0, 5.0, -1.0, 9.0});
+        }
+    }
+
+    GIVEN("a window of NaNs") {
+        rerun::series::MinMaxWindow window(2);
+        THEN("it has no min and max") {
+            CHECK_FALSE(window.add(std::numeric_limits<double>::quiet_NaN()).has_value());
+            CHECK_FALSE(window.add(std::numeric_limits<double>::quiet_NaN()).has_value());
+        }
+    }
+}
+
+SCENARIO("LTTB downsampling of scalar series", TEST_TAG) {
+    GIVEN("a flat series with two peaks") {
+        std::vector<double> times;
+        std::vector<double> values;
+        for (int i = 0; i < 100; ++i) {
+            times.push_back(static_cast<double>(i));
+            values.push_back(i == 30 ? 10.0 : (i == 70 ? -10.0 : 0.0));
+        }
+
+        THEN("the peaks and both ends are kept") {
+            std::vector<size_t> indices(4);
+            const size_t num_kept = rerun::series::lttb_indices(
+                times.data(),
+                values.data(),
+                values.size(),
+                4,
+                indices.data()
+            );
+            CHECK(num_kept == 4);
+            CHECK(indices == std::vector<size_t>{0, 30, 70, 99});
+        }
+        THEN("asking for more samples than there are keeps all") {
+            std::vector<size_t> indices(values.size());
+            CHECK(
+                rerun::series::lttb_indices(
+                    times.data(),
+                    values.data(),
+                    values.size(),
+                    1000,
+                    indices.data()
+                ) == values.size()
+            );
+            CHECK(indices[99] == 99);
+        }
+    }
+}
@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <rerun/archetypes/depth_image.hpp>
+#include <rerun/archetypes/tensor.hpp>
+#include <rerun/tensor_conversion.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#define TEST_TAG "[tensor_conversion]"
+
+SCENARIO("Converting floats to half floats", TEST_TAG) {
+    GIVEN("floats covering normal, denormal and special values") {
+        // More than 8 values to cover both the vectorized loop and its remainder.
+        const std::vector<float> floats = {
+            0.0f,
+            -0.0f,
+            1.0f,
+            -2.5f,
+            65504.0f,
+            1.0f + 1.0f / 2048.0f, // Halfway between two halves, rounds to even.
+            std::ldexp(1.0f, -24), // Smallest half denormal.
+            1.0e6f,
+            std::numeric_limits<float>::infinity(),
+            std::numeric_limits<float>::quiet_NaN(),
+        };
+        const std::vector<uint16_t> expected = {
+            0x0000,
+            0x8000,
+            0x3C00,
+            0xC100,
+            0x7BFF,
+            0x3C00,
+            0x0001,
+            0x7C00,
+            0x7C00,
+        };
+
+        THEN("f32_to_f16 produces the IEEE 754 half bit patterns") {
+            std::vector<rerun::half> halves(floats.size());
+            rerun::tensor::f32_to_f16(floats.data(), halves.data(), floats.size());
+
+            for (size_t i = 0; i < expected.size(); ++i) {
+                CHECK(halves[i].f16 == expected[i]);
+            }
+            CHECK((halves.back().f16 & 0x7C00) == 0x7C00);
+            CHECK((halves.back().f16 & 0x03FF) != 0);
+        }
+        THEN("f16_to_f32 converts exactly representable values back") {
+            std::vector<rerun::half> halves(floats.size());
+            rerun::tensor::f32_to_f16(floats.data(), halves.data(), floats.size());
+            std::vector<float> roundtrip(floats.size());
+            rerun::tensor::f16_to_f32(halves.data(), roundtrip.data(), halves.size());
+
+            for (size_t i = 0; i < 5; ++i) {
+                CHECK(roundtrip[i] == floats[i]);
+            }
+            CHECK(roundtrip[6] == floats[6]);
+            CHECK(std::isnan(roundtrip.back()));
+        }
+    }
+}
+
+SCENARIO("Quantizing depth in meters", TEST_TAG) {
+    GIVEN("depths including invalid and far away values") {
+        const std::vector<float> meters = {
+            0.0f,
+            -1.0f,
+            std::numeric_limits<float>::quiet_NaN(),
+            1.0f,
+            2.5f,
+            100.0f,
+        };
+
+        THEN("meters_to_u16 maps invalid depths to zero and saturates") {
+            std::vector<uint16_t> depth(meters.size());
+            rerun::tensor::meters_to_u16(meters.data(), depth.data(), meters.size(), 1000.0f);
+            CHECK(depth == std::vector<uint16_t>{0, 0, 0, 1000, 2500, 65535});
+        }
+        THEN("u16_depth_meter covers the farthest depth") {
+            const float meter = rerun::tensor::u16_depth_meter(meters.data(), meters.size());
+            CHECK(meter * 100.0f <= 65535.5f);
+            CHECK(meter * 100.0f >= 65534.5f);
+        }
+        THEN("DepthImage::from_meters creates a 16-bit depth image with a meter") {
+            const auto image =
+                rerun::archetypes::DepthImage::from_meters({2, 3}, meters.data(), 1000.0f);
+            const auto& tensor = image.data.data;
+            CHECK(tensor.shape.size() == 2);
+            CHECK(tensor.buffer.get_union_tag() == rerun::datatypes::detail::TensorBufferTag::U16);
+            CHECK(tensor.buffer.get_u16()->size() == meters.size());
+            REQUIRE(image.meter.has_value());
+            CHECK(image.meter.value().value == 1000.0f);
+        }
+    }
+}
+
+SCENARIO("Creating tensors with smaller element types", TEST_TAG) {
+    GIVEN("a 2x3 tensor of doubles") {
+        const std::vector<double> doubles = {1.0, 2.0, 3.0, 4.0, 5.0, 6.5};
+
+        THEN("from_f64_as_f32 creates a float tensor") {
+            const auto tensor = rerun::archetypes::Tensor::from_f64_as_f32({2, 3}, doubles.data());
+            const auto* floats = tensor.data.data.buffer.get_f32();
+            REQUIRE(floats != nullptr);
+            CHECK(floats->size() == 6);
+            CHECK((*floats)[5] == 6.5f);
+        }
+    }
+
+    GIVEN("a 2x3 tensor of floats") {
+        const std::vector<float> floats = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.5f};
+
+        THEN("from_f32_as_f16 creates a half float tensor") {
+            const auto tensor = rerun::archetypes::Tensor::from_f32_as_f16({2, 3}, floats.data());
+            const auto* halves = tensor.data.data.buffer.get_f16();
+            REQUIRE(halves != nullptr);
+            CHECK(halves->size() == 6);
+            CHECK((*halves)[0].f16 == 0x3C00);
+        }
+    }
+}
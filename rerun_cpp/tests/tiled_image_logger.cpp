@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <rerun.hpp>
+
+#include <vector>
+
+#define TEST_TAG "[tiled_image_logger]"
+
+/// Number of log calls to the tiles since the last call.
+static size_t num_tile_logs(const rerun::RecordingStream& stream, size_t& num_previous_logs) {
+    const auto stats = stream.rate_limit_stats();
+    REQUIRE(stats.size() == 1);
+    const size_t num_logs = stats[0].num_logged + stats[0].num_suppressed;
+    const size_t num_new_logs = num_logs - num_previous_logs;
+    num_previous_logs = num_logs;
+    return num_new_logs;
+}
+
+SCENARIO("TiledImageLogger logs only changed tiles", TEST_TAG) {
+    GIVEN("a 5x6 image with 4x4 tiles") {
+        rerun::RecordingStream stream("test");
+        // The rate limit stats count the log calls to the tiles.
+        stream.set_rate_limit("map/**", 0.001);
+        size_t num_logs = 0;
+
+        rerun::TiledImageLogger logger("map", 4);
+        std::vector<uint8_t> occupancy(5 * 6, 0);
+        const auto log = [&] {
+            return logger.try_log(stream, rerun::SegmentationImage({5, 6}, occupancy.data()));
+        };
+
+        THEN("the first frame logs a transform and the pixels of all tiles") {
+            CHECK(log().is_ok());
+            CHECK(num_tile_logs(stream, num_logs) == 8);
+
+            AND_THEN("an unchanged frame logs nothing") {
+                CHECK(log().is_ok());
+                CHECK(num_tile_logs(stream, num_logs) == 0);
+            }
+            AND_THEN("changing a pixel logs only its tile") {
+                occupancy[4 * 6 + 5] = 1;
+                CHECK(log().is_ok());
+                CHECK(num_tile_logs(stream, num_logs) == 1);
+
+                AND_THEN("changing it back logs the tile again") {
+                    occupancy[4 * 6 + 5] = 0;
+                    CHECK(log().is_ok());
+                    CHECK(num_tile_logs(stream, num_logs) == 1);
+                }
+            }
+            AND_THEN("changing pixels of two tiles logs both") {
+                occupancy[0] = 1;
+                occupancy[3 * 6 + 4] = 1;
+                CHECK(log().is_ok());
+                CHECK(num_tile_logs(stream, num_logs) == 2);
+            }
+            AND_THEN("resetting the logger logs all tiles again") {
+                logger.reset();
+                CHECK(log().is_ok());
+                CHECK(num_tile_logs(stream, num_logs) == 8);
+            }
+            AND_THEN("shrinking the image clears the tiles outside of it") {
+                const std::vector<uint8_t> small(3 * 3, 0);
+                const rerun::SegmentationImage image({3, 3}, small.data());
+                CHECK(logger.try_log(stream, image).is_ok());
+                // A transform and the pixels of the remaining tile, a clear of the others.
+                CHECK(num_tile_logs(stream, num_logs) == 5);
+
+                AND_THEN("growing it again logs all tiles") {
+                    CHECK(log().is_ok());
+                    CHECK(num_tile_logs(stream, num_logs) == 8);
+                }
+            }
+            AND_THEN("changing the pixel type logs all tiles again") {
+                const std::vector<uint16_t> wide(5 * 6, 0);
+                const rerun::SegmentationImage image({5, 6}, wide.data());
+                CHECK(logger.try_log(stream, image).is_ok());
+                CHECK(num_tile_logs(stream, num_logs) == 8);
+            }
+        }
+    }
+
+    GIVEN("an RGB image") {
+        rerun::RecordingStream stream("test");
+        stream.set_rate_limit("camera/**", 0.001);
+        size_t num_logs = 0;
+
+        rerun::TiledImageLogger logger("camera", 2);
+        std::vector<uint8_t> pixels(2 * 4 * 3, 128);
+        CHECK(logger.try_log(stream, rerun::Image({2, 4, 3}, pixels.data())).is_ok());
+        CHECK(num_tile_logs(stream, num_logs) == 4);
+
+        THEN("changing a channel of the right tile logs only that tile") {
+            pixels[1 * 4 * 3 + 3 * 3 + 2] = 0;
+            CHECK(logger.try_log(stream, rerun::Image({2, 4, 3}, pixels.data())).is_ok());
+            CHECK(num_tile_logs(stream, num_logs) == 1);
+        }
+    }
+
+    GIVEN("invalid images") {
+        rerun::RecordingStream stream("test");
+        rerun::TiledImageLogger logger("map", 4);
+        const std::vector<uint8_t> pixels(8, 0);
+
+        THEN("images of the wrong rank are rejected") {
+            const rerun::SegmentationImage image({2, 2, 1, 2}, pixels.data());
+            CHECK(logger.try_log(stream, image).code == rerun::ErrorCode::InvalidTensorDimension);
+        }
+        THEN("a tile size of zero is rejected") {
+            rerun::TiledImageLogger empty_tiles("map", 0);
+            const rerun::SegmentationImage image({2, 4}, pixels.data());
+            CHECK(
+                empty_tiles.try_log(stream, image).code == rerun::ErrorCode::InvalidTensorDimension
+            );
+        }
+    }
+}
@@ -9,13 +9,29 @@
 // ```text
 // just cpp-plot-dashboard --num-plots 10 --num-series-per-plot 5 --num-points-per-series 5000 --freq 1000
 // ```
+//
+// Compare against batched logging, which buffers the samples of each series in a
+// `rerun::SeriesChannel` and logs them as temporal batches:
+// ```text
+// just cpp-plot-dashboard --num-plots 10 --num-series-per-plot 5 --max-rate --batched
+// ```
+//
+// Capacity planning: ramp up the frequency until the SDK can no longer keep up and report the
+// highest sustainable scalar rate together with `log` call latency percentiles:
+// ```text
+// just cpp-plot-dashboard --num-plots 10 --num-series-per-plot 5 --threads 4 --max-rate
+// ```
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <iomanip>
 #include <iostream>
+#include <optional>
 #include <random>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -23,6 +39,352 @@
 #include <rerun/demo_utils.hpp>
 #include <rerun/third_party/cxxopts.hpp>
 
+using Clock = std::chrono::high_resolution_clock;
+
+static double to_secs(Clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+}
+
+/// Everything that is logged, shared read-only between all logging threads.
+struct Workload {
+    /// Origin of the `sim_time` timeline when logging until a deadline.
+    Clock::time_point time_origin;
+
+    std::vector<std::string> entity_paths;
+    std::vector<std::vector<double>> values_per_series;
+    std::vector<double> sim_times;
+
+    /// Log through one `rerun::SeriesChannel` per series instead of one `log` call per sample.
+    bool batched = false;
+};
+
+/// Live counters of a single logging thread, read by the main thread for progress reports.
+struct WorkerCounters {
+    std::atomic<uint64_t> num_scalars{0};
+    std::atomic<double> max_load{0.0};
+};
+
+/// What a single logging thread measured over its run.
+struct WorkerResult {
+    uint64_t num_scalars = 0;
+    double max_load = 0.0;
+
+    /// Duration of every single `log` or `SeriesChannel::add` call, in microseconds (only filled
+    /// if requested).
+    std::vector<double> log_latencies_us;
+};
+
+/// Logs all series with `series_idx % num_threads == thread_idx` at the given frequency.
+///
+/// Stops either after all `sim_times` have been logged, or, if `deadline` is set, once the
+/// deadline has passed (in which case the workload's sim times are cycled through).
+static void log_series(
+    const rerun::RecordingStream& rec, const Workload& workload, size_t thread_idx,
+    size_t num_threads, double freq, std::optional<Clock::time_point> deadline,
+    bool record_latencies, WorkerCounters& counters, WorkerResult& result
+) {
+    const auto time_per_tick = 1.0 / freq;
+    const auto num_points = workload.sim_times.size();
+    const auto start_time = Clock::now();
+    auto tick_start_time = start_time;
+
+    // Channels of this thread's series, indexed by `series_idx / num_threads`.
+    std::vector<rerun::SeriesChannel> channels;
+    if (workload.batched) {
+        for (size_t series_idx = thread_idx; series_idx < workload.entity_paths.size();
+             series_idx += num_threads) {
+            channels.emplace_back(rec, workload.entity_paths[series_idx], "sim_time");
+        }
+    }
+
+    for (size_t tick = 0;; ++tick) {
+        double sim_time;
+        if (deadline.has_value()) {
+            if (tick_start_time >= *deadline) {
+                break;
+            }
+            // Sim time keeps increasing monotonically across ramp steps.
+            sim_time = to_secs(tick_start_time - workload.time_origin);
+        } else {
+            if (tick >= num_points) {
+                break;
+            }
+            sim_time = workload.sim_times[tick];
+        }
+        if (!workload.batched) {
+            rec.set_time_seconds("sim_time", sim_time);
+        }
+
+        // Log
+
+        const auto time_step = tick % num_points;
+        uint64_t num_scalars = 0;
+        for (size_t series_idx = thread_idx; series_idx < workload.entity_paths.size();
+             series_idx += num_threads) {
+            const double value = workload.values_per_series[series_idx][time_step];
+            const auto log = [&] {
+                if (workload.batched) {
+                    channels[series_idx / num_threads].add(
+                        std::chrono::duration<double>(sim_time),
+                        value
+                    );
+                } else {
+                    rec.log(workload.entity_paths[series_idx], rerun::Scalar(value));
+                }
+            };
+
+            if (record_latencies) {
+                const auto log_start_time = Clock::now();
+                log();
+                result.log_latencies_us.push_back(to_secs(Clock::now() - log_start_time) * 1e6);
+            } else {
+                log();
+            }
+            ++num_scalars;
+        }
+        result.num_scalars += num_scalars;
+        counters.num_scalars.fetch_add(num_scalars, std::memory_order_relaxed);
+
+        // Throttle
+
+        auto elapsed = Clock::now() - tick_start_time;
+        double sleep_time = time_per_tick - to_secs(elapsed);
+
+        if (sleep_time > 0.0) {
+            auto sleep_duration = std::chrono::duration<double>(sleep_time);
+
+            auto sleep_start_time = Clock::now();
+            std::this_thread::sleep_for(sleep_duration);
+            auto sleep_elapsed = Clock::now() - sleep_start_time;
+
+            // We will very likely be put to sleep for more than we asked for, and therefore need
+            // to pay off that debt in order to meet our frequency goal.
+            auto sleep_debt = sleep_elapsed - sleep_duration;
+            tick_start_time =
+                Clock::now() - std::chrono::duration_cast<std::chrono::nanoseconds>(sleep_debt);
+        } else {
+            tick_start_time = Clock::now();
+        }
+
+        const double load = to_secs(elapsed) / time_per_tick;
+        result.max_load = std::max(result.max_load, load);
+        if (load > counters.max_load.load(std::memory_order_relaxed)) {
+            counters.max_load.store(load, std::memory_order_relaxed);
+        }
+    }
+}
+
+/// Runs the workload on `num_threads` threads, reporting progress every second.
+static std::vector<WorkerResult> run_threads(
+    const rerun::RecordingStream& rec, const Workload& workload, size_t num_threads, double freq,
+    std::optional<Clock::time_point> deadline, bool record_latencies, bool print_progress
+) {
+    const auto expected_total_freq = freq * static_cast<double>(workload.entity_paths.size());
+
+    std::vector<WorkerCounters> counters(num_threads);
+    std::vector<WorkerResult> results(num_threads);
+    std::atomic<size_t> num_running{num_threads};
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+        threads.emplace_back([&, thread_idx] {
+            log_series(
+                rec,
+                workload,
+                thread_idx,
+                num_threads,
+                freq,
+                deadline,
+                record_latencies,
+                counters[thread_idx],
+                results[thread_idx]
+            );
+            num_running.fetch_sub(1);
+        });
+    }
+
+    // Progress report
+
+    auto report = [&](Clock::time_point since) {
+        uint64_t total_num_scalars = 0;
+        double max_load = 0.0;
+        for (auto& c : counters) {
+            total_num_scalars += c.num_scalars.exchange(0, std::memory_order_relaxed);
+            max_load = std::max(max_load, c.max_load.exchange(0.0, std::memory_order_relaxed));
+        }
+        double total_elapsed_secs = to_secs(Clock::now() - since);
+        if (print_progress) {
+            std::cout << "logged " << total_num_scalars << " scalars over " << total_elapsed_secs
+                      << "s (freq=" << static_cast<double>(total_num_scalars) / total_elapsed_secs
+                      << "Hz, expected=" << expected_total_freq
+                      << "Hz, load=" << max_load * 100.0 << "%)" << std::endl;
+        }
+    };
+
+    auto report_start_time = Clock::now();
+    while (num_running.load() > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if (Clock::now() - report_start_time >= std::chrono::seconds(1)) {
+            report(report_start_time);
+            report_start_time = Clock::now();
+        }
+    }
+    report(report_start_time);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return results;
+}
+
+/// Outcome of a single step of the closed-loop rate search.
+struct RampStep {
+    double target_freq;
+    double target_scalar_rate;
+    double achieved_scalar_rate;
+
+    /// How long it took to flush the pipeline after the step, i.e. how far behind the SDK was.
+    double drain_secs;
+
+    double max_load;
+
+    /// `log` call latency percentiles in microseconds.
+    double p50_us, p90_us, p99_us, max_us;
+
+    bool sustainable;
+};
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const auto idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+static RampStep run_ramp_step(
+    const rerun::RecordingStream& rec, const Workload& workload, size_t num_threads, double freq,
+    double step_secs, double max_drain_secs, double sustain_ratio
+) {
+    const auto step_start_time = Clock::now();
+    const auto deadline =
+        step_start_time + std::chrono::duration_cast<Clock::duration>(
+                              std::chrono::duration<double>(step_secs)
+                          );
+    auto results = run_threads(rec, workload, num_threads, freq, deadline, true, false);
+    const auto logging_elapsed_secs = to_secs(Clock::now() - step_start_time);
+
+    // Anything the SDK hasn't managed to process yet is still queued up at this point.
+    const auto flush_start_time = Clock::now();
+    rec.flush_blocking();
+    const auto drain_secs = to_secs(Clock::now() - flush_start_time);
+
+    RampStep step = {};
+    step.target_freq = freq;
+    step.target_scalar_rate = freq * static_cast<double>(workload.entity_paths.size());
+    step.drain_secs = drain_secs;
+
+    uint64_t num_scalars = 0;
+    std::vector<double> latencies;
+    for (auto& result : results) {
+        num_scalars += result.num_scalars;
+        step.max_load = std::max(step.max_load, result.max_load);
+        latencies.insert(
+            latencies.end(),
+            result.log_latencies_us.begin(),
+            result.log_latencies_us.end()
+        );
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    step.achieved_scalar_rate = static_cast<double>(num_scalars) / logging_elapsed_secs;
+    step.p50_us = percentile(latencies, 0.5);
+    step.p90_us = percentile(latencies, 0.9);
+    step.p99_us = percentile(latencies, 0.99);
+    step.max_us = latencies.empty() ? 0.0 : latencies.back();
+    step.sustainable = step.achieved_scalar_rate >= sustain_ratio * step.target_scalar_rate &&
+                       step.drain_secs <= max_drain_secs;
+
+    return step;
+}
+
+static void print_ramp_step(const RampStep& step) {
+    std::cout << std::fixed << std::setprecision(1) << "freq=" << step.target_freq
+              << "Hz: scalars/s=" << step.achieved_scalar_rate << " (target "
+              << step.target_scalar_rate << "), drain=" << step.drain_secs * 1000.0
+              << "ms, load=" << step.max_load * 100.0 << "%, log latency p50=" << step.p50_us
+              << "us p90=" << step.p90_us << "us p99=" << step.p99_us << "us max=" << step.max_us
+              << "us -> " << (step.sustainable ? "sustainable" : "NOT sustainable") << std::endl;
+    std::cout.unsetf(std::ios_base::floatfield);
+}
+
+/// Closed-loop search for the highest sustainable frequency.
+///
+/// Ramps up geometrically until a step is no longer sustainable, then bisects between the last
+/// sustainable and the first unsustainable frequency.
+static void find_max_sustainable_rate(
+    const rerun::RecordingStream& rec, const Workload& workload, size_t num_threads,
+    double start_freq, double ramp_factor, uint64_t refine_steps, double step_secs,
+    double max_drain_secs, double sustain_ratio
+) {
+    std::optional<RampStep> best;
+    std::optional<double> first_bad_freq;
+
+    for (double freq = start_freq;; freq *= ramp_factor) {
+        auto step = run_ramp_step(
+            rec,
+            workload,
+            num_threads,
+            freq,
+            step_secs,
+            max_drain_secs,
+            sustain_ratio
+        );
+        print_ramp_step(step);
+        if (!step.sustainable) {
+            first_bad_freq = freq;
+            break;
+        }
+        best = step;
+    }
+
+    double low = best.has_value() ? best->target_freq : 0.0;
+    double high = *first_bad_freq;
+    for (uint64_t i = 0; i < refine_steps && best.has_value(); ++i) {
+        const double freq = 0.5 * (low + high);
+        auto step = run_ramp_step(
+            rec,
+            workload,
+            num_threads,
+            freq,
+            step_secs,
+            max_drain_secs,
+            sustain_ratio
+        );
+        print_ramp_step(step);
+        if (step.sustainable) {
+            best = step;
+            low = freq;
+        } else {
+            high = freq;
+        }
+    }
+
+    std::cout << std::endl;
+    if (!best.has_value()) {
+        std::cout << "Not even the starting frequency of " << start_freq
+                  << "Hz is sustainable, try a lower --freq." << std::endl;
+        return;
+    }
+    std::cout << "Max sustainable rate: " << best->achieved_scalar_rate << " scalars/s ("
+              << workload.entity_paths.size() << " series at " << best->target_freq << "Hz on "
+              << num_threads << " thread(s))" << std::endl;
+    std::cout << "log latency at that rate: p50=" << best->p50_us << "us p90=" << best->p90_us
+              << "us p99=" << best->p99_us << "us max=" << best->max_us << "us" << std::endl;
+}
+
 int main(int argc, char** argv) {
     const auto rec = rerun::RecordingStream("rerun_example_plot_dashboard_stress");
 
@@ -43,6 +405,15 @@ int main(int argc, char** argv) {
       ("freq", "Frequency of logging (applies to all series)", cxxopts::value<double>()->default_value("1000.0"))
     ("order", "What order to log the data in ('forwards', 'backwards', 'random') (applies to all series).", cxxopts::value<std::string>()->default_value("forwards"))
     ("series-type", "The method used to generate time series ('gaussian-random-walk', 'sin-uniform').", cxxopts::value<std::string>()->default_value("gaussian-random-walk"))
+    ("threads", "How many threads to log from. Series are distributed evenly across threads.", cxxopts::value<uint64_t>()->default_value("1"))
+    ("batched", "Buffer the samples of each series in a rerun::SeriesChannel and log them as temporal batches instead of logging each sample.")
+      // Closed-loop rate search
+    ("max-rate", "Instead of logging at a fixed frequency, ramp up the frequency starting at --freq until logging is no longer sustainable and report the highest sustainable scalar rate.")
+    ("ramp-factor", "Frequency multiplier between two ramp steps (--max-rate only).", cxxopts::value<double>()->default_value("1.5"))
+    ("ramp-step-duration", "How many seconds to log for at each ramp step (--max-rate only).", cxxopts::value<double>()->default_value("2.0"))
+    ("refine-steps", "Number of bisection steps after the ramp found an unsustainable frequency (--max-rate only).", cxxopts::value<uint64_t>()->default_value("3"))
+    ("max-drain-ms", "A step is unsustainable if flushing the pipeline after it takes longer than this (--max-rate only).", cxxopts::value<double>()->default_value("100.0"))
+    ("sustain-ratio", "A step is unsustainable if less than this fraction of the target rate was achieved (--max-rate only).", cxxopts::value<double>()->default_value("0.95"))
     ;
     // clang-format on
 
@@ -53,6 +424,11 @@ int main(int argc, char** argv) {
         exit(0);
     }
 
+    if (args["num-points-per-series"].as<uint64_t>() == 0) {
+        std::cerr << "--num-points-per-series must be at least 1" << std::endl;
+        exit(1);
+    }
+
     // TODO(#4602): need common rerun args helper library
     if (args["spawn"].as<bool>()) {
         rec.spawn().exit_on_failure();
@@ -69,31 +445,32 @@ int main(int argc, char** argv) {
     const auto num_plots = args["num-plots"].as<uint64_t>();
     const auto num_series_per_plot = args["num-series-per-plot"].as<uint64_t>();
     const auto num_points_per_series = args["num-points-per-series"].as<uint64_t>();
-
-    std::vector<std::string> plot_paths;
-    plot_paths.reserve(num_plots);
-    for (uint64_t i = 0; i < num_plots; ++i) {
-        plot_paths.push_back("plot_" + std::to_string(i));
-    }
-
-    std::vector<std::string> series_paths;
-    series_paths.reserve(num_series_per_plot);
-    for (uint64_t i = 0; i < num_series_per_plot; ++i) {
-        series_paths.push_back("series_" + std::to_string(i));
+    const auto num_threads = std::max<uint64_t>(args["threads"].as<uint64_t>(), 1);
+
+    Workload workload;
+    workload.time_origin = Clock::now();
+    workload.batched = args["batched"].as<bool>();
+
+    workload.entity_paths.reserve(num_plots * num_series_per_plot);
+    for (uint64_t plot_idx = 0; plot_idx < num_plots; ++plot_idx) {
+        for (uint64_t series_idx = 0; series_idx < num_series_per_plot; ++series_idx) {
+            workload.entity_paths.push_back(
+                "plot_" + std::to_string(plot_idx) + "/series_" + std::to_string(series_idx)
+            );
+        }
     }
 
     const auto freq = args["freq"].as<double>();
 
     const auto num_series = num_plots * num_series_per_plot;
     const auto time_per_tick = 1.0 / freq;
-    const auto expected_total_freq = freq * static_cast<double>(num_series);
 
     std::random_device rd;
     std::mt19937 rng(rd());
     std::uniform_real_distribution<double> distr_uniform_pi(0.0, rerun::demo::PI);
     std::normal_distribution<double> distr_std_normal;
 
-    std::vector<double> sim_times;
+    auto& sim_times = workload.sim_times;
     const auto order = args["order"].as<std::string>();
     const auto series_type = args["series-type"].as<std::string>();
 
@@ -112,7 +489,6 @@ int main(int argc, char** argv) {
         std::shuffle(sim_times.begin(), sim_times.end(), rng);
     }
 
-    std::vector<std::vector<double>> values_per_series;
     for (uint64_t series_idx = 0; series_idx < num_series; ++series_idx) {
         std::vector<double> values;
 
@@ -130,92 +506,22 @@ int main(int argc, char** argv) {
             values.push_back(value);
         }
 
-        values_per_series.push_back(values);
+        workload.values_per_series.push_back(values);
     }
 
-    uint64_t total_num_scalars = 0;
-    auto total_start_time = std::chrono::high_resolution_clock::now();
-    double max_load = 0.0;
-
-    auto tick_start_time = std::chrono::high_resolution_clock::now();
-
-    size_t time_step = 0;
-    for (auto sim_time : sim_times) {
-        rec.set_time_seconds("sim_time", sim_time);
-
-        // Log
-
-        size_t plot_idx = 0;
-        for (auto plot_path : plot_paths) {
-            auto global_plot_idx = plot_idx * num_series_per_plot;
-            size_t series_idx = 0;
-            for (auto series_path : series_paths) {
-                double value = values_per_series[global_plot_idx + series_idx][time_step];
-                rec.log(plot_path + "/" + series_path, rerun::Scalar(value));
-                ++series_idx;
-            }
-            ++plot_idx;
-        }
-        ++time_step;
-
-        // Progress report
-
-        total_num_scalars += num_series;
-        auto total_elapsed = std::chrono::high_resolution_clock::now() - total_start_time;
-        if (total_elapsed >= std::chrono::seconds(1)) {
-            double total_elapsed_secs =
-                std::chrono::duration_cast<std::chrono::duration<double>>(total_elapsed).count();
-            std::cout << "logged " << total_num_scalars << " scalars over " << total_elapsed_secs
-                      << "s (freq=" << static_cast<double>(total_num_scalars) / total_elapsed_secs
-                      << "Hz, expected=" << expected_total_freq << "Hz, load=" << max_load * 100.0
-                      << "%)" << std::endl;
-
-            auto elapsed_debt = std::chrono::duration<double>(
-                total_elapsed_secs - floor(total_elapsed_secs)
-            ); // just keep the fractional part
-            total_start_time = std::chrono::high_resolution_clock::now() -
-                               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed_debt);
-
-            total_start_time = std::chrono::high_resolution_clock::now();
-            total_num_scalars = 0;
-            max_load = 0.0;
-        }
-
-        // Throttle
-
-        auto elapsed = std::chrono::high_resolution_clock::now() - tick_start_time;
-        double sleep_time =
-            time_per_tick -
-            std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
-
-        if (sleep_time > 0.0) {
-            auto sleep_duration = std::chrono::duration<double>(sleep_time);
-
-            auto sleep_start_time = std::chrono::high_resolution_clock::now();
-            std::this_thread::sleep_for(sleep_duration);
-            auto sleep_elapsed = std::chrono::high_resolution_clock::now() - sleep_start_time;
-
-            // We will very likely be put to sleep for more than we asked for, and therefore need
-            // to pay off that debt in order to meet our frequency goal.
-            auto sleep_debt = sleep_elapsed - sleep_duration;
-            tick_start_time = std::chrono::high_resolution_clock::now() -
-                              std::chrono::duration_cast<std::chrono::nanoseconds>(sleep_debt);
-        } else {
-            tick_start_time = std::chrono::high_resolution_clock::now();
-        }
-
-        max_load = std::max(
-            max_load,
-            std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count() /
-                time_per_tick
+    if (args["max-rate"].as<bool>()) {
+        find_max_sustainable_rate(
+            rec,
+            workload,
+            num_threads,
+            freq,
+            std::max(args["ramp-factor"].as<double>(), 1.01),
+            args["refine-steps"].as<uint64_t>(),
+            args["ramp-step-duration"].as<double>(),
+            args["max-drain-ms"].as<double>() / 1000.0,
+            args["sustain-ratio"].as<double>()
         );
+    } else {
+        run_threads(rec, workload, num_threads, freq, std::nullopt, false, true);
     }
-
-    auto total_elapsed = std::chrono::high_resolution_clock::now() - total_start_time;
-    double total_elapsed_secs =
-        std::chrono::duration_cast<std::chrono::duration<double>>(total_elapsed).count();
-    std::cout << "logged " << total_num_scalars << " scalars over " << total_elapsed_secs
-              << "s (freq=" << static_cast<double>(total_num_scalars) / total_elapsed_secs
-              << "Hz, expected=" << expected_total_freq << "Hz, load=" << max_load * 100.0 << "%)"
-              << std::endl;
 }
@@ -0,0 +1,38 @@
+// Logs a sequence of RGB images, one row per image.
+//
+// Part of the cross-SDK throughput comparison, see `tests/throughput.py`.
+// The workload must be kept identical to `tests/python/throughput/image` and
+// `tests/rust/throughput/image`.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <rerun.hpp>
+
+constexpr int64_t NUM_IMAGES = 100;
+constexpr size_t WIDTH = 640;
+constexpr size_t HEIGHT = 480;
+
+int main(int, char** argv) {
+    const auto rec = rerun::RecordingStream("rerun_example_throughput_image");
+    rec.save(argv[1]).exit_on_failure();
+
+    // Data generation is not part of the measurement.
+    std::vector<uint8_t> pixels(WIDTH * HEIGHT * 3);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int64_t frame = 0; frame < NUM_IMAGES; ++frame) {
+        rec.set_time_sequence("step", frame);
+        rec.log("image", rerun::Image({HEIGHT, WIDTH, 3}, pixels));
+    }
+    rec.flush_blocking();
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+    printf("rows=%lld logging_secs=%f\n", static_cast<long long>(NUM_IMAGES), elapsed.count());
+}
@@ -0,0 +1,42 @@
+// Logs large batches of colored points with radii, one row per batch.
+//
+// Part of the cross-SDK throughput comparison, see `tests/throughput.py`.
+// The workload must be kept identical to `tests/python/throughput/points3d` and
+// `tests/rust/throughput/points3d`.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <rerun.hpp>
+
+constexpr int64_t NUM_BATCHES = 100;
+constexpr size_t NUM_POINTS = 100'000;
+
+int main(int, char** argv) {
+    const auto rec = rerun::RecordingStream("rerun_example_throughput_points3d");
+    rec.save(argv[1]).exit_on_failure();
+
+    // Data generation is not part of the measurement.
+    std::vector<rerun::Position3D> positions(NUM_POINTS);
+    std::vector<rerun::Color> colors(NUM_POINTS);
+    std::vector<rerun::Radius> radii(NUM_POINTS);
+    for (size_t i = 0; i < NUM_POINTS; ++i) {
+        const auto f = static_cast<float>(i);
+        positions[i] = rerun::Position3D(f * 0.1f, f * 0.2f, f * 0.3f);
+        colors[i] = rerun::Color(static_cast<uint32_t>(i * 2654435761u));
+        radii[i] = rerun::Radius(0.01f + static_cast<float>(i % 100) * 0.001f);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int64_t batch = 0; batch < NUM_BATCHES; ++batch) {
+        rec.set_time_sequence("step", batch);
+        rec.log("points", rerun::Points3D(positions).with_colors(colors).with_radii(radii));
+    }
+    rec.flush_blocking();
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+    printf("rows=%lld logging_secs=%f\n", static_cast<long long>(NUM_BATCHES), elapsed.count());
+}
@@ -0,0 +1,46 @@
+// Logs many individual scalars, one row per `log` call.
+//
+// Part of the cross-SDK throughput comparison, see `tests/throughput.py`.
+// The workload must be kept identical to `tests/python/throughput/scalars` and
+// `tests/rust/throughput/scalars`.
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <rerun.hpp>
+
+constexpr int64_t NUM_SERIES = 10;
+constexpr int64_t NUM_STEPS = 10'000;
+
+int main(int, char** argv) {
+    const auto rec = rerun::RecordingStream("rerun_example_throughput_scalars");
+    rec.save(argv[1]).exit_on_failure();
+
+    std::vector<std::string> entity_paths;
+    for (int64_t series = 0; series < NUM_SERIES; ++series) {
+        entity_paths.push_back("series_" + std::to_string(series));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int64_t step = 0; step < NUM_STEPS; ++step) {
+        rec.set_time_sequence("step", step);
+        for (int64_t series = 0; series < NUM_SERIES; ++series) {
+            const double value =
+                std::sin(static_cast<double>(step) * 0.01 + static_cast<double>(series));
+            rec.log(entity_paths[static_cast<size_t>(series)], rerun::archetypes::Scalar(value));
+        }
+    }
+    rec.flush_blocking();
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+    printf(
+        "rows=%lld logging_secs=%f\n",
+        static_cast<long long>(NUM_SERIES * NUM_STEPS),
+        elapsed.count()
+    );
+}
@@ -0,0 +1,47 @@
+#!/usr/bin/env python3
+
+"""
+Logs a sequence of RGB images, one row per image.
+
+Part of the cross-SDK throughput comparison, see `tests/throughput.py`.
+The workload must be kept identical to `tests/cpp/throughput/image` and `tests/rust/throughput/image`.
+"""
+
+from __future__ import annotations
+
+import argparse
+import time
+
+import numpy as np
+import rerun as rr
+
+NUM_IMAGES = 100
+WIDTH = 640
+HEIGHT = 480
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="Logs a sequence of images using the Rerun SDK.")
+    parser.add_argument("--save", type=str, required=True, help="Path of the rrd file to write to")
+    args = parser.parse_args()
+
+    rr.init("rerun_example_throughput_image")
+    rr.save(args.save)
+
+    # Data generation is not part of the measurement.
+    pixels = ((np.arange(WIDTH * HEIGHT * 3, dtype=np.uint64) * 7) & 0xFF).astype(np.uint8)
+    pixels = pixels.reshape(HEIGHT, WIDTH, 3)
+
+    start = time.perf_counter()
+
+    for frame in range(NUM_IMAGES):
+        rr.set_time_sequence("step", frame)
+        rr.log("image", rr.Image(pixels))
+    rr.disconnect()  # Flushes and closes the file.
+
+    elapsed = time.perf_counter() - start
+    print(f"rows={NUM_IMAGES} logging_secs={elapsed:f}")
+
+
+if __name__ == "__main__":
+    main()
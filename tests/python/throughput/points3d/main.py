@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+
+"""
+Logs large batches of colored points with radii, one row per batch.
+
+Part of the cross-SDK throughput comparison, see `tests/throughput.py`.
+The workload must be kept identical to `tests/cpp/throughput/points3d` and `tests/rust/throughput/points3d`.
+"""
+
+from __future__ import annotations
+
+import argparse
+import time
+
+import numpy as np
+import rerun as rr
+
+NUM_BATCHES = 100
+NUM_POINTS = 100_000
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="Logs large point clouds using the Rerun SDK.")
+    parser.add_argument("--save", type=str, required=True, help="Path of the rrd file to write to")
+    args = parser.parse_args()
+
+    rr.init("rerun_example_throughput_points3d")
+    rr.save(args.save)
+
+    # Data generation is not part of the measurement.
+    indices = np.arange(NUM_POINTS, dtype=np.uint64)
+    f = indices.astype(np.float32)
+    positions = np.stack([f * 0.1, f * 0.2, f * 0.3], axis=1)
+    colors = ((indices * 2654435761) & 0xFFFFFFFF).astype(np.uint32)
+    radii = 0.01 + (indices % 100).astype(np.float32) * 0.001
+
+    start = time.perf_counter()
+
+    for batch in range(NUM_BATCHES):
+        rr.set_time_sequence("step", batch)
+        rr.log("points", rr.Points3D(positions, colors=colors, radii=radii))
+    rr.disconnect()  # Flushes and closes the file.
+
+    elapsed = time.perf_counter() - start
+    print(f"rows={NUM_BATCHES} logging_secs={elapsed:f}")
+
+
+if __name__ == "__main__":
+    main()
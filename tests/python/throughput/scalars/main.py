@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+
+"""
+Logs many individual scalars, one row per `log` call.
+
+Part of the cross-SDK throughput comparison, see `tests/throughput.py`.
+The workload must be kept identical to `tests/cpp/throughput/scalars` and `tests/rust/throughput/scalars`.
+"""
+
+from __future__ import annotations
+
+import argparse
+import math
+import time
+
+import rerun as rr
+
+NUM_SERIES = 10
+NUM_STEPS = 10_000
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="Logs many individual scalars using the Rerun SDK.")
+    parser.add_argument("--save", type=str, required=True, help="Path of the rrd file to write to")
+    args = parser.parse_args()
+
+    rr.init("rerun_example_throughput_scalars")
+    rr.save(args.save)
+
+    entity_paths = [f"series_{series}" for series in range(NUM_SERIES)]
+
+    start = time.perf_counter()
+
+    for step in range(NUM_STEPS):
+        rr.set_time_sequence("step", step)
+        for series in range(NUM_SERIES):
+            rr.log(entity_paths[series], rr.Scalar(math.sin(step * 0.01 + series)))
+    rr.disconnect()  # Flushes and closes the file.
+
+    elapsed = time.perf_counter() - start
+    print(f"rows={NUM_SERIES * NUM_STEPS} logging_secs={elapsed:f}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,58 @@
+//! Logs a sequence of RGB images, one row per image.
+//!
+//! Part of the cross-SDK throughput comparison, see `tests/throughput.py`.
+//! The workload must be kept identical to `tests/cpp/throughput/image` and
+//! `tests/python/throughput/image`.
+
+use rerun::{
+    datatypes::{TensorBuffer, TensorData, TensorDimension},
+    external::re_types_core::ArrowBuffer,
+};
+
+const NUM_IMAGES: i64 = 100;
+const WIDTH: u64 = 640;
+const HEIGHT: u64 = 480;
+
+#[derive(Debug, clap::Parser)]
+#[clap(author, version, about)]
+struct Args {
+    /// Path of the rrd file to write to.
+    #[clap(long)]
+    save: std::path::PathBuf,
+}
+
+fn main() -> anyhow::Result<()> {
+    use clap::Parser as _;
+    let args = Args::parse();
+
+    let rec = rerun::RecordingStreamBuilder::new("rerun_example_throughput_image")
+        .save(&args.save)?;
+
+    // Data generation is not part of the measurement.
+    let pixels: Vec<u8> = (0..WIDTH * HEIGHT * 3).map(|i| (i * 7) as u8).collect();
+
+    let start = std::time::Instant::now();
+
+    for frame in 0..NUM_IMAGES {
+        rec.set_time_sequence("step", frame);
+        rec.log(
+            "image",
+            &rerun::Image::new(TensorData::new(
+                vec![
+                    TensorDimension::height(HEIGHT),
+                    TensorDimension::width(WIDTH),
+                    TensorDimension::depth(3),
+                ],
+                // Like the C++ and Python SDK, the user keeps ownership of their pixels,
+                // so the copy is part of what we measure.
+                TensorBuffer::U8(ArrowBuffer::from(pixels.clone())),
+            )),
+        )?;
+    }
+    rec.flush_blocking();
+
+    let elapsed = start.elapsed().as_secs_f64();
+    println!("rows={NUM_IMAGES} logging_secs={elapsed:f}");
+
+    Ok(())
+}
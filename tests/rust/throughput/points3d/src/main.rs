@@ -0,0 +1,56 @@
+//! Logs large batches of colored points with radii, one row per batch.
+//!
+//! Part of the cross-SDK throughput comparison, see `tests/throughput.py`.
+//! The workload must be kept identical to `tests/cpp/throughput/points3d` and
+//! `tests/python/throughput/points3d`.
+
+const NUM_BATCHES: i64 = 100;
+const NUM_POINTS: usize = 100_000;
+
+#[derive(Debug, clap::Parser)]
+#[clap(author, version, about)]
+struct Args {
+    /// Path of the rrd file to write to.
+    #[clap(long)]
+    save: std::path::PathBuf,
+}
+
+fn main() -> anyhow::Result<()> {
+    use clap::Parser as _;
+    let args = Args::parse();
+
+    let rec = rerun::RecordingStreamBuilder::new("rerun_example_throughput_points3d")
+        .save(&args.save)?;
+
+    // Data generation is not part of the measurement.
+    let positions: Vec<[f32; 3]> = (0..NUM_POINTS)
+        .map(|i| {
+            let f = i as f32;
+            [f * 0.1, f * 0.2, f * 0.3]
+        })
+        .collect();
+    let colors: Vec<u32> = (0..NUM_POINTS)
+        .map(|i| (i as u32).wrapping_mul(2_654_435_761))
+        .collect();
+    let radii: Vec<f32> = (0..NUM_POINTS)
+        .map(|i| 0.01 + (i % 100) as f32 * 0.001)
+        .collect();
+
+    let start = std::time::Instant::now();
+
+    for batch in 0..NUM_BATCHES {
+        rec.set_time_sequence("step", batch);
+        rec.log(
+            "points",
+            &rerun::Points3D::new(positions.iter().copied())
+                .with_colors(colors.iter().copied())
+                .with_radii(radii.iter().copied()),
+        )?;
+    }
+    rec.flush_blocking();
+
+    let elapsed = start.elapsed().as_secs_f64();
+    println!("rows={NUM_BATCHES} logging_secs={elapsed:f}");
+
+    Ok(())
+}
@@ -0,0 +1,45 @@
+//! Logs many individual scalars, one row per `log` call.
+//!
+//! Part of the cross-SDK throughput comparison, see `tests/throughput.py`.
+//! The workload must be kept identical to `tests/cpp/throughput/scalars` and
+//! `tests/python/throughput/scalars`.
+
+const NUM_SERIES: i64 = 10;
+const NUM_STEPS: i64 = 10_000;
+
+#[derive(Debug, clap::Parser)]
+#[clap(author, version, about)]
+struct Args {
+    /// Path of the rrd file to write to.
+    #[clap(long)]
+    save: std::path::PathBuf,
+}
+
+fn main() -> anyhow::Result<()> {
+    use clap::Parser as _;
+    let args = Args::parse();
+
+    let rec = rerun::RecordingStreamBuilder::new("rerun_example_throughput_scalars")
+        .save(&args.save)?;
+
+    let entity_paths: Vec<String> = (0..NUM_SERIES).map(|s| format!("series_{s}")).collect();
+
+    let start = std::time::Instant::now();
+
+    for step in 0..NUM_STEPS {
+        rec.set_time_sequence("step", step);
+        for series in 0..NUM_SERIES {
+            let value = (step as f64 * 0.01 + series as f64).sin();
+            rec.log(
+                entity_paths[series as usize].as_str(),
+                &rerun::Scalar::new(value),
+            )?;
+        }
+    }
+    rec.flush_blocking();
+
+    let elapsed = start.elapsed().as_secs_f64();
+    println!("rows={} logging_secs={elapsed:f}", NUM_SERIES * NUM_STEPS);
+
+    Ok(())
+}
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+
+"""
+Run the same logging workloads with every SDK and compare their throughput.
+
+Each workload lives in `tests/{cpp,python,rust}/throughput/<workload>` and logs identical data to an rrd file.
+Every program prints how many rows it logged and how long it took from the first `log` call until all data was
+flushed to disk. This script collects those numbers together with the size of the written file.
+
+Example:
+```
+python tests/throughput.py --repeat 3 scalars image
+```
+"""
+
+from __future__ import annotations
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+from dataclasses import dataclass
+from os import listdir
+from os.path import isdir, join
+
+sys.path.append(os.path.dirname(os.path.realpath(__file__)) + "/../scripts/")
+from roundtrip_utils import cmake_build, cmake_configure, cpp_build_dir, get_repo_root, run  # noqa
+
+WORKLOADS_PATH = "tests/cpp/throughput"
+LANGUAGES = ["cpp", "py", "rust"]
+
+
+@dataclass
+class Measurement:
+    rows: int
+    logging_secs: float
+    process_secs: float
+    file_bytes: int
+
+    @property
+    def rows_per_sec(self) -> float:
+        return self.rows / self.logging_secs
+
+    @property
+    def mb_per_sec(self) -> float:
+        return self.file_bytes / self.logging_secs / 1e6
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="Compare logging throughput of identical workloads across SDKs")
+    parser.add_argument("--no-py-build", action="store_true", help="Skip building rerun-sdk for Python")
+    parser.add_argument("--no-cpp-build", action="store_true", help="Skip cmake configure & build")
+    parser.add_argument("--no-rust-build", action="store_true", help="Skip ahead of time cargo build")
+    parser.add_argument("--debug", action="store_true", help="Build in debug instead of release. Timings will suffer!")
+    parser.add_argument("--repeat", type=int, default=1, help="Run each program this many times and keep the best")
+    parser.add_argument(
+        "--languages", type=str, default=",".join(LANGUAGES), help="Comma separated list of SDKs to compare"
+    )
+    parser.add_argument("workload", nargs="*", type=str, default=None, help="Run only the specified workloads")
+
+    args = parser.parse_args()
+    release = not args.debug
+    languages = [lang for lang in args.languages.split(",") if lang]
+
+    for lang in languages:
+        assert lang in LANGUAGES, f"Unknown language {lang}, expected one of {LANGUAGES}"
+
+    if len(args.workload) > 0:
+        workloads = args.workload
+    else:
+        workloads_path = join(get_repo_root(), WORKLOADS_PATH)
+        workloads = sorted(d for d in listdir(workloads_path) if isdir(join(workloads_path, d)))
+
+    build_env = os.environ.copy()
+    if "RUST_LOG" in build_env:
+        del build_env["RUST_LOG"]
+
+    if "py" in languages and not args.no_py_build:
+        print("Building rerun-sdk for Python…")
+        run(["just", "py-build", "--quiet"], env=build_env)
+
+    if "cpp" in languages and not args.no_cpp_build:
+        print("Building C++ throughput workloads…")
+        cmake_configure(release, build_env)
+        for workload in workloads:
+            cmake_build(f"throughput_{workload}", release)
+
+    if "rust" in languages and not args.no_rust_build:
+        print("Building Rust throughput workloads…")
+        cmd = ["cargo", "build", "--quiet"]
+        for workload in workloads:
+            cmd += ["-p", f"throughput_{workload}"]
+        if release:
+            cmd += ["--release"]
+        run(cmd, env=build_env)
+
+    results: dict[str, dict[str, Measurement]] = {}
+    with tempfile.TemporaryDirectory() as output_dir:
+        for workload in workloads:
+            results[workload] = {}
+            for lang in languages:
+                best: Measurement | None = None
+                for _ in range(args.repeat):
+                    measurement = run_workload(workload, lang, release, join(output_dir, f"{workload}_{lang}.rrd"))
+                    if best is None or measurement.logging_secs < best.logging_secs:
+                        best = measurement
+                assert best is not None
+                results[workload][lang] = best
+
+    print_results(results)
+
+
+def run_workload(workload: str, lang: str, release: bool, output_path: str) -> Measurement:
+    if lang == "cpp":
+        cmd = [f"{cpp_build_dir}/tests/cpp/throughput/throughput_{workload}", output_path]
+    elif lang == "py":
+        python_executable = sys.executable if sys.executable else "python3"
+        cmd = [python_executable, f"tests/python/throughput/{workload}/main.py", "--save", output_path]
+    elif lang == "rust":
+        profile = "release" if release else "debug"
+        cmd = [f"./target/{profile}/throughput_{workload}", "--save", output_path]
+    else:
+        assert False, f"Unknown language: {lang}"
+
+    # Keep the default batching behavior, we want to measure what users get.
+    env = os.environ.copy()
+    env["RERUN_STRICT"] = "1"
+
+    print(f"> {subprocess.list2cmdline(cmd)}")
+    start = time.perf_counter()
+    result = subprocess.run(cmd, env=env, cwd=get_repo_root(), check=False, capture_output=True, text=True)
+    process_secs = time.perf_counter() - start
+    assert (
+        result.returncode == 0
+    ), f"{subprocess.list2cmdline(cmd)} failed with exit-code {result.returncode}. Output:\n{result.stdout}\n{result.stderr}"
+
+    # Every workload prints a single line of the form `rows=<rows> logging_secs=<seconds>`.
+    values = {}
+    for line in result.stdout.splitlines():
+        if line.startswith("rows="):
+            values = dict(entry.split("=") for entry in line.split())
+    assert values, f"No throughput report in output of {cmd}:\n{result.stdout}"
+
+    return Measurement(
+        rows=int(values["rows"]),
+        logging_secs=float(values["logging_secs"]),
+        process_secs=process_secs,
+        file_bytes=os.path.getsize(output_path),
+    )
+
+
+def print_results(results: dict[str, dict[str, Measurement]]) -> None:
+    print()
+    print(
+        f"{'workload':<12} {'sdk':<5} {'rows':>9} {'logging':>10} {'process':>10} {'rows/s':>12} "
+        f"{'MB/s':>9} {'file size':>12} {'vs rust':>8}"
+    )
+    for workload, per_lang in results.items():
+        rust = per_lang.get("rust")
+        for lang, m in per_lang.items():
+            relative = f"{rust.logging_secs / m.logging_secs:.2f}x" if rust is not None else "-"
+            print(
+                f"{workload:<12} {lang:<5} {m.rows:>9} {m.logging_secs:>9.3f}s {m.process_secs:>9.3f}s "
+                f"{m.rows_per_sec:>12.0f} {m.mb_per_sec:>9.1f} {m.file_bytes / 1e6:>10.2f}MB {relative:>8}"
+            )
+
+
+if __name__ == "__main__":
+    main()